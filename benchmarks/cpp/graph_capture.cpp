@@ -0,0 +1,52 @@
+// Copyright © 2025 Apple Inc.
+
+#include <iostream>
+
+#include "mlx/mlx.h"
+#include "time_utils.h"
+
+namespace mx = mlx::core;
+
+// A decode step of a small model: many ops on tiny arrays so the time is
+// dominated by the host building and scheduling the graph.
+void time_decode_step(int n_layers) {
+  constexpr int dim = 64;
+  constexpr int ops_per_layer = 5;
+  std::vector<mx::array> weights;
+  for (int i = 0; i < n_layers; ++i) {
+    weights.push_back(mx::random::normal({dim, dim}) / 8.0f);
+  }
+  mx::eval(weights);
+
+  auto step = [&weights](const std::vector<mx::array>& inputs) {
+    auto h = inputs[0];
+    for (auto& w : weights) {
+      auto x = mx::matmul(h, w);
+      h = h + mx::softmax(x, -1) * mx::rsqrt(mx::mean(x * x, -1, true));
+    }
+    return std::vector<mx::array>{h};
+  };
+  auto compiled_step = mx::compile(step);
+  auto captured_step = mx::capture(step);
+
+  auto h = mx::random::normal({1, dim});
+  mx::eval(h);
+
+  int n_ops = n_layers * ops_per_layer;
+  auto report = [n_ops](const char* name, double msec) {
+    std::cout << "  " << name << ": " << std::setprecision(4) << msec
+              << " msec, " << 1e3 * msec / n_ops << " usec per op"
+              << std::endl;
+  };
+  std::cout << "Decode step with " << n_layers << " layers" << std::endl;
+  report("eval", time_fn(step, std::vector<mx::array>{h}));
+  report("compile", time_fn(compiled_step, std::vector<mx::array>{h}));
+  report("capture", time_fn(captured_step, std::vector<mx::array>{h}));
+}
+
+int main() {
+  std::cout << "Benchmarks for " << mx::default_device() << std::endl;
+  for (int n_layers : {8, 32, 128}) {
+    time_decode_step(n_layers);
+  }
+}
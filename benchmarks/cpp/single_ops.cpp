@@ -1,5 +1,6 @@
 // Copyright © 2023 Apple Inc.
 
+#include "mlx/backend/cpu/parallel.h"
 #include "mlx/mlx.h"
 #include "time_utils.h"
 
@@ -271,6 +272,42 @@ void time_divmod() {
   TIME(divmod_separate);
 }
 
+void time_cpu_scaling() {
+  if (mx::default_device() != mx::Device::cpu) {
+    return;
+  }
+  auto a = mx::random::normal({4096, 4096});
+  auto b = mx::random::normal({4096, 4096});
+  auto c = mx::random::normal({64, 64, 56, 56});
+  mx::eval(a, b, c);
+
+  auto exp_op = [&a]() { return mx::exp(a); };
+  auto add_op = [&a, &b]() { return mx::add(a, b); };
+  auto transpose_copy = [&c]() {
+    return mx::contiguous(mx::transpose(c, {0, 2, 3, 1}));
+  };
+  auto sum_all = [&a]() { return mx::sum(a, false); };
+  auto sum_rows = [&a]() { return mx::sum(a, 1, false); };
+  auto sum_cols = [&a]() { return mx::sum(a, 0, false); };
+  auto softmax_rows = [&a]() { return mx::softmax(a, -1); };
+  auto sort_rows = [&a]() { return mx::sort(a, -1); };
+
+  int max_threads = mx::cpu::get_num_threads();
+  for (int n = 1; n <= max_threads; n *= 2) {
+    mx::cpu::set_num_threads(n);
+    std::cout << "CPU threads: " << n << std::endl;
+    TIME(exp_op);
+    TIME(add_op);
+    TIME(transpose_copy);
+    TIME(sum_all);
+    TIME(sum_rows);
+    TIME(sum_cols);
+    TIME(softmax_rows);
+    TIME(sort_rows);
+  }
+  mx::cpu::set_num_threads(max_threads);
+}
+
 int main() {
   std::cout << "Benchmarks for " << mx::default_device() << std::endl;
   time_creation_ops();
@@ -285,4 +322,5 @@ int main() {
   time_reductions();
   time_gather_scatter();
   time_divmod();
+  time_cpu_scaling();
 }
@@ -9,6 +9,11 @@ B = 8
 T = 1024
 D = 512
 
+# Attention shaped products, many small matrices per call
+H = 32
+L = 128
+HEAD_DIM = 128
+
 
 def time_batch_matmul():
     mx.random.seed(3)
@@ -49,6 +54,34 @@ def time_unbatch_matmul():
     time_fn(unbatch_vjp_second)
 
 
+def time_attention_matmul():
+    mx.random.seed(3)
+    q = mx.random.uniform(shape=(B, H, L, HEAD_DIM))
+    k = mx.random.uniform(shape=(B, H, L, HEAD_DIM))
+    v = mx.random.uniform(shape=(B, H, L, HEAD_DIM))
+    w = mx.random.uniform(shape=(1, 1, HEAD_DIM, HEAD_DIM))
+    mx.eval(q, k, v, w)
+
+    def attention_scores():
+        return q @ mx.swapaxes(k, -1, -2)
+
+    time_fn(attention_scores)
+
+    scores = attention_scores()
+    mx.eval(scores)
+
+    def attention_values():
+        return scores @ v
+
+    time_fn(attention_values)
+
+    # The same B for every matrix of the batch
+    def broadcast_weight():
+        return q @ w
+
+    time_fn(broadcast_weight)
+
+
 if __name__ == "__main__":
     parser = argparse.ArgumentParser("MLX benchmarks.")
     parser.add_argument("--gpu", action="store_true", help="Use the Metal back-end.")
@@ -60,3 +93,4 @@ if __name__ == "__main__":
 
     time_batch_matmul()
     time_unbatch_matmul()
+    time_attention_matmul()
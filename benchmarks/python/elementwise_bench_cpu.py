@@ -0,0 +1,54 @@
+# Copyright © 2025 Apple Inc.
+
+# Times element-wise ops and reductions at every vector width the CPU
+# supports. The width is read once per process so each one runs in a
+# subprocess with MLX_CPU_SIMD_WIDTH set.
+
+import os
+import subprocess
+import sys
+
+WIDTHS = [16, 32, 64]
+
+
+def run():
+    import mlx.core as mx
+    from time_utils import time_fn
+
+    mx.set_default_device(mx.cpu)
+
+    ops = {
+        "exp": lambda x, y: mx.exp(x),
+        "sin": lambda x, y: mx.sin(x),
+        "erf": lambda x, y: mx.erf(x),
+        "sigmoid": lambda x, y: mx.sigmoid(x),
+        "add": lambda x, y: x + y,
+        "maximum": lambda x, y: mx.maximum(x, y),
+        "sum": lambda x, y: mx.sum(x, axis=-1),
+        "max": lambda x, y: mx.max(x, axis=-1),
+    }
+
+    for dt in [mx.float32, mx.float16, mx.bfloat16]:
+        x = mx.random.uniform(-4, 4, shape=(64, 16384)).astype(dt)
+        y = mx.random.uniform(-4, 4, shape=(64, 16384)).astype(dt)
+        mx.eval(x, y)
+
+        def loop(f, x, y):
+            outs = []
+            for _ in range(16):
+                outs.append(f(x, y))
+            return outs
+
+        for name, f in ops.items():
+            time_fn(loop, f, x, y, msg=f"{name} {dt}")
+
+
+if __name__ == "__main__":
+    if os.environ.get("MLX_CPU_SIMD_WIDTH"):
+        run()
+        sys.exit(0)
+
+    for width in WIDTHS:
+        print(f"MLX_CPU_SIMD_WIDTH={width}")
+        env = dict(os.environ, MLX_CPU_SIMD_WIDTH=str(width))
+        subprocess.run([sys.executable, __file__], env=env, check=True)
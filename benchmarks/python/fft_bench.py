@@ -1,5 +1,7 @@
 # Copyright © 2024 Apple Inc.
 
+import argparse
+
 import matplotlib
 import mlx.core as mx
 import numpy as np
@@ -114,5 +116,33 @@ def time_fft():
     print("Percent MLX faster than MPS: ", portion_faster * 100)
 
 
+def time_cpu_batches():
+    # The same shapes repeated, as in an STFT, reuse the cached plans
+    print("CPU batched throughput")
+    with mx.stream(mx.cpu):
+        for n in [256, 512, 1024, 4096]:
+            for batch in [1, 64, 1024]:
+                x = mx.random.normal((batch, n))
+                xc = x.astype(mx.complex64)
+                mx.eval(x, xc)
+                rfft_ms = measure_runtime(lambda x: mx.eval(mx.fft.rfft(x)), x=x)
+                fft_ms = measure_runtime(lambda x: mx.eval(mx.fft.fft(x)), x=xc)
+                print(
+                    f"n={n:5d} batch={batch:5d} "
+                    f"rfft {rfft_ms:8.3f} ms ({batch / rfft_ms:9.1f} rows/ms) "
+                    f"fft {fft_ms:8.3f} ms ({batch / fft_ms:9.1f} rows/ms)"
+                )
+
+
 if __name__ == "__main__":
-    time_fft()
+    parser = argparse.ArgumentParser("FFT benchmarks.")
+    parser.add_argument(
+        "--cpu-batches",
+        action="store_true",
+        help="Only time repeated batched transforms on the CPU.",
+    )
+    args = parser.parse_args()
+    if args.cpu_batches:
+        time_cpu_batches()
+    else:
+        time_fft()
@@ -0,0 +1,67 @@
+# Copyright © 2025 Apple Inc.
+
+# Sweeps matmul shapes on the CPU for every floating point type and prints
+# the achieved GFLOPS. The shapes cover decoding (a few rows against a
+# weight), prefill, square products and batches of attention sized products.
+
+import argparse
+import time
+
+import mlx.core as mx
+
+# (batch, M, N, K, transpose B)
+SHAPES = [
+    (1, 1, 4096, 4096, True),
+    (1, 4, 4096, 4096, True),
+    (1, 16, 4096, 4096, True),
+    (1, 128, 4096, 4096, True),
+    (1, 512, 4096, 4096, True),
+    (1, 512, 11008, 4096, True),
+    (1, 256, 256, 256, False),
+    (1, 1024, 1024, 1024, False),
+    (1, 2048, 2048, 2048, False),
+    (32, 128, 128, 128, True),
+    (32, 128, 128, 128, False),
+]
+
+
+def gflops(batch, M, N, K, dtype, transpose_b):
+    a = mx.random.normal((batch, M, K)).astype(dtype)
+    if transpose_b:
+        b = mx.random.normal((batch, N, K)).astype(dtype)
+        b = mx.swapaxes(b, -1, -2)
+    else:
+        b = mx.random.normal((batch, K, N)).astype(dtype)
+    mx.eval(a, b)
+
+    for _ in range(3):
+        mx.eval(a @ b)
+    iters = 0
+    tic = time.perf_counter()
+    while True:
+        mx.eval(a @ b)
+        iters += 1
+        elapsed = time.perf_counter() - tic
+        if elapsed > 0.5:
+            break
+    return 2 * batch * M * N * K * iters / elapsed / 1e9
+
+
+if __name__ == "__main__":
+    parser = argparse.ArgumentParser("CPU GEMM shape sweep.")
+    parser.add_argument(
+        "--dtypes",
+        default="float32,float16,bfloat16",
+        help="Comma separated types to time.",
+    )
+    args = parser.parse_args()
+    mx.set_default_device(mx.cpu)
+
+    dtypes = [getattr(mx, d) for d in args.dtypes.split(",")]
+    header = f"{'batch':>5} {'M':>5} {'N':>6} {'K':>5} {'B':>2}"
+    print(header + "".join(f"{str(d).split('.')[-1]:>10}" for d in dtypes))
+    for batch, M, N, K, transpose_b in SHAPES:
+        row = f"{batch:>5} {M:>5} {N:>6} {K:>5} {'T' if transpose_b else 'N':>2}"
+        for dtype in dtypes:
+            row += f"{gflops(batch, M, N, K, dtype, transpose_b):>10.1f}"
+        print(row)
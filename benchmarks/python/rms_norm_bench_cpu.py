@@ -0,0 +1,52 @@
+# Copyright © 2025 Apple Inc.
+
+import mlx.core as mx
+from time_utils import time_fn
+
+mx.set_default_device(mx.cpu)
+
+
+def rms_norm(x, w, eps):
+    ot = x.dtype
+    x = x.astype(mx.float32)
+    n = mx.rsqrt(x.square().mean(-1, keepdims=True) + eps)
+    y = (x * n).astype(ot)
+    if w is not None:
+        y = y * w
+    return y
+
+
+def time_rms_norm(N, dt):
+    x = mx.random.uniform(shape=(4, 256, N)).astype(dt)
+    w = mx.random.uniform(shape=(N,)).astype(dt)
+    y = mx.random.uniform(shape=(4, 256, N)).astype(dt)
+    mx.eval(x, w, y)
+
+    def rms_norm_loop(f, x, w):
+        for _ in range(8):
+            x = f(x, w, 1e-5)
+        return x
+
+    time_fn(rms_norm_loop, rms_norm, x, w, msg="unfused")
+    time_fn(rms_norm_loop, mx.fast.rms_norm, x, w, msg="fused")
+
+    f1 = lambda x, w, y: (rms_norm(x, w, 1e-5) * y).sum()
+    f2 = lambda x, w, y: (mx.fast.rms_norm(x, w, 1e-5) * y).sum()
+    g1 = mx.grad(f1, argnums=(0, 1))
+    g2 = mx.grad(f2, argnums=(0, 1))
+
+    def rms_norm_grad_loop(g, x, w):
+        gx, gw = x, w
+        for _ in range(8):
+            gx, gw = g(gx, gw, y)
+        return gx, gw
+
+    time_fn(rms_norm_grad_loop, g1, x, w, msg="unfused grad")
+    time_fn(rms_norm_grad_loop, g2, x, w, msg="fused grad")
+
+
+if __name__ == "__main__":
+    for dt in [mx.float32, mx.float16, mx.bfloat16]:
+        for n in [1024, 4096, 8192]:
+            print(dt, n)
+            time_rms_norm(n, dt)
@@ -0,0 +1,59 @@
+# Copyright © 2025 Apple Inc.
+
+import math
+
+import mlx.core as mx
+from time_utils import time_fn
+
+mx.set_default_device(mx.cpu)
+
+
+def rope(x, dims, base, offset):
+    # Unfused rotary embedding in the non-traditional layout
+    L = x.shape[-2]
+    half = dims // 2
+    positions = mx.arange(offset, offset + L, dtype=mx.float32)
+    inv_freqs = mx.exp(-mx.arange(half, dtype=mx.float32) * (math.log(base) / half))
+    theta = positions[:, None] * inv_freqs[None, :]
+    c, s = mx.cos(theta), mx.sin(theta)
+    x1, x2, rest = x[..., :half], x[..., half:dims], x[..., dims:]
+    y1 = (x1 * c - x2 * s).astype(x.dtype)
+    y2 = (x1 * s + x2 * c).astype(x.dtype)
+    return mx.concatenate([y1, y2, rest], axis=-1)
+
+
+def time_rope(dt):
+    fused = lambda x, offset: mx.fast.rope(
+        x, 128, traditional=False, base=10000.0, scale=1.0, offset=offset
+    )
+    unfused = lambda x, offset: rope(x, 128, 10000.0, offset)
+
+    # vec
+    x = mx.random.uniform(shape=(1, 32, 1, 128)).astype(dt)
+    mx.eval(x)
+
+    def rope_vec(f, x):
+        for _ in range(32):
+            x = f(x, 100)
+        return x
+
+    time_fn(rope_vec, unfused, x, msg="unfused vec")
+    time_fn(rope_vec, fused, x, msg="fused vec")
+
+    # matrix
+    x = mx.random.uniform(shape=(1, 32, 512, 128)).astype(dt)
+    mx.eval(x)
+
+    def rope_mat(f, x):
+        for _ in range(8):
+            x = f(x, 0)
+        return x
+
+    time_fn(rope_mat, unfused, x, msg="unfused mat")
+    time_fn(rope_mat, fused, x, msg="fused mat")
+
+
+if __name__ == "__main__":
+    for dt in [mx.float32, mx.float16, mx.bfloat16]:
+        print(dt)
+        time_rope(dt)
@@ -0,0 +1,58 @@
+# Copyright © 2025 Apple Inc.
+
+import math
+
+import mlx.core as mx
+from time_utils import time_fn
+
+mx.set_default_device(mx.cpu)
+
+
+def attention(q, k, v, mask=None):
+    B, Hq, L, D = q.shape
+    _, Hk, S, _ = k.shape
+    q = q.reshape(B, Hk, Hq // Hk, L, D)
+    k = k[:, :, None, :, :]
+    v = v[:, :, None, :, :]
+    s = (q * (1.0 / math.sqrt(D))) @ k.transpose(0, 1, 2, 4, 3)
+    if mask == "causal":
+        offset = S - L
+        m = mx.arange(offset, offset + L)[:, None] >= mx.arange(S)[None]
+        s = mx.where(m, s, mx.finfo(s.dtype).min)
+    p = mx.softmax(s.astype(mx.float32), axis=-1).astype(s.dtype)
+    o = p @ v
+    return o.reshape(B, Hq, L, -1)
+
+
+def sdpa(q, k, v, mask=None):
+    D = q.shape[-1]
+    return mx.fast.scaled_dot_product_attention(
+        q, k, v, scale=1.0 / math.sqrt(D), mask=mask
+    )
+
+
+def time_attention(L, S, H, H_k, D, dtype, mask):
+    q = mx.random.uniform(shape=(1, H, L, D)).astype(dtype)
+    k = mx.random.uniform(shape=(1, H_k, S, D)).astype(dtype)
+    v = mx.random.uniform(shape=(1, H_k, S, D)).astype(dtype)
+    mx.eval(q, k, v)
+
+    o1 = attention(q, k, v, mask)
+    o2 = sdpa(q, k, v, mask)
+    atol = 1e-5 if dtype == mx.float32 else 2e-3
+    if not mx.allclose(o1, o2, atol=atol):
+        print(f"Mismatch: max error {mx.abs(o1 - o2).max().item()}")
+
+    time_fn(attention, q, k, v, mask, msg=f"unfused L={L} S={S}")
+    time_fn(sdpa, q, k, v, mask, msg=f"fused L={L} S={S}")
+
+
+if __name__ == "__main__":
+    for dtype in [mx.float32, mx.float16]:
+        print(dtype)
+        # Decode
+        for S in [1024, 4096, 16384]:
+            time_attention(1, S, 32, 8, 128, dtype, None)
+        # Prefill
+        for L in [256, 1024, 2048]:
+            time_attention(L, L, 32, 8, 64, dtype, "causal")
@@ -4,6 +4,7 @@
 #include <sstream>
 
 #include "mlx/allocator.h"
+#include "mlx/trace.h"
 
 namespace mlx::core::allocator {
 
@@ -14,11 +15,28 @@ Buffer malloc(size_t size) {
     msg << "[malloc] Unable to allocate " << size << " bytes.";
     throw std::runtime_error(msg.str());
   }
+  if (detail::trace_enabled()) {
+    detail::trace_allocation(TraceEvent::malloc, size);
+  }
   return buffer;
 }
 
 void free(Buffer buffer) {
+  if (detail::trace_enabled()) {
+    auto size = allocator().size(buffer);
+    allocator().free(buffer);
+    detail::trace_allocation(TraceEvent::free, size);
+    return;
+  }
   allocator().free(buffer);
 }
 
+Buffer make_buffer(void* ptr, size_t size) {
+  return allocator().make_buffer(ptr, size);
+}
+
+void release(Buffer buffer) {
+  allocator().release(buffer);
+}
+
 } // namespace mlx::core::allocator
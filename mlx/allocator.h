@@ -32,12 +32,23 @@ Buffer malloc(size_t size);
 
 void free(Buffer buffer);
 
+// Wrap size bytes of memory owned by the caller in a buffer. Returns a null
+// buffer when the allocator cannot use the memory in place. The memory must
+// outlive the buffer which is released with release() rather than free().
+Buffer make_buffer(void* ptr, size_t size);
+
+void release(Buffer buffer);
+
 class Allocator {
   /** Abstract base class for a memory allocator. */
  public:
   virtual Buffer malloc(size_t size) = 0;
   virtual void free(Buffer buffer) = 0;
   virtual size_t size(Buffer buffer) const = 0;
+  virtual Buffer make_buffer(void* /* ptr */, size_t /* size */) {
+    return Buffer{nullptr};
+  };
+  virtual void release(Buffer /* buffer */) {};
 
   Allocator() = default;
   Allocator(const Allocator& other) = delete;
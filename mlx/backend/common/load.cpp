@@ -28,6 +28,21 @@ void swap_endianness(uint8_t* data_bytes, size_t N) {
 namespace mlx::core {
 
 void Load::eval_cpu(const std::vector<array>& inputs, array& out) {
+  // Alias the mapped file pages when the tensor can be used as stored
+  if (auto mapped = std::dynamic_pointer_cast<io::MmapReader>(reader_);
+      mapped && mapped->is_mapped() && !swap_endianness_ &&
+      offset_ % out.itemsize() == 0 &&
+      offset_ + out.nbytes() <= mapped->size()) {
+    out.set_data(mapped->buffer(), [mapped](allocator::Buffer) {});
+    out.copy_shared_buffer(
+        out,
+        out.strides(),
+        out.flags(),
+        out.data_size(),
+        offset_ / out.itemsize());
+    return;
+  }
+
   out.set_data(allocator::malloc(out.nbytes()));
   auto read_task = [out_ptr = out.data<char>(),
                     size = out.size(),
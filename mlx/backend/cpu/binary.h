@@ -7,6 +7,8 @@
 #include "mlx/backend/common/binary.h"
 #include "mlx/backend/common/utils.h"
 
+#include "mlx/backend/cpu/parallel.h"
+#include "mlx/backend/cpu/simd/dispatch.h"
 #include "mlx/backend/cpu/simd/simd.h"
 
 namespace mlx::core {
@@ -16,18 +18,21 @@ struct VectorScalar {
   template <typename T, typename U>
   void operator()(const T* a, const T* b, U* dst, int size) {
     T scalar = *b;
-    constexpr int N = simd::max_size<T>;
-    while (size >= N) {
-      simd::store(dst, Op{}(simd::load<T, N>(a), simd::Simd<T, N>(scalar)));
-      dst += N;
-      a += N;
-      size -= N;
-    }
-    while (size-- > 0) {
-      *dst = Op{}(*a, scalar);
-      dst++;
-      a++;
-    }
+    simd::dispatch<T>([&](auto n) {
+      constexpr int N = decltype(n)::value;
+      while (size >= N) {
+        simd::store(dst, Op{}(simd::load<T, N>(a), simd::Simd<T, N>(scalar)));
+        dst += N;
+        a += N;
+        size -= N;
+      }
+      if (size > 0) {
+        simd::store_partial(
+            dst,
+            Op{}(simd::load_partial<T, N>(a, size), simd::Simd<T, N>(scalar)),
+            size);
+      }
+    });
   }
 };
 
@@ -36,18 +41,21 @@ struct ScalarVector {
   template <typename T, typename U>
   void operator()(const T* a, const T* b, U* dst, int size) {
     T scalar = *a;
-    constexpr int N = simd::max_size<T>;
-    while (size >= N) {
-      simd::store(dst, Op{}(simd::Simd<T, N>(scalar), simd::load<T, N>(b)));
-      dst += N;
-      b += N;
-      size -= N;
-    }
-    while (size-- > 0) {
-      *dst = Op{}(scalar, *b);
-      dst++;
-      b++;
-    }
+    simd::dispatch<T>([&](auto n) {
+      constexpr int N = decltype(n)::value;
+      while (size >= N) {
+        simd::store(dst, Op{}(simd::Simd<T, N>(scalar), simd::load<T, N>(b)));
+        dst += N;
+        b += N;
+        size -= N;
+      }
+      if (size > 0) {
+        simd::store_partial(
+            dst,
+            Op{}(simd::Simd<T, N>(scalar), simd::load_partial<T, N>(b, size)),
+            size);
+      }
+    });
   }
 };
 
@@ -55,20 +63,24 @@ template <typename Op>
 struct VectorVector {
   template <typename T, typename U>
   void operator()(const T* a, const T* b, U* dst, int size) {
-    constexpr int N = simd::max_size<T>;
-    while (size >= N) {
-      simd::store(dst, Op{}(simd::load<T, N>(a), simd::load<T, N>(b)));
-      dst += N;
-      a += N;
-      b += N;
-      size -= N;
-    }
-    while (size-- > 0) {
-      *dst = Op{}(*a, *b);
-      dst++;
-      a++;
-      b++;
-    }
+    simd::dispatch<T>([&](auto n) {
+      constexpr int N = decltype(n)::value;
+      while (size >= N) {
+        simd::store(dst, Op{}(simd::load<T, N>(a), simd::load<T, N>(b)));
+        dst += N;
+        a += N;
+        b += N;
+        size -= N;
+      }
+      if (size > 0) {
+        simd::store_partial(
+            dst,
+            Op{}(
+                simd::load_partial<T, N>(a, size),
+                simd::load_partial<T, N>(b, size)),
+            size);
+      }
+    });
   }
 };
 
@@ -115,37 +127,81 @@ void binary_op_dispatch_dims(
     const Strides& a_strides,
     const Strides& b_strides,
     const Strides& out_strides) {
-  switch (dim) {
-    case 1:
-      binary_op_dims<T, U, Op, 1, Strided>(
-          a, b, out, shape, a_strides, b_strides, out_strides, 0);
-      return;
-    case 2:
-      binary_op_dims<T, U, Op, 2, Strided>(
-          a, b, out, shape, a_strides, b_strides, out_strides, 0);
-      return;
-    case 3:
-      binary_op_dims<T, U, Op, 3, Strided>(
-          a, b, out, shape, a_strides, b_strides, out_strides, 0);
-      return;
+  if (size == 0) {
+    return;
   }
 
-  ContiguousIterator a_it(shape, a_strides, dim - 3);
-  ContiguousIterator b_it(shape, b_strides, dim - 3);
-  auto stride = out_strides[dim - 4];
-  for (int64_t elem = 0; elem < size; elem += stride) {
-    binary_op_dims<T, U, Op, 3, Strided>(
-        a + a_it.loc,
-        b + b_it.loc,
-        out + elem,
-        shape,
-        a_strides,
-        b_strides,
-        out_strides,
-        dim - 3);
-    a_it.step();
-    b_it.step();
+  // Split the outermost axis across threads
+  if (dim <= 3) {
+    auto row_size = std::max<int64_t>(size / shape[0], 1);
+    cpu::parallel_for(
+        shape[0], cpu::row_grain(row_size), [&](int64_t begin, int64_t end) {
+          auto sub_shape = shape;
+          sub_shape[0] = end - begin;
+          auto a_ptr = a + begin * a_strides[0];
+          auto b_ptr = b + begin * b_strides[0];
+          auto out_ptr = out + begin * out_strides[0];
+          switch (dim) {
+            case 1:
+              binary_op_dims<T, U, Op, 1, Strided>(
+                  a_ptr,
+                  b_ptr,
+                  out_ptr,
+                  sub_shape,
+                  a_strides,
+                  b_strides,
+                  out_strides,
+                  0);
+              return;
+            case 2:
+              binary_op_dims<T, U, Op, 2, Strided>(
+                  a_ptr,
+                  b_ptr,
+                  out_ptr,
+                  sub_shape,
+                  a_strides,
+                  b_strides,
+                  out_strides,
+                  0);
+              return;
+            case 3:
+              binary_op_dims<T, U, Op, 3, Strided>(
+                  a_ptr,
+                  b_ptr,
+                  out_ptr,
+                  sub_shape,
+                  a_strides,
+                  b_strides,
+                  out_strides,
+                  0);
+              return;
+          }
+        });
+    return;
   }
+
+  auto stride = out_strides[dim - 4];
+  cpu::parallel_for(
+      size / stride, cpu::row_grain(stride), [&](int64_t begin, int64_t end) {
+        ContiguousIterator a_it(shape, a_strides, dim - 3);
+        ContiguousIterator b_it(shape, b_strides, dim - 3);
+        a_it.seek(begin);
+        b_it.seek(begin);
+        for (int64_t elem = begin * stride; elem < end * stride;
+             elem += stride) {
+          binary_op_dims<T, U, Op, 3, Strided>(
+              a + a_it.loc,
+              b + b_it.loc,
+              out + elem,
+              shape,
+              a_strides,
+              b_strides,
+              out_strides,
+              dim - 3);
+          a_it.step();
+          b_it.step();
+        }
+      });
 }
 
 template <typename T, typename U, typename Op>
@@ -162,19 +218,31 @@ void binary_op(const array& a, const array& b, array& out, BinaryOpType bopt) {
 
   // The full computation is scalar vector so delegate to the op
   if (bopt == BinaryOpType::ScalarVector) {
-    ScalarVector<Op>{}(a_ptr, b_ptr, out_ptr, b.data_size());
+    cpu::parallel_for(b.data_size(), [&](int64_t begin, int64_t end) {
+      ScalarVector<Op>{}(
+          a_ptr, b_ptr + begin, out_ptr + begin, static_cast<int>(end - begin));
+    });
     return;
   }
 
   // The full computation is vector scalar so delegate to the op
   if (bopt == BinaryOpType::VectorScalar) {
-    VectorScalar<Op>{}(a_ptr, b_ptr, out_ptr, a.data_size());
+    cpu::parallel_for(a.data_size(), [&](int64_t begin, int64_t end) {
+      VectorScalar<Op>{}(
+          a_ptr + begin, b_ptr, out_ptr + begin, static_cast<int>(end - begin));
+    });
     return;
   }
 
   // The full computation is vector vector so delegate to the op
   if (bopt == BinaryOpType::VectorVector) {
-    VectorVector<Op>{}(a_ptr, b_ptr, out_ptr, a.size());
+    cpu::parallel_for(a.size(), [&](int64_t begin, int64_t end) {
+      VectorVector<Op>{}(
+          a_ptr + begin,
+          b_ptr + begin,
+          out_ptr + begin,
+          static_cast<int>(end - begin));
+    });
     return;
   }
 
@@ -1,8 +1,8 @@
 // Copyright © 2023-2024 Apple Inc.
 
 #include <dlfcn.h>
-#include <filesystem>
-#include <fstream>
+#include <atomic>
+#include <chrono>
 #include <list>
 #include <mutex>
 #include <shared_mutex>
@@ -13,9 +13,12 @@
 #include "mlx/backend/cpu/compiled_preamble.h"
 #include "mlx/backend/cpu/encoder.h"
 #include "mlx/backend/cpu/jit_compiler.h"
+#include "mlx/backend/cpu/kernel_cache.h"
+#include "mlx/compile.h"
 #include "mlx/device.h"
 #include "mlx/graph_utils.h"
-#include "mlx/version.h"
+#include "mlx/threadpool.h"
+#include "mlx/utils.h"
 
 namespace mlx::core {
 
@@ -38,7 +41,25 @@ struct CompilerCache {
   // Statics to cache compiled libraries and functions
   std::list<DLib> libs;
   std::unordered_map<std::string, void*> kernels;
+  std::unordered_map<std::string, std::shared_future<void*>> pending;
+  std::unordered_map<std::string, std::string> failed;
   std::shared_mutex mtx;
+
+  // Lookups are counted under the shared lock, the rest under the unique
+  // lock
+  std::atomic<size_t> hits{0};
+  std::atomic<size_t> misses{0};
+  size_t disk_hits{0};
+  size_t compiled{0};
+  double total_compile_ms{0};
+  double max_compile_ms{0};
+  std::atomic<bool> async{env::cpu_async_compile()};
+
+  cpu::KernelCache disk;
+
+  // Builds kernels in the background. Declared last so that it is joined
+  // before the caches are destroyed.
+  ThreadPool pool{2};
 };
 
 static CompilerCache& cache() {
@@ -55,72 +76,35 @@ bool compile_available_for_device(const Device& device) {
 
 } // namespace detail
 
-// Return a pointer to a compiled function
-void* compile(
-    const std::string& kernel_name,
-    const std::function<std::string(void)>& source_builder) {
-  {
-    std::shared_lock lock(cache().mtx);
-    if (auto it = cache().kernels.find(kernel_name);
-        it != cache().kernels.end()) {
-      return it->second;
-    }
-  }
-
-  std::unique_lock lock(cache().mtx);
-  if (auto it = cache().kernels.find(kernel_name);
-      it != cache().kernels.end()) {
-    return it->second;
-  }
-  std::string source_code = source_builder();
-  std::string kernel_file_name;
-
-  // Deal with long kernel names. Maximum length for filename on macOS is 255
-  // characters, and on Windows the maximum length for whole path is 260. Clip
-  // file name with a little extra room and append a 16 character hash.
-#ifdef _WIN32
-  constexpr int max_file_name_length = 140;
-#else
-  constexpr int max_file_name_length = 245;
-#endif
-  if (kernel_name.size() > max_file_name_length) {
-    std::ostringstream file_name;
-    file_name
-        << std::string_view(kernel_name).substr(0, max_file_name_length - 16);
-    auto file_id =
-        std::hash<std::string>{}(kernel_name.substr(max_file_name_length - 16));
-    file_name << "_" << std::hex << std::setw(16) << file_id << std::dec;
-    kernel_file_name = file_name.str();
-  } else {
-    kernel_file_name = kernel_name;
-  }
-
-  auto output_dir =
-      std::filesystem::temp_directory_path() / "mlx" / version() / "cpu";
-  if (!std::filesystem::exists(output_dir)) {
-    std::filesystem::create_directories(output_dir);
-  }
+void set_cpu_async_compile(bool enable) {
+  cache().async = enable;
+}
 
-  std::string shared_lib_name = "lib" + kernel_file_name + ".so";
-  auto shared_lib_path = (output_dir / shared_lib_name).string();
-  bool lib_exists = false;
-  {
-    std::ifstream f(shared_lib_path.c_str());
-    lib_exists = f.good();
-  }
+CompileStats cpu_compile_stats() {
+  auto& c = cache();
+  std::shared_lock lock(c.mtx);
+  return CompileStats{
+      c.hits,
+      c.misses,
+      c.disk_hits,
+      c.compiled,
+      c.failed.size(),
+      c.pending.size(),
+      c.total_compile_ms,
+      c.max_compile_ms};
+}
 
+// Build the shared library of a kernel, load it and add the function to the
+// cache.
+void* build_library(const std::string& kernel_name, std::string source_code) {
+  auto start = std::chrono::steady_clock::now();
+  auto& disk = cache().disk;
+  auto key = disk.key(source_code);
+  auto shared_lib_path = disk.find(key);
+  bool lib_exists = shared_lib_path.has_value();
   if (!lib_exists) {
-    // Open source file and write source code to it
-    std::string source_file_name = kernel_file_name + ".cpp";
-    auto source_file_path = (output_dir / source_file_name).string();
-
-    std::ofstream source_file(source_file_path);
-    source_file << source_code;
-    source_file.close();
-
     try {
-      JitCompiler::exec(JitCompiler::build_command(
-          output_dir, source_file_name, shared_lib_name));
+      shared_lib_path = disk.build(key, source_code);
     } catch (const std::exception& error) {
       throw std::runtime_error(fmt::format(
           "[Compile::eval_cpu] Failed to compile function {0}: {1}",
@@ -130,7 +114,8 @@ void* compile(
   }
 
   // load library
-  cache().libs.emplace_back(shared_lib_path);
+  std::unique_lock lock(cache().mtx);
+  cache().libs.emplace_back(shared_lib_path->string());
 
   // Load function
   void* fun = dlsym(cache().libs.back().lib, kernel_name.c_str());
@@ -142,9 +127,158 @@ void* compile(
     throw std::runtime_error(msg.str());
   }
   cache().kernels.insert({kernel_name, fun});
+  cache().pending.erase(kernel_name);
+
+  if (lib_exists) {
+    cache().disk_hits++;
+  } else {
+    std::chrono::duration<double, std::milli> elapsed =
+        std::chrono::steady_clock::now() - start;
+    cache().compiled++;
+    cache().total_compile_ms += elapsed.count();
+    cache().max_compile_ms = std::max(cache().max_compile_ms, elapsed.count());
+  }
   return fun;
 }
 
+// Return a pointer to a compiled function. The kernel is built on a
+// background thread so that lookups of other kernels are not blocked. If
+// wait is false and the kernel is not ready a null pointer is returned.
+void* compile(
+    const std::string& kernel_name,
+    const std::function<std::string(void)>& source_builder,
+    bool wait) {
+  auto& c = cache();
+  {
+    std::shared_lock lock(c.mtx);
+    if (auto it = c.kernels.find(kernel_name); it != c.kernels.end()) {
+      c.hits++;
+      return it->second;
+    }
+  }
+
+  std::shared_future<void*> fut;
+  {
+    std::unique_lock lock(c.mtx);
+    if (auto it = c.kernels.find(kernel_name); it != c.kernels.end()) {
+      c.hits++;
+      return it->second;
+    }
+    c.misses++;
+    if (auto it = c.failed.find(kernel_name); it != c.failed.end()) {
+      if (!wait) {
+        return nullptr;
+      }
+      throw std::runtime_error(it->second);
+    }
+    if (auto it = c.pending.find(kernel_name); it != c.pending.end()) {
+      fut = it->second;
+    } else {
+      auto source_code = source_builder();
+      c.disk.record(kernel_name, source_code);
+      auto task = [kernel_name, source_code = std::move(source_code)]() {
+        try {
+          return build_library(kernel_name, std::move(source_code));
+        } catch (const std::exception& error) {
+          std::unique_lock lock(cache().mtx);
+          cache().pending.erase(kernel_name);
+          cache().failed.insert({kernel_name, error.what()});
+          throw;
+        }
+      };
+      fut = c.pool.enqueue(std::move(task)).share();
+      c.pending.insert({kernel_name, fut});
+    }
+  }
+  if (!wait) {
+    return nullptr;
+  }
+  return fut.get();
+}
+
+void record_cpu_kernels(const std::string& path) {
+  cache().disk.set_record_path(path);
+}
+
+size_t prewarm_cpu_kernels(const std::string& path) {
+  auto kernels = cpu::KernelCache::read_recording(path);
+
+  // Queue all the builds first so that they run concurrently
+  for (auto& [name, source] : kernels) {
+    compile(name, [&source = source]() { return source; }, false);
+  }
+  size_t loaded = 0;
+  for (auto& [name, source] : kernels) {
+    try {
+      compile(name, [&source = source]() { return source; }, true);
+      loaded++;
+    } catch (const std::exception&) {
+      // Reported in the compile stats
+    }
+  }
+  return loaded;
+}
+
+// Evaluate the tape one primitive at a time. This is used while the kernel
+// is compiled in the background. Returns false without dispatching anything
+// if the shapes of the tape cannot be inferred.
+bool eval_tape(
+    const std::vector<array>& inputs,
+    std::vector<array>& outputs,
+    const std::vector<array>& tape_inputs,
+    const std::vector<array>& tape_outputs,
+    const std::vector<array>& tape,
+    Stream stream) {
+  std::unordered_map<uintptr_t, array> values;
+  bool shapeless = false;
+  for (size_t i = 0; i < inputs.size(); ++i) {
+    values.insert({tape_inputs[i].id(), inputs[i]});
+    shapeless |= inputs[i].shape() != tape_inputs[i].shape();
+  }
+  std::unordered_map<uintptr_t, array> output_map;
+  for (size_t i = 0; i < outputs.size(); ++i) {
+    output_map.insert({tape_outputs[i].id(), outputs[i]});
+  }
+
+  // Make placeholders for every array on the tape first
+  struct Step {
+    Primitive& primitive;
+    std::vector<array> inputs;
+    std::vector<array> outputs;
+  };
+  std::vector<Step> steps;
+  std::vector<array> temporaries;
+  try {
+    for (auto& a : tape) {
+      std::vector<array> step_inputs;
+      for (auto& in : a.inputs()) {
+        step_inputs.push_back(values.at(in.id()));
+      }
+      auto shape = shapeless ? a.primitive().output_shapes(step_inputs)[0]
+                             : a.shape();
+      array out = array(shape, a.dtype(), nullptr, {});
+      if (auto it = output_map.find(a.id()); it != output_map.end()) {
+        if (it->second.shape() != shape) {
+          return false;
+        }
+        out = it->second;
+      } else {
+        temporaries.push_back(out);
+      }
+      values.insert({a.id(), out});
+      steps.push_back({a.primitive(), std::move(step_inputs), {out}});
+    }
+  } catch (const std::exception&) {
+    return false;
+  }
+
+  for (auto& step : steps) {
+    step.primitive.eval_cpu(step.inputs, step.outputs);
+  }
+  cpu::get_command_encoder(stream).add_temporaries(std::move(temporaries));
+  return true;
+}
+
 inline void build_kernel(
     std::ostream& os,
     const std::string& kernel_name,
@@ -312,7 +446,7 @@ void Compiled::eval_cpu(
   }
 
   // Get the function
-  auto fn_ptr = compile(kernel_name, [&, contiguous = contiguous]() {
+  auto source_builder = [&, contiguous = contiguous]() {
     std::ostringstream kernel;
     kernel << get_kernel_preamble() << std::endl;
     kernel << "extern \"C\"  {" << std::endl;
@@ -328,7 +462,17 @@ void Compiled::eval_cpu(
     // Close extern "C"
     kernel << "}" << std::endl;
     return kernel.str();
-  });
+  };
+  bool async = cache().async;
+  auto fn_ptr = compile(kernel_name, source_builder, !async);
+
+  // Run the tape uncompiled until the kernel is ready
+  if (fn_ptr == nullptr) {
+    if (eval_tape(inputs, outputs, inputs_, outputs_, tape_, stream())) {
+      return;
+    }
+    fn_ptr = compile(kernel_name, source_builder, true);
+  }
 
   compiled_allocate_outputs(inputs, outputs, is_constant_, contiguous);
 
@@ -5,6 +5,7 @@
 
 #include "mlx/backend/cpu/copy.h"
 #include "mlx/backend/cpu/encoder.h"
+#include "mlx/backend/cpu/parallel.h"
 #include "mlx/backend/cpu/lapack.h"
 #include "mlx/primitives.h"
 #include "mlx/utils.h"
@@ -68,41 +69,47 @@ void slow_conv_1D(
                     in_dilation = in_dilation[0]]() mutable {
     auto O_per_group = O / groups;
 
-    for (int n = 0; n < N; ++n) {
-      for (int oh = 0; oh < oH; ++oh) {
-        for (int g = 0; g < groups; ++g) {
-          for (int o = g * O_per_group; o < (g + 1) * O_per_group; ++o) {
-            const T* filter_wt_ptr = start_wt_ptr + o * wt_stride_O;
-            float r = 0.;
-
-            for (int wh = 0; wh < wH; ++wh) {
-              const T* wt_ptr = filter_wt_ptr + wh * wt_stride_H;
-
-              int wh_flip = flip ? (wH - wh - 1) : wh;
-              int ih = oh * wt_stride - padding_lo + wh_flip * wt_dilation;
-
-              auto ih_div = std::div(ih, in_dilation);
-
-              if (ih >= 0 && ih < iH && ih_div.rem == 0) {
-                for (int c = g * C_per_group; c < (g + 1) * C_per_group; ++c) {
-                  r +=
-                      static_cast<float>(
-                          in_ptr[ih_div.quot * in_stride_H + c * in_stride_C]) *
-                      static_cast<float>(
-                          wt_ptr[(c % C_per_group) * wt_stride_C]);
-                } // c
-
-              } // ih check
-            } // wh
-
-            out_ptr[oh * out_stride_H + o * out_stride_O] = static_cast<T>(r);
-          } // o
-        } // g
-      } // oh
-
-      in_ptr += in_stride_N;
-      out_ptr += out_stride_N;
-    } // n
+    // Split the batch and output rows across threads
+    cpu::parallel_for(
+        N * oH, cpu::row_grain(O * wH * C_per_group), [&](auto begin, auto end) {
+          for (int64_t i = begin; i < end; ++i) {
+            int n = i / oH;
+            int oh = i % oH;
+            const T* n_in_ptr = in_ptr + n * in_stride_N;
+            T* n_out_ptr = out_ptr + n * out_stride_N;
+            for (int g = 0; g < groups; ++g) {
+              for (int o = g * O_per_group; o < (g + 1) * O_per_group; ++o) {
+                const T* filter_wt_ptr = start_wt_ptr + o * wt_stride_O;
+                float r = 0.;
+
+                for (int wh = 0; wh < wH; ++wh) {
+                  const T* wt_ptr = filter_wt_ptr + wh * wt_stride_H;
+
+                  int wh_flip = flip ? (wH - wh - 1) : wh;
+                  int ih = oh * wt_stride - padding_lo + wh_flip * wt_dilation;
+
+                  auto ih_div = std::div(ih, in_dilation);
+
+                  if (ih >= 0 && ih < iH && ih_div.rem == 0) {
+                    for (int c = g * C_per_group; c < (g + 1) * C_per_group;
+                         ++c) {
+                      r += static_cast<float>(
+                               n_in_ptr
+                                   [ih_div.quot * in_stride_H +
+                                    c * in_stride_C]) *
+                          static_cast<float>(
+                               wt_ptr[(c % C_per_group) * wt_stride_C]);
+                    } // c
+
+                  } // ih check
+                } // wh
+
+                n_out_ptr[oh * out_stride_H + o * out_stride_O] =
+                    static_cast<T>(r);
+              } // o
+            } // g
+          } // n, oh
+        });
   });
 }
 
@@ -295,14 +302,12 @@ void slow_conv_2D(
               } // g
             };
 
-        int oH_border_0 = 0;
         int oH_border_1 = is_idil_one
             ? ((padding_lo[0] + wt_strides[0] - 1) / wt_strides[0])
             : oH;
         int oH_border_2 = std::max(
             oH_border_1,
             (iH + padding_lo[0] - wH * wt_dilation[0]) / wt_strides[0]);
-        int oH_border_3 = oH;
 
         int oW_border_0 = 0;
         int oW_border_1 = is_idil_one
@@ -313,44 +318,42 @@ void slow_conv_2D(
             (iW + padding_lo[1] - wW * wt_dilation[1]) / wt_strides[1]);
         int oW_border_3 = oW;
 
-        for (int n = 0; n < N; ++n) {
-          // Case 1: oh might put us out of bounds
-          for (int oh = oH_border_0; oh < oH_border_1; ++oh) {
-            for (int ow = 0; ow < oW; ++ow) {
-              pt_conv_all_checks(st_in_ptr, st_wt_ptr, st_out_ptr, oh, ow);
-            } // ow
-          } // oh
-
-          // Case 2: oh in bounds
-          for (int oh = oH_border_1; oh < oH_border_2; ++oh) {
-            // Case a: ow might put us out of bounds
-            for (int ow = oW_border_0; ow < oW_border_1; ++ow) {
-              pt_conv_all_checks(st_in_ptr, st_wt_ptr, st_out_ptr, oh, ow);
-            } // ow
-
-            // Case b: ow in bounds
-            for (int ow = oW_border_1; ow < oW_border_2; ++ow) {
-              pt_conv_no_checks(st_in_ptr, st_wt_ptr, st_out_ptr, oh, ow);
-            } // ow
-
-            // Case c: ow might put us out of bounds
-            for (int ow = oW_border_2; ow < oW_border_3; ++ow) {
-              pt_conv_all_checks(st_in_ptr, st_wt_ptr, st_out_ptr, oh, ow);
-            } // ow
-
-          } // oh
-
-          // Case 3: oh might put us out of bounds
-          for (int oh = oH_border_2; oh < oH_border_3; ++oh) {
-            for (int ow = 0; ow < oW; ++ow) {
-              pt_conv_all_checks(st_in_ptr, st_wt_ptr, st_out_ptr, oh, ow);
-            } // ow
-          } // oh
-
-          st_in_ptr += in_stride_N;
-          st_out_ptr += out_stride_N;
-
-        } // n
+        // Split the batch and output rows across threads
+        cpu::parallel_for(
+            N * oH,
+            cpu::row_grain(oW * O * wH * wW * C_per_group),
+            [&](auto begin, auto end) {
+              for (int64_t i = begin; i < end; ++i) {
+                int n = i / oH;
+                int oh = i % oH;
+                const T* in_ptr = st_in_ptr + n * in_stride_N;
+                T* out_ptr = st_out_ptr + n * out_stride_N;
+
+                // Case 1 and 3: oh might put us out of bounds
+                if (oh < oH_border_1 || oh >= oH_border_2) {
+                  for (int ow = 0; ow < oW; ++ow) {
+                    pt_conv_all_checks(in_ptr, st_wt_ptr, out_ptr, oh, ow);
+                  } // ow
+                  continue;
+                }
+
+                // Case 2: oh in bounds
+                // Case a: ow might put us out of bounds
+                for (int ow = oW_border_0; ow < oW_border_1; ++ow) {
+                  pt_conv_all_checks(in_ptr, st_wt_ptr, out_ptr, oh, ow);
+                } // ow
+
+                // Case b: ow in bounds
+                for (int ow = oW_border_1; ow < oW_border_2; ++ow) {
+                  pt_conv_no_checks(in_ptr, st_wt_ptr, out_ptr, oh, ow);
+                } // ow
+
+                // Case c: ow might put us out of bounds
+                for (int ow = oW_border_2; ow < oW_border_3; ++ow) {
+                  pt_conv_all_checks(in_ptr, st_wt_ptr, out_ptr, oh, ow);
+                } // ow
+              } // n, oh
+            });
       });
 }
 
@@ -582,14 +585,12 @@ void slow_conv_3D(
       } // o
     };
 
-    int oD_border_0 = 0;
     int oD_border_1 = is_idil_one
         ? ((padding_lo[0] + wt_strides[0] - 1) / wt_strides[0])
         : oD;
     int oD_border_2 = std::max(
         oD_border_1,
         (iD + padding_lo[0] - wD * wt_dilation[0]) / wt_strides[0]);
-    int oD_border_3 = oD;
 
     int oH_border_0 = 0;
     int oH_border_1 = is_idil_one
@@ -609,64 +610,61 @@ void slow_conv_3D(
         (iW + padding_lo[2] - wW * wt_dilation[2]) / wt_strides[2]);
     int oW_border_3 = oW;
 
-    for (int n = 0; n < N; ++n) {
-      // Case 1: od might put us out of bounds
-      for (int od = oD_border_0; od < oD_border_1; ++od) {
-        for (int oh = 0; oh < oH; ++oh) {
-          for (int ow = 0; ow < oW; ++ow) {
-            pt_conv_all_checks(st_in_ptr, st_wt_ptr, st_out_ptr, od, oh, ow);
-          } // ow
-        } // oh
-      } // od
-
-      // Case 2: od in bounds
-      for (int od = oD_border_1; od < oD_border_2; ++od) {
-        // Case 2.1: oh might put us out of bounds
-        for (int oh = oH_border_0; oh < oH_border_1; ++oh) {
-          for (int ow = 0; ow < oW; ++ow) {
-            pt_conv_all_checks(st_in_ptr, st_wt_ptr, st_out_ptr, od, oh, ow);
-          } // ow
-        } // oh
-
-        // Case 2.2: oh in bounds
-        for (int oh = oH_border_1; oh < oH_border_2; ++oh) {
-          // Case 2.2.1: ow might put us out of bounds
-          for (int ow = oW_border_0; ow < oW_border_1; ++ow) {
-            pt_conv_all_checks(st_in_ptr, st_wt_ptr, st_out_ptr, od, oh, ow);
-          } // ow
-
-          // Case 2.2.2: ow in bounds
-          for (int ow = oW_border_1; ow < oW_border_2; ++ow) {
-            pt_conv_no_checks(st_in_ptr, st_wt_ptr, st_out_ptr, od, oh, ow);
-          } // ow
-
-          // Case 2.2.3: ow might put us out of bounds
-          for (int ow = oW_border_2; ow < oW_border_3; ++ow) {
-            pt_conv_all_checks(st_in_ptr, st_wt_ptr, st_out_ptr, od, oh, ow);
-          } // ow
-        } // oh
-
-        // Case 2.3: oh might put us out of bounds
-        for (int oh = oH_border_2; oh < oH_border_3; ++oh) {
-          for (int ow = 0; ow < oW; ++ow) {
-            pt_conv_all_checks(st_in_ptr, st_wt_ptr, st_out_ptr, od, oh, ow);
-          } // ow
-        } // oh
-      } // od
-
-      // Case 3: od might put us out of bounds
-      for (int od = oD_border_2; od < oD_border_3; ++od) {
-        for (int oh = 0; oh < oH; ++oh) {
-          for (int ow = 0; ow < oW; ++ow) {
-            pt_conv_all_checks(st_in_ptr, st_wt_ptr, st_out_ptr, od, oh, ow);
-          } // ow
-        } // oh
-      } // od
-
-      st_in_ptr += in_stride_N;
-      st_out_ptr += out_stride_N;
-
-    } // n
+    // Split the batch and output depth slices across threads
+    cpu::parallel_for(
+        N * oD,
+        cpu::row_grain(oH * oW * O * wD * wH * wW * C),
+        [&](auto begin, auto end) {
+          for (int64_t i = begin; i < end; ++i) {
+            int n = i / oD;
+            int od = i % oD;
+            const T* in_ptr = st_in_ptr + n * in_stride_N;
+            T* out_ptr = st_out_ptr + n * out_stride_N;
+
+            // Case 1 and 3: od might put us out of bounds
+            if (od < oD_border_1 || od >= oD_border_2) {
+              for (int oh = 0; oh < oH; ++oh) {
+                for (int ow = 0; ow < oW; ++ow) {
+                  pt_conv_all_checks(in_ptr, st_wt_ptr, out_ptr, od, oh, ow);
+                } // ow
+              } // oh
+              continue;
+            }
+
+            // Case 2: od in bounds
+            // Case 2.1: oh might put us out of bounds
+            for (int oh = oH_border_0; oh < oH_border_1; ++oh) {
+              for (int ow = 0; ow < oW; ++ow) {
+                pt_conv_all_checks(in_ptr, st_wt_ptr, out_ptr, od, oh, ow);
+              } // ow
+            } // oh
+
+            // Case 2.2: oh in bounds
+            for (int oh = oH_border_1; oh < oH_border_2; ++oh) {
+              // Case 2.2.1: ow might put us out of bounds
+              for (int ow = oW_border_0; ow < oW_border_1; ++ow) {
+                pt_conv_all_checks(in_ptr, st_wt_ptr, out_ptr, od, oh, ow);
+              } // ow
+
+              // Case 2.2.2: ow in bounds
+              for (int ow = oW_border_1; ow < oW_border_2; ++ow) {
+                pt_conv_no_checks(in_ptr, st_wt_ptr, out_ptr, od, oh, ow);
+              } // ow
+
+              // Case 2.2.3: ow might put us out of bounds
+              for (int ow = oW_border_2; ow < oW_border_3; ++ow) {
+                pt_conv_all_checks(in_ptr, st_wt_ptr, out_ptr, od, oh, ow);
+              } // ow
+            } // oh
+
+            // Case 2.3: oh might put us out of bounds
+            for (int oh = oH_border_2; oh < oH_border_3; ++oh) {
+              for (int ow = 0; ow < oW; ++ow) {
+                pt_conv_all_checks(in_ptr, st_wt_ptr, out_ptr, od, oh, ow);
+              } // ow
+            } // oh
+          } // n, od
+        });
   });
 }
 
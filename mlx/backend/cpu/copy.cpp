@@ -6,6 +6,7 @@
 #include "mlx/backend/common/utils.h"
 #include "mlx/backend/cpu/copy.h"
 #include "mlx/backend/cpu/encoder.h"
+#include "mlx/backend/cpu/parallel.h"
 #include "mlx/backend/cpu/simd/simd.h"
 
 namespace mlx::core {
@@ -16,17 +17,19 @@ template <typename SrcT, typename DstT>
 void copy_single(const array& src, array& dst) {
   auto src_ptr = src.data<SrcT>();
   auto dst_ptr = dst.data<DstT>();
-  auto size = dst.size();
   auto val = static_cast<DstT>(src_ptr[0]);
-  std::fill_n(dst_ptr, size, val);
+  cpu::parallel_for(dst.size(), [&](int64_t begin, int64_t end) {
+    std::fill_n(dst_ptr + begin, end - begin, val);
+  });
 }
 
 template <typename SrcT, typename DstT>
 void copy_vector(const array& src, array& dst) {
   auto src_ptr = src.data<SrcT>();
   auto dst_ptr = dst.data<DstT>();
-  auto size = src.data_size();
-  std::copy(src_ptr, src_ptr + size, dst_ptr);
+  cpu::parallel_for(src.data_size(), [&](int64_t begin, int64_t end) {
+    std::copy(src_ptr + begin, src_ptr + end, dst_ptr + begin);
+  });
 }
 
 template <typename SrcT, typename DstT, int D>
@@ -92,8 +95,18 @@ void copy_general_general(
       copy_dims<SrcT, DstT, 1>(
           src_ptr, dst_ptr, shape, strides[0], strides[1], 0);
     } else if (ndim == 2) {
-      copy_dims<SrcT, DstT, 2>(
-          src_ptr, dst_ptr, shape, strides[0], strides[1], 0);
+      cpu::parallel_for(
+          shape[0], cpu::row_grain(shape[1]), [&](int64_t begin, int64_t end) {
+            auto sub_shape = shape;
+            sub_shape[0] = end - begin;
+            copy_dims<SrcT, DstT, 2>(
+                src_ptr + begin * strides[0][0],
+                dst_ptr + begin * strides[1][0],
+                sub_shape,
+                strides[0],
+                strides[1],
+                0);
+          });
     } else if (ndim == 3) {
       copy_dims<SrcT, DstT, 3>(
           src_ptr, dst_ptr, shape, strides[0], strides[1], 0);
@@ -107,21 +120,29 @@ void copy_general_general(
     dst_ptr += o_offset_ptr[0];
   }
 
-  ContiguousIterator in(shape, strides[0], ndim - 3);
-  ContiguousIterator out(shape, strides[1], ndim - 3);
   auto stride = std::accumulate(
       shape.end() - 3, shape.end(), 1, std::multiplies<int64_t>());
-  for (int64_t elem = 0; elem < size; elem += stride) {
-    copy_dims<SrcT, DstT, 3>(
-        src_ptr + in.loc,
-        dst_ptr + out.loc,
-        shape,
-        strides[0],
-        strides[1],
-        ndim - 3);
-    in.step();
-    out.step();
+  if (stride == 0) {
+    return;
   }
+  cpu::parallel_for(
+      size / stride, cpu::row_grain(stride), [&](int64_t begin, int64_t end) {
+        ContiguousIterator in(shape, strides[0], ndim - 3);
+        ContiguousIterator out(shape, strides[1], ndim - 3);
+        in.seek(begin);
+        out.seek(begin);
+        for (int64_t i = begin; i < end; i++) {
+          copy_dims<SrcT, DstT, 3>(
+              src_ptr + in.loc,
+              dst_ptr + out.loc,
+              shape,
+              strides[0],
+              strides[1],
+              ndim - 3);
+          in.step();
+          out.step();
+        }
+      });
 }
 
 template <typename SrcT, typename DstT>
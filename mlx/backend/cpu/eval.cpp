@@ -3,6 +3,7 @@
 #include "mlx/backend/cpu/encoder.h"
 #include "mlx/primitives.h"
 #include "mlx/scheduler.h"
+#include "mlx/trace.h"
 #include "mlx/utils.h"
 
 namespace mlx::core::cpu {
@@ -10,6 +11,14 @@ namespace mlx::core::cpu {
 void eval(array& arr) {
   auto s = arr.primitive().stream();
 
+  // Tasks before and after the primitive's own time it on the stream thread
+  std::shared_ptr<TraceEvent> event;
+  if (detail::trace_enabled()) {
+    event = detail::trace_primitive(arr);
+    cpu::get_command_encoder(s).dispatch(
+        [event]() { event->start = detail::trace_time(); });
+  }
+
   auto outputs = arr.outputs();
   {
     // If the array is a tracer hold a reference
@@ -35,6 +44,12 @@ void eval(array& arr) {
   auto& encoder = cpu::get_command_encoder(s);
   encoder.dispatch([buffers = std::move(buffers),
                     temps = std::move(encoder.temporaries())]() {});
+  if (event) {
+    encoder.dispatch([event = std::move(event)]() mutable {
+      event->end = detail::trace_time();
+      detail::trace_record(std::move(event));
+    });
+  }
 }
 
 } // namespace mlx::core::cpu
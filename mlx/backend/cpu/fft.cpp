@@ -1,14 +1,261 @@
 // Copyright © 2023 Apple Inc.
 
+#include <algorithm>
+#include <cmath>
+#include <list>
+#include <mutex>
 #include <numeric>
+#include <unordered_map>
 
 #include "mlx/3rdparty/pocketfft.h"
 #include "mlx/allocator.h"
 #include "mlx/backend/cpu/encoder.h"
+#include "mlx/backend/cpu/parallel.h"
 #include "mlx/primitives.h"
 
 namespace mlx::core {
 
+namespace {
+
+using pocketfft::detail::cmplx;
+using pocketfft::detail::pocketfft_c;
+using pocketfft::detail::pocketfft_r;
+
+// A plan holds the factorization and twiddle factors of one transform length
+// and does not depend on anything else, so one plan serves every shape and
+// batch with that length. Recently used plans are kept up to an estimate of
+// their memory.
+constexpr size_t max_plan_cache_bytes = 32 << 20;
+
+template <typename Plan>
+class PlanCache {
+ public:
+  std::shared_ptr<Plan> get(size_t n) {
+    {
+      std::lock_guard<std::mutex> lock(mtx_);
+      if (auto it = index_.find(n); it != index_.end()) {
+        lru_.splice(lru_.begin(), lru_, it->second);
+        return it->second->second;
+      }
+    }
+
+    // Build outside the lock, a concurrent miss at worst builds it twice
+    auto plan = std::make_shared<Plan>(n);
+    if (plan_bytes(n) > max_plan_cache_bytes) {
+      return plan;
+    }
+
+    std::lock_guard<std::mutex> lock(mtx_);
+    if (auto it = index_.find(n); it != index_.end()) {
+      return it->second->second;
+    }
+    lru_.emplace_front(n, plan);
+    index_[n] = lru_.begin();
+    bytes_ += plan_bytes(n);
+    while (bytes_ > max_plan_cache_bytes) {
+      auto old_n = lru_.back().first;
+      bytes_ -= plan_bytes(old_n);
+      index_.erase(old_n);
+      lru_.pop_back();
+    }
+    return plan;
+  }
+
+ private:
+  // Twiddles take a couple of complex values per point and Bluestein plans
+  // add a padded transform of about twice the length, so this is an upper
+  // estimate.
+  static size_t plan_bytes(size_t n) {
+    return 8 * n * sizeof(std::complex<float>);
+  }
+
+  using Entries = std::list<std::pair<size_t, std::shared_ptr<Plan>>>;
+
+  std::mutex mtx_;
+  Entries lru_;
+  std::unordered_map<size_t, typename Entries::iterator> index_;
+  size_t bytes_{0};
+};
+
+template <typename Plan>
+std::shared_ptr<Plan> get_plan(size_t n) {
+  static PlanCache<Plan> cache;
+  return cache.get(n);
+}
+
+// Rows are transformed vlen at a time with one row per SIMD lane, the same
+// way pocketfft batches them.
+#ifndef POCKETFFT_NO_VECTORS
+using vfloat = pocketfft::detail::vtype_t<float>;
+constexpr int vlen = pocketfft::detail::VLEN<float>::val;
+#else
+using vfloat = float;
+constexpr int vlen = 1;
+#endif
+
+template <typename T>
+float get_lane(const T& v, int j) {
+  if constexpr (std::is_same_v<T, float>) {
+    return v;
+  } else {
+    return v[j];
+  }
+}
+
+template <typename T>
+void set_lane(T& v, int j, float x) {
+  if constexpr (std::is_same_v<T, float>) {
+    v = x;
+  } else {
+    v[j] = x;
+  }
+}
+
+template <typename T, int L>
+void c2c_block(
+    const pocketfft_c<float>& plan,
+    const std::complex<float>* in,
+    std::complex<float>* out,
+    size_t n,
+    cmplx<T>* buf,
+    bool forward,
+    float scale) {
+  for (size_t k = 0; k < n; k++) {
+    for (int j = 0; j < L; j++) {
+      set_lane(buf[k].r, j, in[j * n + k].real());
+      set_lane(buf[k].i, j, in[j * n + k].imag());
+    }
+  }
+  plan.exec(buf, scale, forward);
+  for (size_t k = 0; k < n; k++) {
+    for (int j = 0; j < L; j++) {
+      out[j * n + k] = {get_lane(buf[k].r, j), get_lane(buf[k].i, j)};
+    }
+  }
+}
+
+// The real plans work in FFTPACK's halfcomplex order r0, r1, i1, r2, i2, ...
+template <typename T, int L>
+void r2c_block(
+    const pocketfft_r<float>& plan,
+    const float* in,
+    std::complex<float>* out,
+    size_t n,
+    T* buf,
+    bool forward,
+    float scale) {
+  size_t n_out = n / 2 + 1;
+  for (size_t k = 0; k < n; k++) {
+    for (int j = 0; j < L; j++) {
+      set_lane(buf[k], j, in[j * n + k]);
+    }
+  }
+  plan.exec(buf, scale, true);
+  float sign = forward ? 1.0f : -1.0f;
+  for (int j = 0; j < L; j++) {
+    auto out_j = out + j * n_out;
+    out_j[0] = get_lane(buf[0], j);
+    size_t i = 1, ii = 1;
+    for (; i < n - 1; i += 2, ii++) {
+      out_j[ii] = {get_lane(buf[i], j), sign * get_lane(buf[i + 1], j)};
+    }
+    if (i < n) {
+      out_j[ii] = get_lane(buf[i], j);
+    }
+  }
+}
+
+template <typename T, int L>
+void c2r_block(
+    const pocketfft_r<float>& plan,
+    const std::complex<float>* in,
+    float* out,
+    size_t n,
+    T* buf,
+    bool forward,
+    float scale) {
+  size_t n_in = n / 2 + 1;
+  float sign = forward ? -1.0f : 1.0f;
+  for (int j = 0; j < L; j++) {
+    auto in_j = in + j * n_in;
+    set_lane(buf[0], j, in_j[0].real());
+    size_t i = 1, ii = 1;
+    for (; i < n - 1; i += 2, ii++) {
+      set_lane(buf[i], j, in_j[ii].real());
+      set_lane(buf[i + 1], j, sign * in_j[ii].imag());
+    }
+    if (i < n) {
+      set_lane(buf[i], j, in_j[ii].real());
+    }
+  }
+  plan.exec(buf, scale, false);
+  for (size_t k = 0; k < n; k++) {
+    for (int j = 0; j < L; j++) {
+      out[j * n + k] = get_lane(buf[k], j);
+    }
+  }
+}
+
+// An FFT of length n costs about n log n operations per row.
+int64_t fft_grain(size_t n) {
+  auto cost = static_cast<int64_t>(n * std::max(1.0, std::log2(n)));
+  return std::max<int64_t>(vlen, cpu::row_grain(cost));
+}
+
+// Transforms contiguous rows of length n in parallel with cached plans.
+// Block(buf, row, lanes) transforms lanes rows starting at row.
+template <typename Buf, typename Block>
+void transform_rows(int64_t n_rows, size_t n, Block block) {
+  cpu::parallel_for(n_rows, fft_grain(n), [&](int64_t begin, int64_t end) {
+    std::vector<Buf> buf(n);
+    int64_t r = begin;
+    for (; r + vlen <= end; r += vlen) {
+      block(buf.data(), r, std::integral_constant<int, vlen>{});
+    }
+    for (; r < end; r++) {
+      block(buf.data(), r, std::integral_constant<int, 1>{});
+    }
+  });
+}
+
+// Other transforms go through pocketfft, split along the longest axis that
+// is not transformed so batches still spread over the CPU pool.
+template <typename F>
+void split_batch(
+    const std::vector<size_t>& shape,
+    const std::vector<size_t>& axes,
+    F f) {
+  int batch_axis = -1;
+  for (int i = 0; i < shape.size(); i++) {
+    if (std::find(axes.begin(), axes.end(), i) == axes.end() &&
+        (batch_axis < 0 || shape[i] > shape[batch_axis])) {
+      batch_axis = i;
+    }
+  }
+  if (batch_axis < 0) {
+    f(shape, 0, 0);
+    return;
+  }
+  size_t slice = std::accumulate(
+      shape.begin(), shape.end(), size_t(1), std::multiplies<size_t>());
+  slice /= std::max<size_t>(shape[batch_axis], 1);
+  size_t n = 1;
+  for (auto ax : axes) {
+    n = std::max(n, shape[ax]);
+  }
+  auto cost = static_cast<int64_t>(slice * std::max(1.0, std::log2(n)));
+  cpu::parallel_for(
+      shape[batch_axis],
+      cpu::row_grain(cost),
+      [&](int64_t begin, int64_t end) {
+        auto sub_shape = shape;
+        sub_shape[batch_axis] = end - begin;
+        f(sub_shape, batch_axis, begin);
+      });
+}
+
+} // namespace
+
 void FFT::eval_cpu(const std::vector<array>& inputs, array& out) {
   auto& in = inputs[0];
   std::vector<std::ptrdiff_t> strides_in(
@@ -44,6 +291,17 @@ void FFT::eval_cpu(const std::vector<array>& inputs, array& out) {
   encoder.set_input_array(in);
   encoder.set_output_array(out);
 
+  if (out.size() == 0) {
+    return;
+  }
+
+  // Transforms of the last axis of a contiguous input, as in an STFT, run on
+  // contiguous rows with cached plans
+  bool rows = axes_.size() == 1 && axes_[0] == in.ndim() - 1 &&
+      in.flags().row_contiguous;
+  size_t n = shape[axes_.back()];
+  int64_t n_rows = out.size() / out.shape(-1);
+
   if (in.dtype() == complex64 && out.dtype() == complex64) {
     auto in_ptr =
         reinterpret_cast<const std::complex<float>*>(in.data<complex64_t>());
@@ -56,16 +314,40 @@ void FFT::eval_cpu(const std::vector<array>& inputs, array& out) {
                       inverse = inverse_,
                       in_ptr,
                       out_ptr,
-                      scale]() {
-      pocketfft::c2c(
-          shape,
-          strides_in,
-          strides_out,
-          axes,
-          !inverse,
-          in_ptr,
-          out_ptr,
-          scale);
+                      scale,
+                      rows,
+                      n,
+                      n_rows]() {
+      if (rows) {
+        auto plan = get_plan<pocketfft_c<float>>(n);
+        transform_rows<cmplx<vfloat>>(
+            n_rows, n, [&](auto buf, int64_t r, auto lanes) {
+              constexpr int L = decltype(lanes)::value;
+              using T = std::conditional_t<L == 1, float, vfloat>;
+              c2c_block<T, L>(
+                  *plan,
+                  in_ptr + r * n,
+                  out_ptr + r * n,
+                  n,
+                  reinterpret_cast<cmplx<T>*>(buf),
+                  !inverse,
+                  scale);
+            });
+        return;
+      }
+      split_batch(shape, axes, [&](auto& sub_shape, int axis, int64_t start) {
+        auto in_offset = strides_in[axis] * start;
+        auto out_offset = strides_out[axis] * start;
+        pocketfft::c2c(
+            sub_shape,
+            strides_in,
+            strides_out,
+            axes,
+            !inverse,
+            in_ptr + in_offset / sizeof(std::complex<float>),
+            out_ptr + out_offset / sizeof(std::complex<float>),
+            scale);
+      });
     });
   } else if (in.dtype() == float32 && out.dtype() == complex64) {
     auto in_ptr = in.data<float>();
@@ -78,16 +360,40 @@ void FFT::eval_cpu(const std::vector<array>& inputs, array& out) {
                       inverse = inverse_,
                       in_ptr,
                       out_ptr,
-                      scale]() {
-      pocketfft::r2c(
-          shape,
-          strides_in,
-          strides_out,
-          axes,
-          !inverse,
-          in_ptr,
-          out_ptr,
-          scale);
+                      scale,
+                      rows,
+                      n,
+                      n_rows]() {
+      if (rows) {
+        auto plan = get_plan<pocketfft_r<float>>(n);
+        transform_rows<vfloat>(
+            n_rows, n, [&](auto buf, int64_t r, auto lanes) {
+              constexpr int L = decltype(lanes)::value;
+              using T = std::conditional_t<L == 1, float, vfloat>;
+              r2c_block<T, L>(
+                  *plan,
+                  in_ptr + r * n,
+                  out_ptr + r * (n / 2 + 1),
+                  n,
+                  reinterpret_cast<T*>(buf),
+                  !inverse,
+                  scale);
+            });
+        return;
+      }
+      split_batch(shape, axes, [&](auto& sub_shape, int axis, int64_t start) {
+        auto in_offset = strides_in[axis] * start;
+        auto out_offset = strides_out[axis] * start;
+        pocketfft::r2c(
+            sub_shape,
+            strides_in,
+            strides_out,
+            axes,
+            !inverse,
+            in_ptr + in_offset / sizeof(float),
+            out_ptr + out_offset / sizeof(std::complex<float>),
+            scale);
+      });
     });
   } else if (in.dtype() == complex64 && out.dtype() == float32) {
     auto in_ptr =
@@ -100,16 +406,40 @@ void FFT::eval_cpu(const std::vector<array>& inputs, array& out) {
                       inverse = inverse_,
                       in_ptr,
                       out_ptr,
-                      scale]() {
-      pocketfft::c2r(
-          shape,
-          strides_in,
-          strides_out,
-          axes,
-          !inverse,
-          in_ptr,
-          out_ptr,
-          scale);
+                      scale,
+                      rows,
+                      n,
+                      n_rows]() {
+      if (rows) {
+        auto plan = get_plan<pocketfft_r<float>>(n);
+        transform_rows<vfloat>(
+            n_rows, n, [&](auto buf, int64_t r, auto lanes) {
+              constexpr int L = decltype(lanes)::value;
+              using T = std::conditional_t<L == 1, float, vfloat>;
+              c2r_block<T, L>(
+                  *plan,
+                  in_ptr + r * (n / 2 + 1),
+                  out_ptr + r * n,
+                  n,
+                  reinterpret_cast<T*>(buf),
+                  !inverse,
+                  scale);
+            });
+        return;
+      }
+      split_batch(shape, axes, [&](auto& sub_shape, int axis, int64_t start) {
+        auto in_offset = strides_in[axis] * start;
+        auto out_offset = strides_out[axis] * start;
+        pocketfft::c2r(
+            sub_shape,
+            strides_in,
+            strides_out,
+            axes,
+            !inverse,
+            in_ptr + in_offset / sizeof(std::complex<float>),
+            out_ptr + out_offset / sizeof(float),
+            scale);
+      });
     });
   } else {
     throw std::runtime_error(
@@ -2,6 +2,7 @@
 
 #include "mlx/backend/common/utils.h"
 #include "mlx/backend/cpu/gemm.h"
+#include "mlx/backend/cpu/gemms/packed_gemm.h"
 #include "mlx/backend/cpu/lapack.h"
 
 namespace mlx::core {
@@ -28,6 +29,26 @@ void matmul<float>(
   size_t N = b_shape[ndim - 1];
   size_t K = a_shape[ndim - 1];
 
+  if (use_batched_gemm(batch_size, M, N, K)) {
+    batched_gemm<float, float>(
+        a,
+        b,
+        out,
+        a_transposed,
+        b_transposed,
+        lda,
+        ldb,
+        ldc,
+        alpha,
+        beta,
+        batch_size,
+        a_shape,
+        a_strides,
+        b_shape,
+        b_strides);
+    return;
+  }
+
   for (int i = 0; i < batch_size; ++i) {
     cblas_sgemm(
         CblasRowMajor,
@@ -69,6 +90,26 @@ void matmul<double>(
   size_t N = b_shape[ndim - 1];
   size_t K = a_shape[ndim - 1];
 
+  if (use_batched_gemm(batch_size, M, N, K)) {
+    batched_gemm<double, double>(
+        a,
+        b,
+        out,
+        a_transposed,
+        b_transposed,
+        lda,
+        ldb,
+        ldc,
+        alpha,
+        beta,
+        batch_size,
+        a_shape,
+        a_strides,
+        b_shape,
+        b_strides);
+    return;
+  }
+
   for (int i = 0; i < batch_size; ++i) {
     cblas_dgemm(
         CblasRowMajor,
@@ -0,0 +1,570 @@
+// Copyright © 2025 Apple Inc.
+#pragma once
+
+#include <algorithm>
+#include <vector>
+
+#include "mlx/backend/common/utils.h"
+#include "mlx/backend/cpu/parallel.h"
+#include "mlx/backend/cpu/simd/dispatch.h"
+#include "mlx/backend/cpu/simd/simd.h"
+
+namespace mlx::core {
+
+// A cache blocked GEMM on packed operands. It computes batches of small
+// matrices, e.g. the per head products of attention, and every product of
+// the half precision types, which BLAS does not cover.
+//
+// C is computed in blocks of NC columns and a chunk of rows, in parallel
+// across the blocks and the matrices of a batch. A block walks K in steps of
+// KC. At each step the KC x NC slice of B is packed in panels of NR = 2
+// vectors of columns, stored as KC rows of NR values, and then used for all
+// the rows of the chunk. The rows are packed MC at a time in panels of MR,
+// stored as KC columns of MR values. The micro kernel keeps an MR x NR tile
+// of C in 2 * MR vector registers, reading a panel of B from L1 and the
+// slice of A from L2. Packing converts the operands to the accumulation
+// type, so half precision inputs are converted once per block rather than
+// in the inner loop, and the tiles accumulate across the steps of K in the
+// accumulation type too.
+//
+// When every matrix of the batch uses the same B it is packed once, in
+// panels holding all of K, and shared by all the blocks. Products with fewer
+// than small_m rows are bound by reading B and skip the packing.
+namespace packed_gemm {
+
+constexpr int MR = 6;
+
+template <int S>
+constexpr int NR = 2 * S;
+
+constexpr int KC = 256;
+constexpr int MC = 16 * MR;
+constexpr int NC = 256;
+
+// The most blocks of MC rows one task computes, which bounds the C tiles it
+// accumulates to max_chunk_blocks * MC * NC values
+constexpr int max_chunk_blocks = 8;
+
+// The layout of the operands of every matrix of the batch, packed_b is B
+// when it is shared by the batch
+template <typename T, typename AccT>
+struct Problem {
+  bool a_transposed;
+  bool b_transposed;
+  size_t lda;
+  size_t ldb;
+  size_t ldc;
+  int M;
+  int N;
+  int K;
+  float alpha;
+  float beta;
+  const AccT* packed_b;
+};
+
+// Pack rows [i0, i1) and columns [k0, k0 + kc) of A in panels of MR rows,
+// rows past i1 are zero
+template <typename T, typename AccT>
+void pack_a(
+    const T* a,
+    AccT* out,
+    bool transpose,
+    size_t lda,
+    int i0,
+    int i1,
+    int k0,
+    int kc) {
+  for (int p0 = i0; p0 < i1; p0 += MR, out += kc * MR) {
+    int rows = std::min(MR, i1 - p0);
+    if (transpose) {
+      for (int k = 0; k < kc; k++) {
+        const T* src = a + (k0 + k) * lda + p0;
+        AccT* dst = out + k * MR;
+        for (int ii = 0; ii < rows; ii++) {
+          dst[ii] = static_cast<AccT>(src[ii]);
+        }
+        std::fill(dst + rows, dst + MR, AccT(0));
+      }
+    } else {
+      for (int ii = 0; ii < MR; ii++) {
+        AccT* dst = out + ii;
+        if (ii < rows) {
+          const T* src = a + (p0 + ii) * lda + k0;
+          for (int k = 0; k < kc; k++) {
+            dst[k * MR] = static_cast<AccT>(src[k]);
+          }
+        } else {
+          for (int k = 0; k < kc; k++) {
+            dst[k * MR] = 0;
+          }
+        }
+      }
+    }
+  }
+}
+
+// Pack columns [j0, j1) and rows [k0, k0 + kc) of B in panels of nr columns,
+// columns past j1 are zero
+template <typename T, typename AccT>
+void pack_b(
+    const T* b,
+    AccT* out,
+    bool transpose,
+    size_t ldb,
+    int nr,
+    int j0,
+    int j1,
+    int k0,
+    int kc) {
+  for (int p0 = j0; p0 < j1; p0 += nr, out += kc * nr) {
+    int cols = std::min(nr, j1 - p0);
+    if (transpose) {
+      // Transpose in blocks of 16 rows of the panel so the writes of a block
+      // stay in a few cache lines
+      for (int kb = 0; kb < kc; kb += 16) {
+        int kn = std::min(16, kc - kb);
+        for (int jj = 0; jj < nr; jj++) {
+          AccT* dst = out + kb * nr + jj;
+          if (jj < cols) {
+            const T* src = b + (p0 + jj) * ldb + k0 + kb;
+            for (int k = 0; k < kn; k++) {
+              dst[k * nr] = static_cast<AccT>(src[k]);
+            }
+          } else {
+            for (int k = 0; k < kn; k++) {
+              dst[k * nr] = 0;
+            }
+          }
+        }
+      }
+    } else {
+      for (int k = 0; k < kc; k++) {
+        const T* src = b + (k0 + k) * ldb + p0;
+        AccT* dst = out + k * nr;
+        for (int jj = 0; jj < cols; jj++) {
+          dst[jj] = static_cast<AccT>(src[jj]);
+        }
+        std::fill(dst + cols, dst + nr, AccT(0));
+      }
+    }
+  }
+}
+
+// tile = A panel * B panel, plus tile when accumulating
+template <typename AccT, int S>
+void micro_kernel(
+    const AccT* a,
+    const AccT* b,
+    int kc,
+    AccT* tile,
+    bool accumulate) {
+  constexpr int nr = NR<S>;
+  simd::Simd<AccT, S> acc[MR][2];
+#pragma GCC unroll 8
+  for (int ii = 0; ii < MR; ii++) {
+    if (accumulate) {
+      acc[ii][0] = simd::load<AccT, S>(tile + ii * nr);
+      acc[ii][1] = simd::load<AccT, S>(tile + ii * nr + S);
+    } else {
+      acc[ii][0] = acc[ii][1] = AccT(0);
+    }
+  }
+  for (int k = 0; k < kc; k++) {
+    auto b0 = simd::load<AccT, S>(b + k * nr);
+    auto b1 = simd::load<AccT, S>(b + k * nr + S);
+#pragma GCC unroll 8
+    for (int ii = 0; ii < MR; ii++) {
+      simd::Simd<AccT, S> av(a[k * MR + ii]);
+      acc[ii][0] = simd::fma(av, b0, acc[ii][0]);
+      acc[ii][1] = simd::fma(av, b1, acc[ii][1]);
+    }
+  }
+#pragma GCC unroll 8
+  for (int ii = 0; ii < MR; ii++) {
+    simd::store(tile + ii * nr, acc[ii][0]);
+    simd::store(tile + ii * nr + S, acc[ii][1]);
+  }
+}
+
+// C = alpha * tile + beta * C for the part of the tile inside C
+template <typename T, typename AccT>
+void store_tile(
+    const AccT* tile,
+    int nr,
+    T* c,
+    size_t ldc,
+    int rows,
+    int cols,
+    float alpha,
+    float beta) {
+  for (int ii = 0; ii < rows; ii++) {
+    const AccT* src = tile + ii * nr;
+    T* dst = c + ii * ldc;
+    if (beta != 0) {
+      for (int jj = 0; jj < cols; jj++) {
+        dst[jj] = static_cast<T>(
+            alpha * src[jj] + beta * static_cast<AccT>(dst[jj]));
+      }
+    } else {
+      for (int jj = 0; jj < cols; jj++) {
+        dst[jj] = static_cast<T>(alpha * src[jj]);
+      }
+    }
+  }
+}
+
+// Buffers for packed blocks and C tiles, kept by each thread across calls
+template <typename AccT>
+AccT* scratch(std::vector<AccT>& buffer, size_t size) {
+  if (buffer.size() < size) {
+    buffer.resize(size);
+  }
+  return buffer.data();
+}
+
+// Rows [i0, i1) and columns [j0, j1) of the product of a and b into c. The
+// slice of B for each step of K is packed once and used for all the rows,
+// which are packed MC at a time.
+template <typename T, typename AccT, int S>
+void gemm_block(
+    const Problem<T, AccT>& p,
+    const T* a,
+    const T* b,
+    T* c,
+    int i0,
+    int i1,
+    int j0,
+    int j1) {
+  constexpr int nr = NR<S>;
+  thread_local std::vector<AccT> a_buffer;
+  thread_local std::vector<AccT> b_buffer;
+  thread_local std::vector<AccT> c_buffer;
+  int m_panels = (i1 - i0 + MR - 1) / MR;
+  int n_panels = (j1 - j0 + nr - 1) / nr;
+  AccT* a_packed = scratch(a_buffer, size_t(MC) * KC);
+  AccT* tiles = scratch(c_buffer, size_t(m_panels) * n_panels * MR * nr);
+  auto tile = [&](int ip, int jp) {
+    return tiles + (size_t(ip) * n_panels + jp) * MR * nr;
+  };
+
+  for (int k0 = 0; k0 < p.K; k0 += KC) {
+    int kc = std::min(KC, p.K - k0);
+
+    // Panels of the shared B hold all of K
+    const AccT* b_packed;
+    size_t b_panel_stride;
+    if (p.packed_b) {
+      b_packed = p.packed_b + size_t(j0) * p.K + size_t(k0) * nr;
+      b_panel_stride = size_t(p.K) * nr;
+    } else {
+      auto* packed = scratch(b_buffer, size_t(n_panels) * nr * KC);
+      pack_b(b, packed, p.b_transposed, p.ldb, nr, j0, j1, k0, kc);
+      b_packed = packed;
+      b_panel_stride = size_t(kc) * nr;
+    }
+
+    for (int m0 = i0; m0 < i1; m0 += MC) {
+      int m1 = std::min(m0 + MC, i1);
+      pack_a(a, a_packed, p.a_transposed, p.lda, m0, m1, k0, kc);
+      int ip0 = (m0 - i0) / MR;
+      for (int jp = 0; jp < n_panels; jp++) {
+        for (int ip = 0; ip < (m1 - m0 + MR - 1) / MR; ip++) {
+          micro_kernel<AccT, S>(
+              a_packed + size_t(ip) * kc * MR,
+              b_packed + jp * b_panel_stride,
+              kc,
+              tile(ip0 + ip, jp),
+              k0 > 0);
+        }
+      }
+    }
+  }
+
+  for (int ip = 0; ip < m_panels; ip++) {
+    for (int jp = 0; jp < n_panels; jp++) {
+      int i = i0 + ip * MR;
+      int j = j0 + jp * nr;
+      store_tile(
+          tile(ip, jp),
+          nr,
+          c + i * p.ldc + j,
+          p.ldc,
+          std::min(MR, i1 - i),
+          std::min(nr, j1 - j),
+          p.alpha,
+          p.beta);
+    }
+  }
+}
+
+// Products with only a few rows of A are bound by reading B, so B is read in
+// place rather than packed
+constexpr int small_m = 8;
+
+// C[i, j] for R rows of A from i0 and the columns [j0, j1), as dot products
+// of the rows of A with the rows of a transposed B
+template <typename T, typename AccT, int S, int R>
+void dot_rows(
+    const Problem<T, AccT>& p,
+    const T* a,
+    const T* b,
+    T* c,
+    int i0,
+    int j0,
+    int j1) {
+  for (int j = j0; j < j1; j++) {
+    const T* b_row = b + j * p.ldb;
+    simd::Simd<AccT, S> acc[R];
+    for (int r = 0; r < R; r++) {
+      acc[r] = AccT(0);
+    }
+    int k = 0;
+    for (; k + S <= p.K; k += S) {
+      simd::Simd<AccT, S> bv = simd::load<T, S>(b_row + k);
+#pragma GCC unroll 8
+      for (int r = 0; r < R; r++) {
+        simd::Simd<AccT, S> av = simd::load<T, S>(a + (i0 + r) * p.lda + k);
+        acc[r] = simd::fma(av, bv, acc[r]);
+      }
+    }
+    for (int r = 0; r < R; r++) {
+      const T* a_row = a + (i0 + r) * p.lda;
+      AccT sum = simd::sum(acc[r]);
+      for (int kk = k; kk < p.K; kk++) {
+        sum += static_cast<AccT>(a_row[kk]) * static_cast<AccT>(b_row[kk]);
+      }
+      store_tile(
+          &sum, 1, c + (i0 + r) * p.ldc + j, p.ldc, 1, 1, p.alpha, p.beta);
+    }
+  }
+}
+
+// C[i, j] for R rows of A from i0 and the columns [j0, j1) of a B stored
+// row by row, in R x NR tiles
+template <typename T, typename AccT, int S, int R>
+void axpy_rows(
+    const Problem<T, AccT>& p,
+    const T* a,
+    const T* b,
+    T* c,
+    int i0,
+    int j0,
+    int j1) {
+  constexpr int nr = NR<S>;
+  auto a_at = [&](int i, int k) {
+    auto idx = p.a_transposed ? k * p.lda + i : i * p.lda + k;
+    return static_cast<AccT>(a[idx]);
+  };
+  int j = j0;
+  for (; j + nr <= j1; j += nr) {
+    simd::Simd<AccT, S> acc[R][2];
+    for (int r = 0; r < R; r++) {
+      acc[r][0] = acc[r][1] = AccT(0);
+    }
+    for (int k = 0; k < p.K; k++) {
+      simd::Simd<AccT, S> b0 = simd::load<T, S>(b + k * p.ldb + j);
+      simd::Simd<AccT, S> b1 = simd::load<T, S>(b + k * p.ldb + j + S);
+#pragma GCC unroll 8
+      for (int r = 0; r < R; r++) {
+        simd::Simd<AccT, S> av(a_at(i0 + r, k));
+        acc[r][0] = simd::fma(av, b0, acc[r][0]);
+        acc[r][1] = simd::fma(av, b1, acc[r][1]);
+      }
+    }
+    AccT tile[R * nr];
+    for (int r = 0; r < R; r++) {
+      simd::store(tile + r * nr, acc[r][0]);
+      simd::store(tile + r * nr + S, acc[r][1]);
+    }
+    store_tile(tile, nr, c + i0 * p.ldc + j, p.ldc, R, nr, p.alpha, p.beta);
+  }
+  for (; j < j1; j++) {
+    for (int r = 0; r < R; r++) {
+      AccT sum = 0;
+      for (int k = 0; k < p.K; k++) {
+        sum += a_at(i0 + r, k) * static_cast<AccT>(b[k * p.ldb + j]);
+      }
+      store_tile(
+          &sum, 1, c + (i0 + r) * p.ldc + j, p.ldc, 1, 1, p.alpha, p.beta);
+    }
+  }
+}
+
+// All rows and the columns [j0, j1) of a product with fewer than small_m
+// rows
+template <typename T, typename AccT, int S>
+void small_m_block(
+    const Problem<T, AccT>& p,
+    const T* a,
+    const T* b,
+    T* c,
+    int j0,
+    int j1) {
+  auto rows = [&](auto r, int i0) {
+    constexpr int R = decltype(r)::value;
+    if (p.b_transposed) {
+      dot_rows<T, AccT, S, R>(p, a, b, c, i0, j0, j1);
+    } else {
+      axpy_rows<T, AccT, S, R>(p, a, b, c, i0, j0, j1);
+    }
+  };
+  int i0 = 0;
+  for (; i0 + 4 <= p.M; i0 += 4) {
+    rows(std::integral_constant<int, 4>{}, i0);
+  }
+  switch (p.M - i0) {
+    case 3:
+      rows(std::integral_constant<int, 3>{}, i0);
+      break;
+    case 2:
+      rows(std::integral_constant<int, 2>{}, i0);
+      break;
+    case 1:
+      rows(std::integral_constant<int, 1>{}, i0);
+      break;
+  }
+}
+
+} // namespace packed_gemm
+
+// Whether a batched product is better served by batched_gemm than by one
+// BLAS call per matrix. Large matrices are left to BLAS, which is faster on
+// them and threads them itself.
+inline bool use_batched_gemm(size_t batch_size, size_t M, size_t N, size_t K) {
+  return batch_size > 1 && M * N * K <= (size_t(1) << 24);
+}
+
+template <typename T, typename AccT>
+void batched_gemm(
+    const T* a,
+    const T* b,
+    T* out,
+    bool a_transposed,
+    bool b_transposed,
+    size_t lda,
+    size_t ldb,
+    size_t ldc,
+    float alpha,
+    float beta,
+    size_t batch_size,
+    const Shape& a_shape,
+    const Strides& a_strides,
+    const Shape& b_shape,
+    const Strides& b_strides) {
+  using namespace packed_gemm;
+  auto ndim = a_shape.size();
+  int M = a_shape[ndim - 2];
+  int N = b_shape[ndim - 1];
+  int K = a_shape[ndim - 1];
+  int n_blocks = (N + NC - 1) / NC;
+
+  Problem<T, AccT> p{
+      a_transposed,
+      b_transposed,
+      lda,
+      ldb,
+      ldc,
+      M,
+      N,
+      K,
+      alpha,
+      beta,
+      nullptr};
+  auto a_at = [&](int64_t i) {
+    return a + elem_to_loc(int64_t(M) * K * i, a_shape, a_strides);
+  };
+  auto b_at = [&](int64_t i) {
+    return b + elem_to_loc(int64_t(K) * N * i, b_shape, b_strides);
+  };
+
+  // A transposed A is only read in place by the axpy kernel
+  if (M < small_m && !(a_transposed && b_transposed)) {
+    auto grain = cpu::row_grain(int64_t(M) * std::min(N, NC) * K);
+    cpu::parallel_for(
+        batch_size * n_blocks, grain, [&](int64_t begin, int64_t end) {
+          simd::dispatch<T, AccT>([&](auto n) {
+            constexpr int S = decltype(n)::value;
+            for (int64_t t = begin; t < end; t++) {
+              int64_t i = t / n_blocks;
+              int j0 = (t % n_blocks) * NC;
+              small_m_block<T, AccT, S>(
+                  p,
+                  a_at(i),
+                  b_at(i),
+                  out + int64_t(M) * N * i,
+                  j0,
+                  std::min(j0 + NC, N));
+            }
+          });
+        });
+    return;
+  }
+
+  // A task computes NC columns for a chunk of rows and packs its slices of B
+  // once for all of them. The rows are only split into several chunks when
+  // there are too few tasks to keep every thread busy otherwise.
+  int m_blocks = (M + MC - 1) / MC;
+  int64_t col_tasks = int64_t(batch_size) * n_blocks;
+  int64_t splits = (2 * cpu::get_num_threads() + col_tasks - 1) / col_tasks;
+  int chunk = (m_blocks + splits - 1) / splits;
+  chunk = std::clamp(chunk, 1, max_chunk_blocks) * MC;
+  int m_chunks = (M + chunk - 1) / chunk;
+  int64_t chunks = int64_t(m_chunks) * n_blocks;
+
+  // Pack B once when several tasks would otherwise pack it and every matrix
+  // of the batch reads the same one
+  bool shared_b = batch_size * m_chunks > 1 &&
+      size_t(K) * N <= (size_t(1) << 22);
+  for (int i = 0; i < int(ndim) - 2; i++) {
+    shared_b &= b_shape[i] == 1 || b_strides[i] == 0;
+  }
+  std::vector<AccT> b_shared;
+  int shared_nr = 0;
+  if (shared_b) {
+    simd::dispatch<AccT>([&](auto n) { shared_nr = NR<decltype(n)::value>; });
+    int n_panels = (N + shared_nr - 1) / shared_nr;
+    b_shared.resize(size_t(n_panels) * shared_nr * K);
+    auto grain = cpu::row_grain(int64_t(shared_nr) * K);
+    cpu::parallel_for(n_panels, grain, [&](int64_t begin, int64_t end) {
+      pack_b(
+          b,
+          b_shared.data() + begin * shared_nr * K,
+          b_transposed,
+          ldb,
+          shared_nr,
+          begin * shared_nr,
+          std::min<int64_t>(end * shared_nr, N),
+          0,
+          K);
+    });
+    p.packed_b = b_shared.data();
+  }
+
+  auto grain = cpu::row_grain(int64_t(std::min(M, chunk)) * NC * K);
+  cpu::parallel_for(
+      batch_size * chunks, grain, [&](int64_t begin, int64_t end) {
+        simd::dispatch<AccT>([&](auto n) {
+          constexpr int S = decltype(n)::value;
+          auto q = p;
+          if (q.packed_b && shared_nr != NR<S>) {
+            q.packed_b = nullptr;
+          }
+          for (int64_t t = begin; t < end; t++) {
+            int64_t i = t / chunks;
+            int i0 = (t % chunks / n_blocks) * chunk;
+            int j0 = (t % n_blocks) * NC;
+            gemm_block<T, AccT, S>(
+                q,
+                a_at(i),
+                b_at(i),
+                out + int64_t(M) * N * i,
+                i0,
+                std::min(i0 + chunk, M),
+                j0,
+                std::min(j0 + NC, N));
+          }
+        });
+      });
+}
+
+} // namespace mlx::core
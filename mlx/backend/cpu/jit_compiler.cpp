@@ -103,6 +103,22 @@ std::string JitCompiler::build_command(
 #endif
 }
 
+const std::string& JitCompiler::version() {
+  static std::string version_ = []() -> std::string {
+    try {
+#ifdef _MSC_VER
+      return GetVisualStudioInfo().cl_exe;
+#else
+      auto out = exec("g++ --version 2>&1");
+      return out.substr(0, out.find('\n'));
+#endif
+    } catch (const std::exception&) {
+      return "unknown";
+    }
+  }();
+  return version_;
+}
+
 std::string JitCompiler::exec(const std::string& cmd) {
 #ifdef _MSC_VER
   FILE* pipe = _popen(cmd.c_str(), "r");
@@ -15,6 +15,9 @@ class JitCompiler {
 
   // Run a command and get its output.
   static std::string exec(const std::string& cmd);
+
+  // A string identifying the compiler used by build_command.
+  static const std::string& version();
 };
 
 } // namespace mlx::core
@@ -0,0 +1,265 @@
+// Copyright © 2025 Apple Inc.
+
+#include "mlx/backend/cpu/kernel_cache.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iterator>
+#include <random>
+#include <sstream>
+
+#include <fmt/format.h>
+
+#include "mlx/backend/cpu/jit_compiler.h"
+#include "mlx/utils.h"
+#include "mlx/version.h"
+
+namespace fs = std::filesystem;
+
+namespace mlx::core::cpu {
+
+namespace {
+
+uint64_t fnv1a(std::string_view data, uint64_t hash) {
+  for (unsigned char c : data) {
+    hash ^= c;
+    hash *= 0x100000001b3ULL;
+  }
+  return hash;
+}
+
+std::optional<std::string> read_file(const fs::path& path) {
+  std::ifstream f(path, std::ios::binary);
+  if (!f) {
+    return std::nullopt;
+  }
+  return std::string(std::istreambuf_iterator<char>(f), {});
+}
+
+// The checksum of a library is its size and the hash of its contents
+std::optional<std::string> checksum(const fs::path& path) {
+  auto contents = read_file(path);
+  if (!contents) {
+    return std::nullopt;
+  }
+  return fmt::format(
+      "{} {:016x}", contents->size(), fnv1a(*contents, 0xcbf29ce484222325ULL));
+}
+
+// A name for temporary files which no other writer will use
+std::string temp_name(const std::string& key) {
+  static std::random_device rd;
+  static std::mutex mtx;
+  std::lock_guard lk(mtx);
+  return fmt::format("{}.{:08x}{:08x}", key, rd(), rd());
+}
+
+fs::path library_path(const fs::path& dir, const std::string& key) {
+  return dir / ("lib" + key + ".so");
+}
+
+fs::path checksum_path(const fs::path& dir, const std::string& key) {
+  return dir / (key + ".sum");
+}
+
+} // namespace
+
+KernelCache::KernelCache() {
+  if (const char* dir = std::getenv("MLX_CPU_KERNEL_CACHE_DIR"); dir && *dir) {
+    dir_ = dir;
+  } else {
+    dir_ = fs::temp_directory_path() / "mlx" / version() / "cpu";
+  }
+  auto max_mb = env::get_var("MLX_CPU_KERNEL_CACHE_SIZE_MB", 1024);
+  if (max_mb < 0) {
+    throw std::invalid_argument(fmt::format(
+        "[KernelCache] MLX_CPU_KERNEL_CACHE_SIZE_MB must be non-negative "
+        "but got {}.",
+        max_mb));
+  }
+  max_bytes_ = static_cast<size_t>(max_mb) << 20;
+  if (const char* path = std::getenv("MLX_CPU_KERNEL_RECORD"); path) {
+    record_path_ = path;
+  }
+}
+
+std::string KernelCache::key(const std::string& source) const {
+  // The command fixes the compiler flags, the version fixes the compiler
+  auto command = JitCompiler::build_command("", "kernel.cpp", "kernel.so");
+  auto& compiler = JitCompiler::version();
+  uint64_t h1 = 0xcbf29ce484222325ULL;
+  uint64_t h2 = 0x84222325cbf29ce4ULL;
+  for (auto part : {std::string_view(source), std::string_view(command)}) {
+    h1 = fnv1a(part, h1);
+    h2 = fnv1a(part, h2);
+  }
+  h1 = fnv1a(compiler, h1);
+  h2 = fnv1a(compiler, h2);
+  return fmt::format("{:016x}{:016x}", h1, h2);
+}
+
+std::optional<fs::path> KernelCache::find(const std::string& key) {
+  auto lib = library_path(dir_, key);
+  auto expected = read_file(checksum_path(dir_, key));
+  if (!expected) {
+    return std::nullopt;
+  }
+  // A mismatch is a library being replaced or a corrupt one, either way it
+  // is rebuilt
+  auto actual = checksum(lib);
+  if (!actual || *actual != *expected) {
+    return std::nullopt;
+  }
+  // Mark as recently used, the cache may be read only
+  std::error_code ec;
+  fs::last_write_time(lib, fs::file_time_type::clock::now(), ec);
+  return lib;
+}
+
+fs::path KernelCache::build(const std::string& key, const std::string& source) {
+  std::error_code ec;
+  fs::create_directories(dir_, ec);
+
+  // Build into temporary files and move them into place once complete
+  auto tmp = temp_name(key);
+  auto source_file_name = tmp + ".cpp";
+  auto tmp_lib = library_path(dir_, tmp);
+  auto tmp_sum = checksum_path(dir_, tmp);
+  {
+    std::ofstream f(dir_ / source_file_name);
+    f << source;
+  }
+  try {
+    JitCompiler::exec(JitCompiler::build_command(
+        dir_, source_file_name, tmp_lib.filename().string()));
+  } catch (const std::exception&) {
+    fs::remove(dir_ / source_file_name, ec);
+    fs::remove(tmp_lib, ec);
+    throw;
+  }
+  fs::remove(dir_ / source_file_name, ec);
+
+  auto sum = checksum(tmp_lib);
+  if (!sum) {
+    throw std::runtime_error(
+        "Could not read compiled library " + tmp_lib.string());
+  }
+  {
+    std::ofstream f(tmp_sum, std::ios::binary);
+    f << *sum;
+  }
+  auto lib = library_path(dir_, key);
+  fs::rename(tmp_lib, lib);
+  fs::rename(tmp_sum, checksum_path(dir_, key));
+
+  evict(key);
+  return lib;
+}
+
+void KernelCache::evict(const std::string& keep) {
+  struct Entry {
+    fs::file_time_type time;
+    size_t size;
+    std::string key;
+  };
+  std::vector<Entry> entries;
+  size_t total = 0;
+  std::error_code ec;
+  // Temporary files this old belong to a build that was killed, a running
+  // build finishes long before
+  auto stale = fs::file_time_type::clock::now() - std::chrono::hours(1);
+  for (auto& file : fs::directory_iterator(dir_, ec)) {
+    auto name = file.path().filename().string();
+    auto dot = name.find('.');
+    if (dot == std::string::npos) {
+      continue;
+    }
+    // Temporary files have a second dot after the key
+    if (name.find('.', dot + 1) != std::string::npos) {
+      auto time = file.last_write_time(ec);
+      if (!ec && time < stale) {
+        fs::remove(file.path(), ec);
+      }
+      continue;
+    }
+    if (max_bytes_ == 0 || name.size() <= 6 || name.compare(0, 3, "lib") != 0 ||
+        name.compare(name.size() - 3, 3, ".so") != 0) {
+      continue;
+    }
+    auto size = file.file_size(ec);
+    auto time = file.last_write_time(ec);
+    if (ec) {
+      continue;
+    }
+    total += size;
+    entries.push_back({time, size, name.substr(3, name.size() - 6)});
+  }
+  if (max_bytes_ == 0 || total <= max_bytes_) {
+    return;
+  }
+  std::sort(entries.begin(), entries.end(), [](auto& a, auto& b) {
+    return a.time < b.time;
+  });
+  for (auto& e : entries) {
+    if (total <= max_bytes_) {
+      break;
+    }
+    if (e.key == keep) {
+      continue;
+    }
+    fs::remove(checksum_path(dir_, e.key), ec);
+    fs::remove(library_path(dir_, e.key), ec);
+    total -= e.size;
+  }
+}
+
+void KernelCache::record(
+    const std::string& kernel_name,
+    const std::string& source) {
+  std::lock_guard lk(record_mtx_);
+  if (record_path_.empty() || !recorded_.insert(kernel_name).second) {
+    return;
+  }
+  std::ofstream f(record_path_, std::ios::app | std::ios::binary);
+  f << kernel_name << "\n" << source.size() << "\n" << source;
+}
+
+void KernelCache::set_record_path(const std::string& path) {
+  std::lock_guard lk(record_mtx_);
+  record_path_ = path;
+  recorded_.clear();
+}
+
+std::vector<std::pair<std::string, std::string>> KernelCache::read_recording(
+    const std::string& path) {
+  std::ifstream f(path, std::ios::binary);
+  if (!f) {
+    throw std::runtime_error(
+        "[prewarm_cpu_kernels] Failed to open kernel recording " + path);
+  }
+  std::vector<std::pair<std::string, std::string>> kernels;
+  std::string name;
+  std::string size;
+  while (std::getline(f, name)) {
+    if (name.empty()) {
+      continue;
+    }
+    size_t n = 0;
+    if (!std::getline(f, size) || !(std::istringstream(size) >> n) ||
+        n == 0) {
+      throw std::runtime_error(
+          "[prewarm_cpu_kernels] Invalid kernel recording " + path);
+    }
+    std::string source(n, '\0');
+    if (!f.read(source.data(), n)) {
+      throw std::runtime_error(
+          "[prewarm_cpu_kernels] Invalid kernel recording " + path);
+    }
+    kernels.emplace_back(std::move(name), std::move(source));
+  }
+  return kernels;
+}
+
+} // namespace mlx::core::cpu
@@ -0,0 +1,68 @@
+// Copyright © 2025 Apple Inc.
+#pragma once
+
+#include <filesystem>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+namespace mlx::core::cpu {
+
+// On-disk cache of compiled kernel libraries.
+//
+// Libraries are addressed by a hash of the kernel source, the compiler and
+// the compile command so processes, and images built ahead of time, can share
+// them safely. Each library has a checksum file next to it. Both are written
+// to temporary files and renamed into place, so a reader never sees a partial
+// library. When the cache grows past its size limit the least recently used
+// libraries are removed.
+//
+// The directory defaults to temp_directory_path()/mlx/<version>/cpu and can
+// be set with MLX_CPU_KERNEL_CACHE_DIR. The size limit in megabytes is set
+// with MLX_CPU_KERNEL_CACHE_SIZE_MB, 0 means unlimited. Temporary files left
+// behind by processes that died mid build are removed after an hour.
+class KernelCache {
+ public:
+  KernelCache();
+
+  const std::filesystem::path& directory() const {
+    return dir_;
+  }
+
+  // The cache key of a kernel source.
+  std::string key(const std::string& source) const;
+
+  // Return the path to the library for key if it is in the cache and intact.
+  std::optional<std::filesystem::path> find(const std::string& key);
+
+  // Compile the source and add the library to the cache. Returns the path
+  // to the library.
+  std::filesystem::path build(
+      const std::string& key,
+      const std::string& source);
+
+  // Append a kernel to the recording file if recording is enabled.
+  void record(const std::string& kernel_name, const std::string& source);
+
+  // Record the kernels built from now on to path, stop if path is empty.
+  void set_record_path(const std::string& path);
+
+  // Read the names and sources of the kernels in a recording.
+  static std::vector<std::pair<std::string, std::string>> read_recording(
+      const std::string& path);
+
+ private:
+  void evict(const std::string& keep);
+
+  std::filesystem::path dir_;
+  size_t max_bytes_;
+
+  std::mutex record_mtx_;
+  std::string record_path_;
+  std::unordered_set<std::string> recorded_;
+};
+
+} // namespace mlx::core::cpu
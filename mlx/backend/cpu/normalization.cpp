@@ -0,0 +1,619 @@
+// Copyright © 2025 Apple Inc.
+
+#include <cassert>
+#include <cmath>
+#include <memory>
+
+#include "mlx/backend/cpu/copy.h"
+#include "mlx/backend/cpu/encoder.h"
+#include "mlx/backend/cpu/parallel.h"
+#include "mlx/backend/cpu/simd/simd.h"
+#include "mlx/fast_primitives.h"
+
+namespace mlx::core::fast {
+
+namespace {
+
+using namespace mlx::core::simd;
+
+// Make sure that the rows of x are contiguous and set out to match x, reusing
+// the buffer of x when possible.
+array prepare_input(const array& x, array& out, Stream s) {
+  bool no_copy = x.flags().contiguous && x.strides()[x.ndim() - 1] == 1;
+  if (no_copy && x.ndim() > 1) {
+    auto stride = x.strides()[x.ndim() - 2];
+    no_copy &= (stride == 0 || stride == x.shape().back() || x.shape(-2) == 1);
+  }
+  if (no_copy) {
+    if (x.is_donatable()) {
+      out.copy_shared_buffer(x);
+    } else {
+      out.set_data(
+          allocator::malloc(x.data_size() * x.itemsize()),
+          x.data_size(),
+          x.strides(),
+          x.flags());
+    }
+    return x;
+  } else {
+    array x_copy = contiguous_copy_cpu(x, s);
+    out.copy_shared_buffer(x_copy);
+    return x_copy;
+  }
+}
+
+array ensure_row_contiguous(const array& x, Stream s) {
+  if (x.flags().row_contiguous) {
+    return x;
+  }
+  array x_copy = contiguous_copy_cpu(x, s);
+  cpu::get_command_encoder(s).add_temporary(x_copy);
+  return x_copy;
+}
+
+// Load n elements starting at x as a vector of accumulators
+template <typename T, typename AccT, int N>
+Simd<AccT, N> load_acc(const T* x) {
+  return Simd<AccT, N>(load<T, N>(x));
+}
+
+template <typename T, typename AccT>
+AccT row_sum_squares(const T* x, int axis_size) {
+  constexpr int N = std::min(max_size<AccT>, max_size<T>);
+  Simd<AccT, N> acc(0);
+  int i = 0;
+  for (; i + N <= axis_size; i += N) {
+    auto v = load_acc<T, AccT, N>(x + i);
+    acc = acc + v * v;
+  }
+  AccT total = sum(acc);
+  for (; i < axis_size; i++) {
+    AccT v = static_cast<AccT>(x[i]);
+    total += v * v;
+  }
+  return total;
+}
+
+template <typename T, typename AccT>
+AccT row_sum(const T* x, int axis_size) {
+  constexpr int N = std::min(max_size<AccT>, max_size<T>);
+  Simd<AccT, N> acc(0);
+  int i = 0;
+  for (; i + N <= axis_size; i += N) {
+    acc = acc + load_acc<T, AccT, N>(x + i);
+  }
+  AccT total = sum(acc);
+  for (; i < axis_size; i++) {
+    total += static_cast<AccT>(x[i]);
+  }
+  return total;
+}
+
+template <typename T, typename AccT>
+AccT row_centered_sum_squares(const T* x, AccT mean, int axis_size) {
+  constexpr int N = std::min(max_size<AccT>, max_size<T>);
+  Simd<AccT, N> acc(0);
+  int i = 0;
+  for (; i + N <= axis_size; i += N) {
+    auto v = load_acc<T, AccT, N>(x + i) - mean;
+    acc = acc + v * v;
+  }
+  AccT total = sum(acc);
+  for (; i < axis_size; i++) {
+    AccT v = static_cast<AccT>(x[i]) - mean;
+    total += v * v;
+  }
+  return total;
+}
+
+template <typename T>
+void rms_norm(
+    const array& x,
+    const array& w,
+    array& out,
+    float eps,
+    Stream s) {
+  auto& encoder = cpu::get_command_encoder(s);
+  using AccT = std::conditional_t<std::is_same_v<T, double>, double, float>;
+  int axis_size = x.shape().back();
+  int64_t n_rows = axis_size > 0 ? x.data_size() / axis_size : 0;
+  bool has_w = w.ndim() != 0;
+
+  encoder.dispatch([x_ptr = x.data<T>(),
+                    w_ptr = w.data<T>(),
+                    out_ptr = out.data<T>(),
+                    axis_size,
+                    n_rows,
+                    has_w,
+                    eps]() {
+    constexpr int N = std::min(max_size<AccT>, max_size<T>);
+    cpu::parallel_for(
+        n_rows, cpu::row_grain(axis_size), [&](int64_t begin, int64_t end) {
+          for (int64_t r = begin; r < end; r++) {
+            const T* x = x_ptr + r * axis_size;
+            T* y = out_ptr + r * axis_size;
+            AccT n = 1 /
+                std::sqrt(row_sum_squares<T, AccT>(x, axis_size) / axis_size +
+                          eps);
+            int i = 0;
+            for (; i + N <= axis_size; i += N) {
+              Simd<T, N> v = load_acc<T, AccT, N>(x + i) * n;
+              if (has_w) {
+                v = v * load<T, N>(w_ptr + i);
+              }
+              store(y + i, v);
+            }
+            for (; i < axis_size; i++) {
+              T v = static_cast<T>(static_cast<AccT>(x[i]) * n);
+              y[i] = has_w ? static_cast<T>(v * w_ptr[i]) : v;
+            }
+          }
+        });
+  });
+}
+
+template <typename T>
+void layer_norm(
+    const array& x,
+    const array& w,
+    const array& b,
+    array& out,
+    float eps,
+    Stream s) {
+  auto& encoder = cpu::get_command_encoder(s);
+  using AccT = std::conditional_t<std::is_same_v<T, double>, double, float>;
+  int axis_size = x.shape().back();
+  int64_t n_rows = axis_size > 0 ? x.data_size() / axis_size : 0;
+  bool has_w = w.ndim() != 0;
+  bool has_b = b.ndim() != 0;
+
+  encoder.dispatch([x_ptr = x.data<T>(),
+                    w_ptr = w.data<T>(),
+                    b_ptr = b.data<T>(),
+                    out_ptr = out.data<T>(),
+                    axis_size,
+                    n_rows,
+                    has_w,
+                    has_b,
+                    eps]() {
+    constexpr int N = std::min(max_size<AccT>, max_size<T>);
+    cpu::parallel_for(
+        n_rows, cpu::row_grain(axis_size), [&](int64_t begin, int64_t end) {
+          for (int64_t r = begin; r < end; r++) {
+            const T* x = x_ptr + r * axis_size;
+            T* y = out_ptr + r * axis_size;
+            AccT mean = row_sum<T, AccT>(x, axis_size) / axis_size;
+            AccT var =
+                row_centered_sum_squares<T, AccT>(x, mean, axis_size) /
+                axis_size;
+            AccT n = 1 / std::sqrt(var + eps);
+            int i = 0;
+            for (; i + N <= axis_size; i += N) {
+              Simd<T, N> v = (load_acc<T, AccT, N>(x + i) - mean) * n;
+              if (has_w) {
+                v = v * load<T, N>(w_ptr + i);
+              }
+              if (has_b) {
+                v = v + load<T, N>(b_ptr + i);
+              }
+              store(y + i, v);
+            }
+            for (; i < axis_size; i++) {
+              T v = static_cast<T>((static_cast<AccT>(x[i]) - mean) * n);
+              if (has_w) {
+                v = static_cast<T>(v * w_ptr[i]);
+              }
+              if (has_b) {
+                v = static_cast<T>(v + b_ptr[i]);
+              }
+              y[i] = v;
+            }
+          }
+        });
+  });
+}
+
+// The weight gradients are accumulated in at most this many row blocks and
+// then summed in block order so that the result does not depend on the number
+// of threads.
+constexpr int64_t max_vjp_blocks = 64;
+
+int64_t vjp_block_rows(int64_t n_rows) {
+  return std::max<int64_t>((n_rows + max_vjp_blocks - 1) / max_vjp_blocks, 1);
+}
+
+template <typename T, typename AccT>
+void sum_partials(const AccT* partials, T* out, int64_t n_blocks, int size) {
+  cpu::parallel_for(size, [&](int64_t begin, int64_t end) {
+    for (int64_t i = begin; i < end; i++) {
+      AccT acc = 0;
+      for (int64_t b = 0; b < n_blocks; b++) {
+        acc += partials[b * size + i];
+      }
+      out[i] = static_cast<T>(acc);
+    }
+  });
+}
+
+template <typename T>
+void rms_norm_vjp(
+    const array& x,
+    const array& w,
+    const array& g,
+    array& gx,
+    array& gw,
+    float eps,
+    Stream s) {
+  auto& encoder = cpu::get_command_encoder(s);
+  using AccT = std::conditional_t<std::is_same_v<T, double>, double, float>;
+  int axis_size = x.shape().back();
+  int64_t n_rows = axis_size > 0 ? x.size() / axis_size : 0;
+  bool has_w = w.ndim() != 0;
+
+  encoder.dispatch([x_ptr = x.data<T>(),
+                    w_ptr = w.data<T>(),
+                    g_ptr = g.data<T>(),
+                    gx_ptr = gx.data<T>(),
+                    gw_ptr = gw.data<T>(),
+                    axis_size,
+                    n_rows,
+                    has_w,
+                    eps]() {
+    constexpr int N = std::min(max_size<AccT>, max_size<T>);
+    int64_t block_rows = vjp_block_rows(n_rows);
+    int64_t n_blocks = (n_rows + block_rows - 1) / block_rows;
+    int64_t grain = cpu::row_grain(axis_size * block_rows);
+    std::unique_ptr<AccT[]> partials;
+    if (has_w) {
+      partials = std::make_unique<AccT[]>(n_blocks * axis_size);
+    }
+
+    cpu::parallel_for(n_blocks, grain, [&](int64_t bb, int64_t be) {
+      for (int64_t blk = bb; blk < be; blk++) {
+        AccT* gw_acc = has_w ? partials.get() + blk * axis_size : nullptr;
+        if (has_w) {
+          std::fill_n(gw_acc, axis_size, AccT(0));
+        }
+        int64_t r_end = std::min(n_rows, (blk + 1) * block_rows);
+        for (int64_t r = blk * block_rows; r < r_end; r++) {
+          const T* x = x_ptr + r * axis_size;
+          const T* g = g_ptr + r * axis_size;
+          T* y = gx_ptr + r * axis_size;
+
+          // n = 1 / sqrt(mean(x^2) + eps) and the mean of g * w * x
+          Simd<AccT, N> vx2(0);
+          Simd<AccT, N> vgwx(0);
+          int i = 0;
+          for (; i + N <= axis_size; i += N) {
+            auto xi = load_acc<T, AccT, N>(x + i);
+            auto gwi = load_acc<T, AccT, N>(g + i);
+            if (has_w) {
+              gwi = gwi * load_acc<T, AccT, N>(w_ptr + i);
+            }
+            vx2 = vx2 + xi * xi;
+            vgwx = vgwx + gwi * xi;
+          }
+          AccT sumx2 = sum(vx2);
+          AccT sumgwx = sum(vgwx);
+          for (; i < axis_size; i++) {
+            AccT xi = static_cast<AccT>(x[i]);
+            AccT gwi = static_cast<AccT>(g[i]) *
+                (has_w ? static_cast<AccT>(w_ptr[i]) : AccT(1));
+            sumx2 += xi * xi;
+            sumgwx += gwi * xi;
+          }
+          AccT n = 1 / std::sqrt(sumx2 / axis_size + eps);
+          AccT t = sumgwx / axis_size * n * n * n;
+
+          i = 0;
+          for (; i + N <= axis_size; i += N) {
+            auto xi = load_acc<T, AccT, N>(x + i);
+            auto gi = load_acc<T, AccT, N>(g + i);
+            auto gwi = gi;
+            if (has_w) {
+              gwi = gi * load_acc<T, AccT, N>(w_ptr + i);
+            }
+            store(y + i, Simd<T, N>(gwi * n - xi * t));
+            if (has_w) {
+              store(gw_acc + i, load<AccT, N>(gw_acc + i) + gi * xi * n);
+            }
+          }
+          for (; i < axis_size; i++) {
+            AccT xi = static_cast<AccT>(x[i]);
+            AccT gi = static_cast<AccT>(g[i]);
+            AccT gwi = gi * (has_w ? static_cast<AccT>(w_ptr[i]) : AccT(1));
+            y[i] = static_cast<T>(gwi * n - xi * t);
+            if (has_w) {
+              gw_acc[i] += gi * xi * n;
+            }
+          }
+        }
+      }
+    });
+
+    if (has_w) {
+      sum_partials(partials.get(), gw_ptr, n_blocks, axis_size);
+    } else {
+      gw_ptr[0] = T(0);
+    }
+  });
+}
+
+template <typename T>
+void layer_norm_vjp(
+    const array& x,
+    const array& w,
+    const array& b,
+    const array& g,
+    array& gx,
+    array& gw,
+    array& gb,
+    float eps,
+    Stream s) {
+  auto& encoder = cpu::get_command_encoder(s);
+  using AccT = std::conditional_t<std::is_same_v<T, double>, double, float>;
+  int axis_size = x.shape().back();
+  int64_t n_rows = axis_size > 0 ? x.size() / axis_size : 0;
+  bool has_w = w.ndim() != 0;
+  bool has_b = b.ndim() != 0;
+
+  encoder.dispatch([x_ptr = x.data<T>(),
+                    w_ptr = w.data<T>(),
+                    g_ptr = g.data<T>(),
+                    gx_ptr = gx.data<T>(),
+                    gw_ptr = gw.data<T>(),
+                    gb_ptr = gb.data<T>(),
+                    axis_size,
+                    n_rows,
+                    has_w,
+                    has_b,
+                    eps]() {
+    constexpr int N = std::min(max_size<AccT>, max_size<T>);
+    int64_t block_rows = vjp_block_rows(n_rows);
+    int64_t n_blocks = (n_rows + block_rows - 1) / block_rows;
+    int64_t grain = cpu::row_grain(axis_size * block_rows);
+    std::unique_ptr<AccT[]> w_partials;
+    std::unique_ptr<AccT[]> b_partials;
+    if (has_w) {
+      w_partials = std::make_unique<AccT[]>(n_blocks * axis_size);
+    }
+    if (has_b) {
+      b_partials = std::make_unique<AccT[]>(n_blocks * axis_size);
+    }
+
+    cpu::parallel_for(n_blocks, grain, [&](int64_t bb, int64_t be) {
+      for (int64_t blk = bb; blk < be; blk++) {
+        AccT* gw_acc = has_w ? w_partials.get() + blk * axis_size : nullptr;
+        AccT* gb_acc = has_b ? b_partials.get() + blk * axis_size : nullptr;
+        if (has_w) {
+          std::fill_n(gw_acc, axis_size, AccT(0));
+        }
+        if (has_b) {
+          std::fill_n(gb_acc, axis_size, AccT(0));
+        }
+        int64_t r_end = std::min(n_rows, (blk + 1) * block_rows);
+        for (int64_t r = blk * block_rows; r < r_end; r++) {
+          const T* x = x_ptr + r * axis_size;
+          const T* g = g_ptr + r * axis_size;
+          T* y = gx_ptr + r * axis_size;
+
+          AccT mean = row_sum<T, AccT>(x, axis_size) / axis_size;
+          AccT var =
+              row_centered_sum_squares<T, AccT>(x, mean, axis_size) /
+              axis_size;
+          AccT n = 1 / std::sqrt(var + eps);
+
+          // The means of w * g and w * g * (x - mean)
+          Simd<AccT, N> vwg(0);
+          Simd<AccT, N> vwgxc(0);
+          int i = 0;
+          for (; i + N <= axis_size; i += N) {
+            auto wgi = load_acc<T, AccT, N>(g + i);
+            if (has_w) {
+              wgi = wgi * load_acc<T, AccT, N>(w_ptr + i);
+            }
+            vwg = vwg + wgi;
+            vwgxc = vwgxc + wgi * (load_acc<T, AccT, N>(x + i) - mean);
+          }
+          AccT sumwg = sum(vwg);
+          AccT sumwgxc = sum(vwgxc);
+          for (; i < axis_size; i++) {
+            AccT wgi = static_cast<AccT>(g[i]) *
+                (has_w ? static_cast<AccT>(w_ptr[i]) : AccT(1));
+            sumwg += wgi;
+            sumwgxc += wgi * (static_cast<AccT>(x[i]) - mean);
+          }
+          AccT meanwg = sumwg / axis_size;
+          AccT t = sumwgxc / axis_size * n * n * n;
+
+          i = 0;
+          for (; i + N <= axis_size; i += N) {
+            auto xc = load_acc<T, AccT, N>(x + i) - mean;
+            auto gi = load_acc<T, AccT, N>(g + i);
+            auto wgi = gi;
+            if (has_w) {
+              wgi = gi * load_acc<T, AccT, N>(w_ptr + i);
+            }
+            store(y + i, Simd<T, N>((wgi - meanwg) * n - xc * t));
+            if (has_w) {
+              store(gw_acc + i, load<AccT, N>(gw_acc + i) + gi * xc * n);
+            }
+            if (has_b) {
+              store(gb_acc + i, load<AccT, N>(gb_acc + i) + gi);
+            }
+          }
+          for (; i < axis_size; i++) {
+            AccT xc = static_cast<AccT>(x[i]) - mean;
+            AccT gi = static_cast<AccT>(g[i]);
+            AccT wgi = gi * (has_w ? static_cast<AccT>(w_ptr[i]) : AccT(1));
+            y[i] = static_cast<T>((wgi - meanwg) * n - xc * t);
+            if (has_w) {
+              gw_acc[i] += gi * xc * n;
+            }
+            if (has_b) {
+              gb_acc[i] += gi;
+            }
+          }
+        }
+      }
+    });
+
+    if (has_w) {
+      sum_partials(w_partials.get(), gw_ptr, n_blocks, axis_size);
+    } else {
+      gw_ptr[0] = T(0);
+    }
+    if (has_b) {
+      sum_partials(b_partials.get(), gb_ptr, n_blocks, axis_size);
+    } else {
+      gb_ptr[0] = T(0);
+    }
+  });
+}
+
+} // namespace
+
+void RMSNorm::eval_cpu(
+    const std::vector<array>& inputs,
+    std::vector<array>& outputs) {
+  auto& encoder = cpu::get_command_encoder(stream());
+  auto& out = outputs[0];
+  array x = prepare_input(inputs[0], out, stream());
+  array w = inputs[1].ndim() == 0 ? inputs[1]
+                                  : ensure_row_contiguous(inputs[1], stream());
+  encoder.set_input_array(x);
+  encoder.set_input_array(w);
+  encoder.set_output_array(out);
+
+  switch (out.dtype()) {
+    case float32:
+      rms_norm<float>(x, w, out, eps_, stream());
+      break;
+    case float16:
+      rms_norm<float16_t>(x, w, out, eps_, stream());
+      break;
+    case bfloat16:
+      rms_norm<bfloat16_t>(x, w, out, eps_, stream());
+      break;
+    case float64:
+      rms_norm<double>(x, w, out, eps_, stream());
+      break;
+    default:
+      throw std::runtime_error(
+          "[rms_norm] Only defined for floating point types.");
+  }
+}
+
+void RMSNormVJP::eval_cpu(
+    const std::vector<array>& inputs,
+    std::vector<array>& outputs) {
+  auto& encoder = cpu::get_command_encoder(stream());
+  array x = ensure_row_contiguous(inputs[0], stream());
+  array w = inputs[1].ndim() == 0 ? inputs[1]
+                                  : ensure_row_contiguous(inputs[1], stream());
+  array g = ensure_row_contiguous(inputs[2], stream());
+  auto& gx = outputs[0];
+  auto& gw = outputs[1];
+  gx.set_data(allocator::malloc(gx.nbytes()));
+  gw.set_data(allocator::malloc(gw.nbytes()));
+  encoder.set_input_array(x);
+  encoder.set_input_array(w);
+  encoder.set_input_array(g);
+  encoder.set_output_array(gx);
+  encoder.set_output_array(gw);
+
+  switch (gx.dtype()) {
+    case float32:
+      rms_norm_vjp<float>(x, w, g, gx, gw, eps_, stream());
+      break;
+    case float16:
+      rms_norm_vjp<float16_t>(x, w, g, gx, gw, eps_, stream());
+      break;
+    case bfloat16:
+      rms_norm_vjp<bfloat16_t>(x, w, g, gx, gw, eps_, stream());
+      break;
+    case float64:
+      rms_norm_vjp<double>(x, w, g, gx, gw, eps_, stream());
+      break;
+    default:
+      throw std::runtime_error(
+          "[rms_norm] Only defined for floating point types.");
+  }
+}
+
+void LayerNorm::eval_cpu(
+    const std::vector<array>& inputs,
+    std::vector<array>& outputs) {
+  auto& encoder = cpu::get_command_encoder(stream());
+  auto& out = outputs[0];
+  array x = prepare_input(inputs[0], out, stream());
+  array w = inputs[1].ndim() == 0 ? inputs[1]
+                                  : ensure_row_contiguous(inputs[1], stream());
+  array b = inputs[2].ndim() == 0 ? inputs[2]
+                                  : ensure_row_contiguous(inputs[2], stream());
+  encoder.set_input_array(x);
+  encoder.set_input_array(w);
+  encoder.set_input_array(b);
+  encoder.set_output_array(out);
+
+  switch (out.dtype()) {
+    case float32:
+      layer_norm<float>(x, w, b, out, eps_, stream());
+      break;
+    case float16:
+      layer_norm<float16_t>(x, w, b, out, eps_, stream());
+      break;
+    case bfloat16:
+      layer_norm<bfloat16_t>(x, w, b, out, eps_, stream());
+      break;
+    case float64:
+      layer_norm<double>(x, w, b, out, eps_, stream());
+      break;
+    default:
+      throw std::runtime_error(
+          "[layer_norm] Only defined for floating point types.");
+  }
+}
+
+void LayerNormVJP::eval_cpu(
+    const std::vector<array>& inputs,
+    std::vector<array>& outputs) {
+  auto& encoder = cpu::get_command_encoder(stream());
+  array x = ensure_row_contiguous(inputs[0], stream());
+  array w = inputs[1].ndim() == 0 ? inputs[1]
+                                  : ensure_row_contiguous(inputs[1], stream());
+  array b = inputs[2];
+  array g = ensure_row_contiguous(inputs[3], stream());
+  auto& gx = outputs[0];
+  auto& gw = outputs[1];
+  auto& gb = outputs[2];
+  gx.set_data(allocator::malloc(gx.nbytes()));
+  gw.set_data(allocator::malloc(gw.nbytes()));
+  gb.set_data(allocator::malloc(gb.nbytes()));
+  encoder.set_input_array(x);
+  encoder.set_input_array(w);
+  encoder.set_input_array(g);
+  encoder.set_output_array(gx);
+  encoder.set_output_array(gw);
+  encoder.set_output_array(gb);
+
+  switch (gx.dtype()) {
+    case float32:
+      layer_norm_vjp<float>(x, w, b, g, gx, gw, gb, eps_, stream());
+      break;
+    case float16:
+      layer_norm_vjp<float16_t>(x, w, b, g, gx, gw, gb, eps_, stream());
+      break;
+    case bfloat16:
+      layer_norm_vjp<bfloat16_t>(x, w, b, g, gx, gw, gb, eps_, stream());
+      break;
+    case float64:
+      layer_norm_vjp<double>(x, w, b, g, gx, gw, gb, eps_, stream());
+      break;
+    default:
+      throw std::runtime_error(
+          "[layer_norm] Only defined for floating point types.");
+  }
+}
+
+} // namespace mlx::core::fast
@@ -0,0 +1,296 @@
+// Copyright © 2025 Apple Inc.
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <thread>
+#include <vector>
+
+#include "mlx/backend/cpu/parallel.h"
+#include "mlx/utils.h"
+
+namespace mlx::core::cpu {
+
+namespace {
+
+// A pool of worker threads with one task deque per worker. Tasks are ranges
+// of a parallel_for which are split in half until they reach the grain size.
+// Owners push and pop at the back of their deque, idle threads steal the
+// largest pieces from the front of other deques.
+class ComputePool {
+ public:
+  explicit ComputePool(int n_threads) {
+    start(n_threads);
+  }
+
+  ~ComputePool() {
+    stop();
+  }
+
+  ComputePool(const ComputePool&) = delete;
+  ComputePool& operator=(const ComputePool&) = delete;
+
+  int num_threads() const {
+    return n_threads_;
+  }
+
+  void resize(int n_threads) {
+    std::unique_lock lk(resize_mtx_);
+    if (n_threads == n_threads_) {
+      return;
+    }
+    stop();
+    start(n_threads);
+  }
+
+  void parallel_for(
+      int64_t n,
+      int64_t grain,
+      const std::function<void(int64_t, int64_t)>& fn) {
+    // Workers already hold the pool through the outer call
+    std::shared_lock<std::shared_mutex> lk;
+    if (worker_index() < 0) {
+      lk = std::shared_lock(resize_mtx_);
+    }
+
+    Job job{fn, grain};
+    job.remaining = n;
+    run(Task{&job, 0, n});
+
+    // Help with pending work until our own job is done
+    while (job.remaining.load(std::memory_order_acquire) > 0) {
+      Task task;
+      if (pop_or_steal(task)) {
+        run(task);
+      } else {
+        std::this_thread::yield();
+      }
+    }
+
+    if (job.error) {
+      std::rethrow_exception(job.error);
+    }
+  }
+
+ private:
+  struct Job {
+    Job(const std::function<void(int64_t, int64_t)>& fn, int64_t grain)
+        : fn(fn), grain(grain) {}
+    const std::function<void(int64_t, int64_t)>& fn;
+    int64_t grain;
+    std::atomic<int64_t> remaining{0};
+    std::mutex error_mtx;
+    std::exception_ptr error;
+  };
+
+  struct Task {
+    Job* job{nullptr};
+    int64_t begin{0};
+    int64_t end{0};
+  };
+
+  struct Queue {
+    std::mutex mtx;
+    std::deque<Task> tasks;
+  };
+
+  // The index of the queue owned by the current thread or -1 for threads
+  // outside the pool.
+  static int& worker_index() {
+    static thread_local int index = -1;
+    return index;
+  }
+
+  // Threads outside the pool share the last queue.
+  Queue& own_queue() {
+    int idx = worker_index();
+    return *queues_[idx < 0 ? queues_.size() - 1 : idx];
+  }
+
+  void push(const Task& task) {
+    auto& q = own_queue();
+    {
+      std::lock_guard<std::mutex> lk(q.mtx);
+      q.tasks.push_back(task);
+    }
+    n_queued_.fetch_add(1, std::memory_order_release);
+    // Synchronize with a worker that is about to go to sleep
+    { std::lock_guard<std::mutex> lk(sleep_mtx_); }
+    sleep_cv_.notify_one();
+  }
+
+  bool pop_or_steal(Task& task) {
+    if (n_queued_.load(std::memory_order_acquire) == 0) {
+      return false;
+    }
+    {
+      auto& q = own_queue();
+      std::lock_guard<std::mutex> lk(q.mtx);
+      if (!q.tasks.empty()) {
+        task = q.tasks.back();
+        q.tasks.pop_back();
+        n_queued_.fetch_sub(1, std::memory_order_relaxed);
+        return true;
+      }
+    }
+    int n_queues = queues_.size();
+    int start = std::max(worker_index(), 0);
+    for (int i = 1; i <= n_queues; ++i) {
+      auto& q = *queues_[(start + i) % n_queues];
+      std::lock_guard<std::mutex> lk(q.mtx);
+      if (!q.tasks.empty()) {
+        task = q.tasks.front();
+        q.tasks.pop_front();
+        n_queued_.fetch_sub(1, std::memory_order_relaxed);
+        return true;
+      }
+    }
+    return false;
+  }
+
+  void run(Task task) {
+    auto& job = *task.job;
+    while (task.end - task.begin > job.grain) {
+      auto mid = task.begin + (task.end - task.begin) / 2;
+      push(Task{task.job, mid, task.end});
+      task.end = mid;
+    }
+    try {
+      job.fn(task.begin, task.end);
+    } catch (...) {
+      std::lock_guard<std::mutex> lk(job.error_mtx);
+      if (!job.error) {
+        job.error = std::current_exception();
+      }
+    }
+    job.remaining.fetch_sub(task.end - task.begin, std::memory_order_release);
+  }
+
+  void worker_fn(int idx) {
+    worker_index() = idx;
+    while (true) {
+      Task task;
+      if (pop_or_steal(task)) {
+        run(task);
+        continue;
+      }
+      std::unique_lock<std::mutex> lk(sleep_mtx_);
+      sleep_cv_.wait(lk, [this] {
+        return stop_ || n_queued_.load(std::memory_order_acquire) > 0;
+      });
+      if (stop_) {
+        return;
+      }
+    }
+  }
+
+  void start(int n_threads) {
+    n_threads_ = std::max(n_threads, 1);
+    stop_ = false;
+    // One queue per worker plus one shared by outside threads
+    queues_.clear();
+    for (int i = 0; i < n_threads_; ++i) {
+      queues_.push_back(std::make_unique<Queue>());
+    }
+    for (int i = 0; i < n_threads_ - 1; ++i) {
+      workers_.emplace_back(&ComputePool::worker_fn, this, i);
+    }
+  }
+
+  void stop() {
+    {
+      std::lock_guard<std::mutex> lk(sleep_mtx_);
+      stop_ = true;
+    }
+    sleep_cv_.notify_all();
+    for (auto& w : workers_) {
+      w.join();
+    }
+    workers_.clear();
+  }
+
+  int n_threads_{1};
+  bool stop_{false};
+  std::vector<std::thread> workers_;
+  std::vector<std::unique_ptr<Queue>> queues_;
+  std::atomic<int64_t> n_queued_{0};
+  std::mutex sleep_mtx_;
+  std::condition_variable sleep_cv_;
+  std::shared_mutex resize_mtx_;
+};
+
+int default_num_threads() {
+  int n = env::cpu_num_threads();
+  if (n <= 0) {
+    n = std::thread::hardware_concurrency();
+  }
+  return std::max(n, 1);
+}
+
+ComputePool& compute_pool() {
+  // Leaked so that stream threads can still use it during static destruction
+  static ComputePool* pool_ = new ComputePool(default_num_threads());
+  return *pool_;
+}
+
+std::atomic<int64_t>& grain_size() {
+  static std::atomic<int64_t> grain(
+      std::max<int64_t>(env::cpu_grain_size(), 1));
+  return grain;
+}
+
+} // namespace
+
+int get_num_threads() {
+  return compute_pool().num_threads();
+}
+
+int set_num_threads(int n_threads) {
+  if (n_threads < 1) {
+    throw std::invalid_argument(
+        "[set_num_threads] The number of threads must be at least 1.");
+  }
+  auto& pool = compute_pool();
+  int prev = pool.num_threads();
+  pool.resize(n_threads);
+  return prev;
+}
+
+int64_t get_grain_size() {
+  return grain_size().load(std::memory_order_relaxed);
+}
+
+int64_t set_grain_size(int64_t grain) {
+  if (grain < 1) {
+    throw std::invalid_argument(
+        "[set_grain_size] The grain size must be at least 1.");
+  }
+  return grain_size().exchange(grain);
+}
+
+void parallel_for(
+    int64_t n,
+    int64_t grain,
+    const std::function<void(int64_t, int64_t)>& fn) {
+  if (n <= 0) {
+    return;
+  }
+  grain = std::max<int64_t>(grain, 1);
+  if (n <= grain) {
+    fn(0, n);
+    return;
+  }
+  auto& pool = compute_pool();
+  if (pool.num_threads() == 1) {
+    fn(0, n);
+    return;
+  }
+  pool.parallel_for(n, grain, fn);
+}
+
+} // namespace mlx::core::cpu
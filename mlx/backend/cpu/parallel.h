@@ -0,0 +1,62 @@
+// Copyright © 2025 Apple Inc.
+
+#pragma once
+
+#include <cstdint>
+#include <functional>
+
+namespace mlx::core::cpu {
+
+/* Get the number of threads used by the CPU compute pool.
+ *
+ * The count includes the thread that calls parallel_for. It defaults to the
+ * number of hardware threads and can be set with the ``MLX_CPU_NUM_THREADS``
+ * environment variable.
+ * */
+int get_num_threads();
+
+/* Set the number of threads used by the CPU compute pool.
+ *
+ * A value of 1 disables intra-op parallelism. Must not be called while CPU
+ * work is in flight. Returns the previous number of threads.
+ * */
+int set_num_threads(int n_threads);
+
+/* Get the default grain size in elements.
+ *
+ * Kernels do not split work into tasks smaller than this. It can be set with
+ * the ``MLX_CPU_GRAIN_SIZE`` environment variable.
+ * */
+int64_t get_grain_size();
+
+/* Set the default grain size in elements. Returns the previous value. */
+int64_t set_grain_size(int64_t grain);
+
+/* Run fn(begin, end) over disjoint sub-ranges covering [0, n) on the shared
+ * work-stealing compute pool and wait for all of them to complete.
+ *
+ * Ranges are never smaller than grain unless n itself is. The calling thread
+ * takes part in the work. Nested calls from within a task are allowed. The
+ * first exception thrown by fn is rethrown in the caller.
+ * */
+void parallel_for(
+    int64_t n,
+    int64_t grain,
+    const std::function<void(int64_t, int64_t)>& fn);
+
+/* Run fn over [0, n) using the default grain size. */
+inline void parallel_for(
+    int64_t n,
+    const std::function<void(int64_t, int64_t)>& fn) {
+  parallel_for(n, get_grain_size(), fn);
+}
+
+/* The grain in rows for a kernel that does roughly row_cost elements of work
+ * per row. */
+inline int64_t row_grain(int64_t row_cost) {
+  auto cost = row_cost > 0 ? row_cost : 1;
+  auto grain = get_grain_size() / cost;
+  return grain > 0 ? grain : 1;
+}
+
+} // namespace mlx::core::cpu
@@ -2,6 +2,8 @@
 
 #include "mlx/backend/cpu/copy.h"
 #include "mlx/backend/cpu/encoder.h"
+#include "mlx/backend/cpu/parallel.h"
+#include "mlx/backend/cpu/simd/dispatch.h"
 #include "mlx/backend/cpu/simd/simd.h"
 #include "mlx/fast_primitives.h"
 #include "mlx/primitives.h"
@@ -148,7 +150,8 @@ void _qmm_t(
     const T* biases,
     int M,
     int N,
-    int K) {
+    int K,
+    int ldr) {
   constexpr int bitmask = (1 << bits) - 1;
 
   constexpr int pack_factor = get_pack_factor(bits, 8);
@@ -162,7 +165,8 @@ void _qmm_t(
 
     for (int n = 0; n < N; n++) {
       const T* x_local = x;
-      T sum = 0;
+      // Accumulate in float so half precision sums do not lose the small terms
+      float sum = 0;
       for (int k = 0; k < K; k += group_size) {
         T scale = *scales_local++;
         T bias = *biases_local++;
@@ -191,10 +195,11 @@ void _qmm_t(
           }
         }
       }
-      *result = sum;
+      *result = static_cast<T>(sum);
       result++;
     }
 
+    result += ldr - N;
     x += K;
   }
 }
@@ -202,29 +207,21 @@ void _qmm_t(
 template <int bits, int S>
 simd::Simd<uint32_t, S> extract_bits_simd(const uint32_t* w) {
   constexpr int bitmask = (1 << bits) - 1;
-  simd::Simd<uint32_t, S> wi;
-  if constexpr (bits == 4 && S == 8) {
-    constexpr std::array<uint32_t, 8> shifts_ = {{0, 4, 8, 12, 16, 20, 24, 28}};
-    auto shifts(*(simd::Simd<uint32_t, S>*)&shifts_);
-    wi = simd::Simd<uint32_t, S>(*w);
-    wi = wi >> shifts;
-    wi = wi & bitmask;
-  } else if constexpr (bits == 8 && S == 8) {
-    constexpr std::array<uint32_t, 8> shifts_ = {{0, 8, 16, 24, 0, 8, 16, 24}};
-    auto shifts(*(simd::Simd<uint32_t, S>*)&shifts_);
-    auto l = simd::Simd<uint32_t, S / 2>(*w++);
-    auto r = simd::Simd<uint32_t, S / 2>(*w);
-    wi = simd::Simd<uint32_t, S>(l, r);
-    wi = wi >> shifts;
-    wi = wi & bitmask;
-  } else {
-    // Appease compiler.. but should never get here
-    throw std::runtime_error("Unsupported combination for simd qmm.");
+  constexpr int pack_factor = 32 / bits;
+  // Lane i gets the word holding element i and shifts it down. Filling the
+  // lanes from an array compiles to broadcasts and permutes where joining
+  // two narrower vectors went through memory.
+  uint32_t words[S];
+  uint32_t shifts_[S];
+  for (int i = 0; i < S; i++) {
+    words[i] = w[i / pack_factor];
+    shifts_[i] = (i % pack_factor) * bits;
   }
-  return wi;
+  auto wi = simd::load<uint32_t, S>(words) >> simd::load<uint32_t, S>(shifts_);
+  return wi & bitmask;
 }
 
-template <typename T, int bits, int group_size>
+template <typename T, int bits, int group_size, int S>
 void _qmm_t_simd(
     T* result,
     const T* x,
@@ -233,10 +230,10 @@ void _qmm_t_simd(
     const T* biases,
     int M,
     int N,
-    int K) {
+    int K,
+    int ldr) {
   constexpr int pack_factor = 32 / bits;
   constexpr int packs_in_group = group_size / pack_factor;
-  constexpr int S = simd::max_size<T>;
   static_assert(
       S % pack_factor == 0, "SIMD size must be divisible by pack factor");
   constexpr int packs_per_simd = S / pack_factor;
@@ -267,6 +264,60 @@ void _qmm_t_simd(
       *result = T(simd::sum(acc));
       result++;
     }
+    result += ldr - N;
+    x += K;
+  }
+}
+
+// 3, 5 and 6 bit weights straddle bytes so each group is unpacked with
+// extract_bits before it is multiplied in vectors.
+template <typename T, int bits, int group_size, int S>
+void _qmm_t_simd_unpacked(
+    T* result,
+    const T* x,
+    const uint32_t* w,
+    const T* scales,
+    const T* biases,
+    int M,
+    int N,
+    int K,
+    int ldr) {
+  constexpr int pack_factor = get_pack_factor(bits, 8);
+  constexpr int bytes_per_pack = get_bytes_per_pack(bits);
+  static_assert(
+      group_size % S == 0, "Group size must be divisible by SIMD size");
+
+  for (int m = 0; m < M; m++) {
+    const uint8_t* w_local = (const uint8_t*)w;
+    const T* scales_local = scales;
+    const T* biases_local = biases;
+
+    for (int n = 0; n < N; n++) {
+      simd::Simd<float, S> acc(0);
+      auto x_local = x;
+      for (int k = 0; k < K; k += group_size) {
+        T scale = *scales_local++;
+        T bias = *biases_local++;
+
+        float wl[group_size];
+        for (int p = 0; p < group_size; p += pack_factor) {
+          extract_bits<float, bits>(w_local, wl + p);
+          w_local += bytes_per_pack;
+        }
+        for (int i = 0; i < group_size; i += S) {
+          auto wf = simd::load<float, S>(wl + i);
+          wf = wf * scale;
+          wf = wf + bias;
+          simd::Simd<float, S> x_simd = simd::load<T, S>(x_local);
+          acc = acc + x_simd * wf;
+          x_local += S;
+        }
+      }
+
+      *result = T(simd::sum(acc));
+      result++;
+    }
+    result += ldr - N;
     x += K;
   }
 }
@@ -283,12 +334,35 @@ void _qmm_dispatch_transpose(
     int K,
     bool transposed_w) {
   if (transposed_w) {
-    // the simd size must be a multiple of the number of elements per word
-    if constexpr (32 % bits == 0 && simd::max_size<T> % (32 / bits) == 0) {
-      _qmm_t_simd<T, bits, group_size>(result, x, w, scales, biases, M, N, K);
-    } else {
-      _qmm_t<T, bits, group_size>(result, x, w, scales, biases, M, N, K);
-    }
+    // Each output column reads its own row of w, so the columns are split
+    // across the pool and every task computes them for all rows of x.
+    int64_t w_row = int64_t(K) * bits / 32;
+    int64_t g_row = K / group_size;
+    cpu::parallel_for(
+        N, cpu::row_grain(int64_t(M) * K), [&](int64_t n0, int64_t n1) {
+          auto result_n = result + n0;
+          auto w_n = w + n0 * w_row;
+          auto scales_n = scales + n0 * g_row;
+          auto biases_n = biases + n0 * g_row;
+          int N_n = n1 - n0;
+          simd::dispatch<T>([&](auto n) {
+            constexpr int S = decltype(n)::value;
+            // the simd size must be a multiple of the number of elements per
+            // word and must not span more than one group
+            if constexpr (
+                32 % bits == 0 && S >= 8 && S % (32 / bits) == 0 &&
+                S <= group_size) {
+              _qmm_t_simd<T, bits, group_size, S>(
+                  result_n, x, w_n, scales_n, biases_n, M, N_n, K, N);
+            } else if constexpr (32 % bits != 0 && S >= 4) {
+              _qmm_t_simd_unpacked<T, bits, group_size, S>(
+                  result_n, x, w_n, scales_n, biases_n, M, N_n, K, N);
+            } else {
+              _qmm_t<T, bits, group_size>(
+                  result_n, x, w_n, scales_n, biases_n, M, N_n, K, N);
+            }
+          });
+        });
   } else {
     _qmm<T, bits, group_size>(result, x, w, scales, biases, M, N, K);
   }
@@ -307,6 +381,10 @@ void _qmm_dispatch_group(
     int group_size,
     bool transposed_w) {
   switch (group_size) {
+    case 16:
+      _qmm_dispatch_transpose<T, bits, 16>(
+          result, x, w, scales, biases, M, N, K, transposed_w);
+      break;
     case 32:
       _qmm_dispatch_transpose<T, bits, 32>(
           result, x, w, scales, biases, M, N, K, transposed_w);
@@ -321,7 +399,7 @@ void _qmm_dispatch_group(
       break;
     default:
       throw std::invalid_argument(
-          "Quantization group size must be 32, 64 or 128.");
+          "Quantization group size must be 16, 32, 64 or 128.");
   }
 }
 
@@ -521,9 +599,13 @@ void mxfp4_qmm_t(
 
 template <int S>
 simd::Simd<float, S> mxfp4_extract_bits_simd(const uint32_t* w) {
-  if constexpr (S == 8) {
+  if constexpr (S > 8) {
+    return simd::Simd<float, S>(
+        mxfp4_extract_bits_simd<S / 2>(w),
+        mxfp4_extract_bits_simd<S / 2>(w + S / 16));
+  } else if constexpr (S == 8) {
     constexpr std::array<uint32_t, 8> shifts_ = {{0, 4, 8, 12, 16, 20, 24, 28}};
-    auto shifts(*(simd::Simd<uint32_t, S>*)&shifts_);
+    auto shifts = simd::load<uint32_t, S>(shifts_.data());
     auto wi = simd::Simd<uint32_t, S>(*w);
     wi = wi >> shifts;
     wi = wi & 0xf;
@@ -538,7 +620,7 @@ simd::Simd<float, S> mxfp4_extract_bits_simd(const uint32_t* w) {
   }
 }
 
-template <typename T>
+template <typename T, int S>
 void mxfp4_qmm_t_simd(
     T* result,
     const T* x,
@@ -550,7 +632,6 @@ void mxfp4_qmm_t_simd(
   constexpr int group_size = 32;
   constexpr int pack_factor = 32 / 4;
   constexpr int packs_in_group = group_size / pack_factor;
-  constexpr int S = simd::max_size<T>;
   static_assert(
       S % pack_factor == 0, "SIMD size must be divisible by pack factor");
   constexpr int packs_per_simd = S / pack_factor;
@@ -595,12 +676,15 @@ void mxfp4_qmm_dispatch_transpose(
     int K,
     bool transposed_w) {
   if (transposed_w) {
-    // the simd size must be a multiple of the number of elements per word
-    if constexpr (simd::max_size<T> % 8 == 0) {
-      mxfp4_qmm_t_simd<T>(result, x, w, scales, M, N, K);
-    } else {
-      mxfp4_qmm_t<T>(result, x, w, scales, M, N, K);
-    }
+    simd::dispatch<T>([&](auto n) {
+      constexpr int S = decltype(n)::value;
+      // the simd size must be a multiple of the number of elements per word
+      if constexpr (S % 8 == 0) {
+        mxfp4_qmm_t_simd<T, S>(result, x, w, scales, M, N, K);
+      } else {
+        mxfp4_qmm_t<T>(result, x, w, scales, M, N, K);
+      }
+    });
   } else {
     mxfp4_qmm<T>(result, x, w, scales, M, N, K);
   }
@@ -3,9 +3,12 @@
 #include <cassert>
 #include <functional>
 #include <limits>
+#include <memory>
 
 #include "mlx/backend/common/reduce.h"
 #include "mlx/backend/cpu/encoder.h"
+#include "mlx/backend/cpu/parallel.h"
+#include "mlx/backend/cpu/simd/dispatch.h"
 #include "mlx/backend/cpu/simd/simd.h"
 #include "mlx/primitives.h"
 
@@ -75,40 +78,44 @@ void strided_reduce(
     int size,
     size_t stride,
     Op op) {
-  constexpr int N = std::min(simd::max_size<T>, simd::max_size<U>);
-  for (int i = 0; i < size; i++) {
-    U* moving_accumulator = accumulator;
-    auto s = stride;
-    while (s >= N) {
-      auto acc = simd::load<U, N>(moving_accumulator);
-      auto v = simd::Simd<U, N>(simd::load<T, N>(x));
-      simd::store<U, N>(moving_accumulator, op(acc, v));
-      moving_accumulator += N;
-      x += N;
-      s -= N;
-    }
-    while (s-- > 0) {
-      *moving_accumulator = op(*moving_accumulator, *x);
-      moving_accumulator++;
-      x++;
+  simd::dispatch<T, U>([&](auto n) {
+    constexpr int N = decltype(n)::value;
+    for (int i = 0; i < size; i++) {
+      U* moving_accumulator = accumulator;
+      auto s = stride;
+      while (s >= N) {
+        auto acc = simd::load<U, N>(moving_accumulator);
+        auto v = simd::Simd<U, N>(simd::load<T, N>(x));
+        simd::store<U, N>(moving_accumulator, op(acc, v));
+        moving_accumulator += N;
+        x += N;
+        s -= N;
+      }
+      while (s-- > 0) {
+        *moving_accumulator = op(*moving_accumulator, *x);
+        moving_accumulator++;
+        x++;
+      }
     }
-  }
+  });
 };
 
 template <typename T, typename U, typename Op>
 void contiguous_reduce(const T* x, U* accumulator, int size, Op op, U init) {
-  constexpr int N = std::min(simd::max_size<T>, simd::max_size<U>);
-  simd::Simd<U, N> accumulator_v(init);
-  while (size >= N) {
-    accumulator_v = op(accumulator_v, simd::Simd<U, N>(simd::load<T, N>(x)));
-    x += N;
-    size -= N;
-  }
-  *accumulator = op(*accumulator, op(accumulator_v));
-  while (size-- > 0) {
-    *accumulator = op(*accumulator, *x);
-    x++;
-  }
+  simd::dispatch<T, U>([&](auto n) {
+    constexpr int N = decltype(n)::value;
+    simd::Simd<U, N> accumulator_v(init);
+    while (size >= N) {
+      accumulator_v = op(accumulator_v, simd::Simd<U, N>(simd::load<T, N>(x)));
+      x += N;
+      size -= N;
+    }
+    *accumulator = op(*accumulator, op(accumulator_v));
+    while (size-- > 0) {
+      *accumulator = op(*accumulator, *x);
+      x++;
+    }
+  });
 }
 
 // Helper for the ndimensional strided loop
@@ -135,6 +142,9 @@ void nd_loop(
   loop_inner(0, 0);
 }
 
+// Elements per block of a parallel all-reduce
+constexpr int64_t all_reduce_block = 32768;
+
 template <typename T, typename U, typename Op>
 void reduction_op(
     const array& x,
@@ -146,17 +156,50 @@ void reduction_op(
   auto in_ptr = x.data<T>();
   auto out_ptr = out.data<U>();
   if (plan.type == ContiguousAllReduce) {
-    *out_ptr = init;
-    contiguous_reduce(in_ptr, out_ptr, x.size(), Op{}, init);
+    // Reduce fixed size blocks in parallel and combine the partial results
+    // in order so the result does not depend on the number of threads or
+    // the grain size
+    int64_t size = x.size();
+    int64_t block = all_reduce_block;
+    int64_t n_blocks = (size + block - 1) / block;
+    if (n_blocks <= 1) {
+      *out_ptr = init;
+      contiguous_reduce(in_ptr, out_ptr, size, Op{}, init);
+      return;
+    }
+    // Avoid std::vector<bool> so that each partial is addressable
+    auto partials = std::make_unique<U[]>(n_blocks);
+    std::fill_n(partials.get(), n_blocks, init);
+    cpu::parallel_for(n_blocks, 1, [&](int64_t begin, int64_t end) {
+      for (int64_t i = begin; i < end; i++) {
+        int64_t n = std::min(block, size - i * block);
+        contiguous_reduce(in_ptr + i * block, &partials[i], n, Op{}, init);
+      }
+    });
+    U val = init;
+    for (int64_t i = 0; i < n_blocks; i++) {
+      val = Op{}(val, partials[i]);
+    }
+    *out_ptr = val;
     return;
   }
 
   if (plan.type == ContiguousReduce && plan.shape.size() == 1) {
     int reduction_size = plan.shape[0];
-    for (int i = 0; i < out.size(); i++, out_ptr++, in_ptr += reduction_size) {
-      *out_ptr = init;
-      contiguous_reduce(in_ptr, out_ptr, reduction_size, Op{}, init);
-    }
+    cpu::parallel_for(
+        out.size(),
+        cpu::row_grain(reduction_size),
+        [&](int64_t begin, int64_t end) {
+          for (int64_t i = begin; i < end; i++) {
+            out_ptr[i] = init;
+            contiguous_reduce(
+                in_ptr + i * reduction_size,
+                out_ptr + i,
+                reduction_size,
+                Op{},
+                init);
+          }
+        });
     return;
   }
 
@@ -167,29 +210,33 @@ void reduction_op(
     // Unrolling the following loop (and implementing it in order for
     // ContiguousReduce) should hold extra performance boost.
     auto [shape, strides] = shapes_without_reduction_axes(x, axes);
-    if (plan.shape.size() == 0) {
-      for (int i = 0; i < out.size(); i++, out_ptr++) {
-        int offset = elem_to_loc(i, shape, strides);
-        *out_ptr = init;
-        contiguous_reduce(in_ptr + offset, out_ptr, reduction_size, Op{}, init);
-      }
-    } else {
-      for (int i = 0; i < out.size(); i++, out_ptr++) {
-        int offset = elem_to_loc(i, shape, strides);
-        *out_ptr = init;
-        nd_loop(
-            [&](int extra_offset) {
-              contiguous_reduce(
-                  in_ptr + offset + extra_offset,
-                  out_ptr,
-                  reduction_size,
-                  Op{},
-                  init);
-            },
-            plan.shape,
-            plan.strides);
-      }
+    int64_t row_cost = reduction_size;
+    for (auto s : plan.shape) {
+      row_cost *= s;
     }
+    cpu::parallel_for(
+        out.size(), cpu::row_grain(row_cost), [&](int64_t begin, int64_t end) {
+          for (int64_t i = begin; i < end; i++) {
+            int offset = elem_to_loc(i, shape, strides);
+            out_ptr[i] = init;
+            if (plan.shape.size() == 0) {
+              contiguous_reduce(
+                  in_ptr + offset, out_ptr + i, reduction_size, Op{}, init);
+            } else {
+              nd_loop(
+                  [&](int extra_offset) {
+                    contiguous_reduce(
+                        in_ptr + offset + extra_offset,
+                        out_ptr + i,
+                        reduction_size,
+                        Op{},
+                        init);
+                  },
+                  plan.shape,
+                  plan.strides);
+            }
+          }
+        });
     return;
   }
 
@@ -198,12 +245,21 @@ void reduction_op(
     size_t reduction_stride = plan.strides.back();
     plan.shape.pop_back();
     plan.strides.pop_back();
-    for (int i = 0; i < out.size(); i += reduction_stride) {
-      std::fill_n(out_ptr, reduction_stride, init);
-      strided_reduce(in_ptr, out_ptr, reduction_size, reduction_stride, Op{});
-      in_ptr += reduction_stride * reduction_size;
-      out_ptr += reduction_stride;
-    }
+    cpu::parallel_for(
+        out.size() / reduction_stride,
+        cpu::row_grain(reduction_stride * reduction_size),
+        [&](int64_t begin, int64_t end) {
+          for (int64_t i = begin; i < end; i++) {
+            auto acc_ptr = out_ptr + i * reduction_stride;
+            std::fill_n(acc_ptr, reduction_stride, init);
+            strided_reduce(
+                in_ptr + i * reduction_stride * reduction_size,
+                acc_ptr,
+                reduction_size,
+                reduction_stride,
+                Op{});
+          }
+        });
     return;
   }
 
@@ -214,50 +270,63 @@ void reduction_op(
     plan.shape.pop_back();
     plan.strides.pop_back();
     auto [shape, strides] = shapes_without_reduction_axes(x, axes);
-
-    if (plan.shape.size() == 0) {
-      for (int i = 0; i < out.size(); i += reduction_stride) {
-        int offset = elem_to_loc(i, shape, strides);
-        std::fill_n(out_ptr, reduction_stride, init);
-        strided_reduce(
-            in_ptr + offset, out_ptr, reduction_size, reduction_stride, Op{});
-        out_ptr += reduction_stride;
-      }
-    } else {
-      for (int i = 0; i < out.size(); i += reduction_stride) {
-        int offset = elem_to_loc(i, shape, strides);
-        std::fill_n(out_ptr, reduction_stride, init);
-        nd_loop(
-            [&](int extra_offset) {
+    int64_t row_cost = reduction_stride * reduction_size;
+    for (auto s : plan.shape) {
+      row_cost *= s;
+    }
+    cpu::parallel_for(
+        out.size() / reduction_stride,
+        cpu::row_grain(row_cost),
+        [&](int64_t begin, int64_t end) {
+          for (int64_t i = begin; i < end; i++) {
+            int offset = elem_to_loc(i * reduction_stride, shape, strides);
+            auto acc_ptr = out_ptr + i * reduction_stride;
+            std::fill_n(acc_ptr, reduction_stride, init);
+            if (plan.shape.size() == 0) {
               strided_reduce(
-                  in_ptr + offset + extra_offset,
-                  out_ptr,
+                  in_ptr + offset,
+                  acc_ptr,
                   reduction_size,
                   reduction_stride,
                   Op{});
-            },
-            plan.shape,
-            plan.strides);
-        out_ptr += reduction_stride;
-      }
-    }
+            } else {
+              nd_loop(
+                  [&](int extra_offset) {
+                    strided_reduce(
+                        in_ptr + offset + extra_offset,
+                        acc_ptr,
+                        reduction_size,
+                        reduction_stride,
+                        Op{});
+                  },
+                  plan.shape,
+                  plan.strides);
+            }
+          }
+        });
     return;
   }
 
   if (plan.type == GeneralReduce) {
     auto [shape, strides] = shapes_without_reduction_axes(x, axes);
-
-    for (int i = 0; i < out.size(); i++, out_ptr++) {
-      int offset = elem_to_loc(i, shape, strides);
-      U val = init;
-      nd_loop(
-          [&](int extra_offset) {
-            val = Op{}(val, *(in_ptr + offset + extra_offset));
-          },
-          plan.shape,
-          plan.strides);
-      *out_ptr = val;
+    int64_t row_cost = 1;
+    for (auto s : plan.shape) {
+      row_cost *= s;
     }
+    cpu::parallel_for(
+        out.size(), cpu::row_grain(row_cost), [&](int64_t begin, int64_t end) {
+          for (int64_t i = begin; i < end; i++) {
+            int offset = elem_to_loc(i, shape, strides);
+            U val = init;
+            nd_loop(
+                [&](int extra_offset) {
+                  val = Op{}(val, *(in_ptr + offset + extra_offset));
+                },
+                plan.shape,
+                plan.strides);
+            out_ptr[i] = val;
+          }
+        });
   }
 }
 
@@ -0,0 +1,241 @@
+// Copyright © 2025 Apple Inc.
+
+#include <cassert>
+#include <cmath>
+#include <vector>
+
+#include "mlx/backend/cpu/copy.h"
+#include "mlx/backend/cpu/encoder.h"
+#include "mlx/backend/cpu/parallel.h"
+#include "mlx/backend/cpu/simd/simd.h"
+#include "mlx/fast_primitives.h"
+
+namespace mlx::core::fast {
+
+namespace {
+
+using namespace mlx::core::simd;
+
+// Load n elements starting at x with the two elements of every pair swapped
+template <typename T, int N>
+Simd<float, N> load_pair_swapped(const T* x) {
+  T swapped[N];
+  for (int k = 0; k < N; k++) {
+    swapped[k] = x[k ^ 1];
+  }
+  return load<T, N>(swapped);
+}
+
+template <typename T>
+void rope(
+    const array& in,
+    const array& offset,
+    const float* freqs_ptr,
+    array& out,
+    int dims,
+    bool traditional,
+    float base,
+    float scale,
+    bool forward,
+    Stream s) {
+  auto& encoder = cpu::get_command_encoder(s);
+  int axis_size = in.shape(-1);
+  int seq_len = in.shape(-2);
+  int64_t n_rows = axis_size > 0 ? in.size() / axis_size : 0;
+  bool copy_tail = dims < axis_size && in.data<T>() != out.data<T>();
+
+  encoder.dispatch([in_ptr = in.data<T>(),
+                    offset_ptr = offset.data<int32_t>(),
+                    freqs_ptr,
+                    out_ptr = out.data<T>(),
+                    axis_size,
+                    seq_len,
+                    n_rows,
+                    dims,
+                    traditional,
+                    base,
+                    scale,
+                    forward,
+                    copy_tail]() {
+    int half_dims = dims / 2;
+    int offset = offset_ptr[0];
+
+    // The cosines and sines of every position are shared by all the rows at
+    // that position. The inverse rotation only flips the sign of the sines.
+    // The traditional layout rotates adjacent pairs, so its tables repeat
+    // every value for both elements of a pair and hold -sin for the first
+    // one. A row is then x * cos + swap_pairs(x) * sin.
+    int width = traditional ? 2 * half_dims : half_dims;
+    std::vector<float> cos_table(int64_t(seq_len) * width);
+    std::vector<float> sin_table(int64_t(seq_len) * width);
+    float sign = forward ? 1.0f : -1.0f;
+    cpu::parallel_for(
+        seq_len, cpu::row_grain(half_dims), [&](int64_t begin, int64_t end) {
+          for (int64_t l = begin; l < end; l++) {
+            float position = scale * (l + offset);
+            float* c = cos_table.data() + l * width;
+            float* s = sin_table.data() + l * width;
+            for (int j = 0; j < half_dims; j++) {
+              float inv_freq = freqs_ptr
+                  ? 1.0f / freqs_ptr[j]
+                  : std::exp(-j * std::log(base) / half_dims);
+              float theta = position * inv_freq;
+              float cos_theta = std::cos(theta);
+              float sin_theta = sign * std::sin(theta);
+              if (traditional) {
+                c[2 * j] = c[2 * j + 1] = cos_theta;
+                s[2 * j] = -sin_theta;
+                s[2 * j + 1] = sin_theta;
+              } else {
+                c[j] = cos_theta;
+                s[j] = sin_theta;
+              }
+            }
+          }
+        });
+
+    cpu::parallel_for(
+        n_rows, cpu::row_grain(axis_size), [&](int64_t begin, int64_t end) {
+          constexpr int N = std::min(max_size<float>, max_size<T>);
+          for (int64_t r = begin; r < end; r++) {
+            const T* x = in_ptr + r * axis_size;
+            T* y = out_ptr + r * axis_size;
+            const float* c = cos_table.data() + (r % seq_len) * width;
+            const float* s = sin_table.data() + (r % seq_len) * width;
+            if (traditional) {
+              int j = 0;
+              if constexpr (N > 1) {
+                for (; j + N <= width; j += N) {
+                  Simd<float, N> x1 = load<T, N>(x + j);
+                  auto x2 = load_pair_swapped<T, N>(x + j);
+                  auto vc = load<float, N>(c + j);
+                  auto vs = load<float, N>(s + j);
+                  store(y + j, Simd<T, N>(x1 * vc + x2 * vs));
+                }
+              }
+              for (; j < width; j += 2) {
+                float x1 = static_cast<float>(x[j]);
+                float x2 = static_cast<float>(x[j + 1]);
+                y[j] = static_cast<T>(x1 * c[j] - x2 * s[j + 1]);
+                y[j + 1] = static_cast<T>(x1 * s[j + 1] + x2 * c[j]);
+              }
+            } else {
+              int j = 0;
+              for (; j + N <= half_dims; j += N) {
+                Simd<float, N> x1 = load<T, N>(x + j);
+                Simd<float, N> x2 = load<T, N>(x + half_dims + j);
+                auto vc = load<float, N>(c + j);
+                auto vs = load<float, N>(s + j);
+                store(y + j, Simd<T, N>(x1 * vc - x2 * vs));
+                store(y + half_dims + j, Simd<T, N>(x1 * vs + x2 * vc));
+              }
+              for (; j < half_dims; j++) {
+                float x1 = static_cast<float>(x[j]);
+                float x2 = static_cast<float>(x[half_dims + j]);
+                y[j] = static_cast<T>(x1 * c[j] - x2 * s[j]);
+                y[half_dims + j] = static_cast<T>(x1 * s[j] + x2 * c[j]);
+              }
+            }
+            if (copy_tail) {
+              std::copy(x + dims, x + axis_size, y + dims);
+            }
+          }
+        });
+  });
+}
+
+} // namespace
+
+void RoPE::eval_cpu(
+    const std::vector<array>& inputs,
+    std::vector<array>& outputs) {
+  assert(outputs.size() == 1);
+  auto& encoder = cpu::get_command_encoder(stream());
+  auto& out = outputs[0];
+
+  // Rotate in place when the input buffer can be reused, otherwise write
+  // into a fresh row contiguous output
+  array in = inputs[0];
+  if (!in.flags().row_contiguous) {
+    in = contiguous_copy_cpu(in, stream());
+    out.copy_shared_buffer(in);
+  } else if (in.is_donatable()) {
+    out.copy_shared_buffer(in);
+  } else {
+    out.set_data(allocator::malloc(out.nbytes()));
+  }
+
+  const float* freqs_ptr = nullptr;
+  if (inputs.size() == 3) {
+    array freqs = inputs[2];
+    if (!freqs.flags().row_contiguous) {
+      freqs = contiguous_copy_cpu(freqs, stream());
+      encoder.add_temporary(freqs);
+    }
+    encoder.set_input_array(freqs);
+    freqs_ptr = freqs.data<float>();
+  }
+  encoder.set_input_array(in);
+  encoder.set_input_array(inputs[1]);
+  encoder.set_output_array(out);
+
+  auto& offset = inputs[1];
+  switch (out.dtype()) {
+    case float32:
+      rope<float>(
+          in,
+          offset,
+          freqs_ptr,
+          out,
+          dims_,
+          traditional_,
+          base_,
+          scale_,
+          forward_,
+          stream());
+      break;
+    case float16:
+      rope<float16_t>(
+          in,
+          offset,
+          freqs_ptr,
+          out,
+          dims_,
+          traditional_,
+          base_,
+          scale_,
+          forward_,
+          stream());
+      break;
+    case bfloat16:
+      rope<bfloat16_t>(
+          in,
+          offset,
+          freqs_ptr,
+          out,
+          dims_,
+          traditional_,
+          base_,
+          scale_,
+          forward_,
+          stream());
+      break;
+    case float64:
+      rope<double>(
+          in,
+          offset,
+          freqs_ptr,
+          out,
+          dims_,
+          traditional_,
+          base_,
+          scale_,
+          forward_,
+          stream());
+      break;
+    default:
+      throw std::runtime_error("[rope] Only defined for floating point types.");
+  }
+}
+
+} // namespace mlx::core::fast
@@ -0,0 +1,424 @@
+// Copyright © 2025 Apple Inc.
+
+#include <cassert>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+#include "mlx/backend/cpu/copy.h"
+#include "mlx/backend/cpu/encoder.h"
+#include "mlx/backend/cpu/parallel.h"
+#include "mlx/backend/cpu/simd/simd.h"
+#include "mlx/fast_primitives.h"
+
+namespace mlx::core::fast {
+
+namespace {
+
+using namespace mlx::core::simd;
+
+// Queries and keys processed per tile. The scores of a tile are the only
+// part of the attention matrix that is ever materialized.
+constexpr int query_tile = 16;
+constexpr int key_tile = 64;
+
+// Queries up to this length take the decode path which also splits the keys
+// of each head into parts of at least decode_part_keys keys.
+constexpr int decode_max_queries = 8;
+constexpr int decode_part_keys = 256;
+constexpr int decode_max_parts = 32;
+
+struct AttentionParams {
+  int n_q_heads;
+  int gqa_factor;
+  int q_len;
+  int k_len;
+  int head_dim;
+  int v_head_dim;
+  int q_offset;
+  float scale;
+  bool do_causal;
+  int64_t q_strides[3];
+  int64_t k_strides[3];
+  int64_t v_strides[3];
+  int64_t mask_strides[4];
+};
+
+template <typename T, typename AccT>
+AccT dot(const AccT* a, const T* b, int size) {
+  constexpr int N = std::min(max_size<AccT>, max_size<T>);
+  Simd<AccT, N> acc(0);
+  int i = 0;
+  for (; i + N <= size; i += N) {
+    acc = acc + load<AccT, N>(a + i) * Simd<AccT, N>(load<T, N>(b + i));
+  }
+  AccT total = sum(acc);
+  for (; i < size; i++) {
+    total += a[i] * static_cast<AccT>(b[i]);
+  }
+  return total;
+}
+
+template <typename T, typename AccT>
+void axpy(AccT* y, AccT alpha, const T* x, int size) {
+  constexpr int N = std::min(max_size<AccT>, max_size<T>);
+  int i = 0;
+  for (; i + N <= size; i += N) {
+    auto vy = load<AccT, N>(y + i);
+    store(y + i, vy + alpha * Simd<AccT, N>(load<T, N>(x + i)));
+  }
+  for (; i < size; i++) {
+    y[i] += alpha * static_cast<AccT>(x[i]);
+  }
+}
+
+// Online softmax state of a query tile: the running max and sum of every
+// row and the unnormalized output rows.
+template <typename AccT>
+struct TileState {
+  std::vector<AccT> q;
+  std::vector<AccT> scores;
+  std::vector<AccT> max;
+  std::vector<AccT> sum;
+  std::vector<AccT> acc;
+
+  TileState(const AttentionParams& p)
+      : q(query_tile * p.head_dim),
+        scores(query_tile * key_tile),
+        max(query_tile),
+        sum(query_tile),
+        acc(query_tile * p.v_head_dim) {}
+};
+
+// Attend the queries [q_begin, q_end) of head (b, h) to the keys
+// [k_begin, k_end) and leave the unnormalized result in state.
+template <typename T, typename MaskT, typename AccT>
+void attend_tile(
+    const T* q_ptr,
+    const T* k_ptr,
+    const T* v_ptr,
+    const MaskT* mask_ptr,
+    const AttentionParams& p,
+    int64_t b,
+    int64_t h,
+    int q_begin,
+    int q_end,
+    int k_begin,
+    int k_end,
+    TileState<AccT>& state) {
+  constexpr AccT neg_inf = -std::numeric_limits<AccT>::infinity();
+  int n_q = q_end - q_begin;
+  int64_t kv_h = h / p.gqa_factor;
+  const T* k_head = k_ptr + b * p.k_strides[0] + kv_h * p.k_strides[1];
+  const T* v_head = v_ptr + b * p.v_strides[0] + kv_h * p.v_strides[1];
+  const MaskT* mask_head = mask_ptr
+      ? mask_ptr + b * p.mask_strides[0] + h * p.mask_strides[1]
+      : nullptr;
+
+  for (int i = 0; i < n_q; i++) {
+    const T* q_row = q_ptr + b * p.q_strides[0] + h * p.q_strides[1] +
+        (q_begin + i) * p.q_strides[2];
+    AccT* q_acc = state.q.data() + i * p.head_dim;
+    for (int d = 0; d < p.head_dim; d++) {
+      q_acc[d] = static_cast<AccT>(q_row[d]) * p.scale;
+    }
+  }
+  std::fill_n(state.max.begin(), n_q, neg_inf);
+  std::fill_n(state.sum.begin(), n_q, AccT(0));
+  std::fill_n(state.acc.begin(), n_q * p.v_head_dim, AccT(0));
+
+  // Keys after the last query's causal limit are never needed
+  if (p.do_causal) {
+    k_end = std::min(k_end, q_end - 1 + p.q_offset + 1);
+  }
+
+  for (int kt = k_begin; kt < k_end; kt += key_tile) {
+    int n_k = std::min(key_tile, k_end - kt);
+
+    // Scores of the tile
+    for (int i = 0; i < n_q; i++) {
+      AccT* s = state.scores.data() + i * key_tile;
+      const AccT* q_acc = state.q.data() + i * p.head_dim;
+      int qi = q_begin + i;
+      int causal_end = p.do_causal ? qi + p.q_offset + 1 - kt : n_k;
+      int n_valid = std::max(0, std::min(n_k, causal_end));
+      for (int j = 0; j < n_valid; j++) {
+        s[j] = dot(q_acc, k_head + (kt + j) * p.k_strides[2], p.head_dim);
+      }
+      for (int j = n_valid; j < n_k; j++) {
+        s[j] = neg_inf;
+      }
+      if (mask_head) {
+        const MaskT* m = mask_head + qi * p.mask_strides[2];
+        for (int j = 0; j < n_valid; j++) {
+          auto mv = m[(kt + j) * p.mask_strides[3]];
+          if constexpr (std::is_same_v<MaskT, bool>) {
+            s[j] = mv ? s[j] : neg_inf;
+          } else {
+            s[j] += static_cast<AccT>(mv);
+          }
+        }
+      }
+    }
+
+    // Rescale the running state and accumulate the values of the tile
+    for (int i = 0; i < n_q; i++) {
+      AccT* s = state.scores.data() + i * key_tile;
+      AccT tile_max = neg_inf;
+      for (int j = 0; j < n_k; j++) {
+        tile_max = std::max(tile_max, s[j]);
+      }
+      AccT new_max = std::max(state.max[i], tile_max);
+      if (new_max == neg_inf) {
+        // Every key so far is masked, leave the tile out of the values
+        std::fill_n(s, n_k, AccT(0));
+        continue;
+      }
+      AccT factor = std::exp(state.max[i] - new_max);
+      AccT* o = state.acc.data() + i * p.v_head_dim;
+      if (factor != AccT(1)) {
+        state.sum[i] *= factor;
+        for (int d = 0; d < p.v_head_dim; d++) {
+          o[d] *= factor;
+        }
+      }
+      state.max[i] = new_max;
+      for (int j = 0; j < n_k; j++) {
+        s[j] = std::exp(s[j] - new_max);
+        state.sum[i] += s[j];
+      }
+    }
+    for (int j = 0; j < n_k; j++) {
+      const T* v_row = v_head + (kt + j) * p.v_strides[2];
+      for (int i = 0; i < n_q; i++) {
+        AccT w = state.scores[i * key_tile + j];
+        if (w != AccT(0)) {
+          axpy(state.acc.data() + i * p.v_head_dim, w, v_row, p.v_head_dim);
+        }
+      }
+    }
+  }
+}
+
+template <typename T, typename MaskT>
+void sdpa(
+    const array& q,
+    const array& k,
+    const array& v,
+    const MaskT* mask_ptr,
+    array& out,
+    AttentionParams p,
+    Stream s) {
+  using AccT = std::conditional_t<std::is_same_v<T, double>, double, float>;
+  auto& encoder = cpu::get_command_encoder(s);
+  int64_t n_heads = int64_t(q.shape(0)) * p.n_q_heads;
+
+  encoder.dispatch([q_ptr = q.data<T>(),
+                    k_ptr = k.data<T>(),
+                    v_ptr = v.data<T>(),
+                    mask_ptr,
+                    out_ptr = out.data<T>(),
+                    n_heads,
+                    p]() {
+    auto out_row = [&](int64_t bh, int qi) {
+      return out_ptr + (bh * p.q_len + qi) * p.v_head_dim;
+    };
+
+    if (p.q_len <= decode_max_queries) {
+      // Decode: split the keys of every head so that short query sequences
+      // still use all the threads, then merge the partial softmaxes.
+      int n_parts = std::min(
+          decode_max_parts,
+          std::max(1, p.k_len / decode_part_keys));
+      int part_keys = (p.k_len + n_parts - 1) / n_parts;
+      int64_t n_tasks = n_heads * n_parts;
+      std::vector<AccT> maxs(n_tasks * p.q_len);
+      std::vector<AccT> sums(n_tasks * p.q_len);
+      std::vector<AccT> accs(n_tasks * p.q_len * p.v_head_dim);
+
+      cpu::parallel_for(n_tasks, 1, [&](int64_t begin, int64_t end) {
+        TileState<AccT> state(p);
+        for (int64_t t = begin; t < end; t++) {
+          int64_t bh = t / n_parts;
+          int part = t % n_parts;
+          int k_begin = part * part_keys;
+          int k_end = std::min(p.k_len, k_begin + part_keys);
+          attend_tile<T, MaskT, AccT>(
+              q_ptr,
+              k_ptr,
+              v_ptr,
+              mask_ptr,
+              p,
+              bh / p.n_q_heads,
+              bh % p.n_q_heads,
+              0,
+              p.q_len,
+              k_begin,
+              k_end,
+              state);
+          std::copy_n(state.max.begin(), p.q_len, &maxs[t * p.q_len]);
+          std::copy_n(state.sum.begin(), p.q_len, &sums[t * p.q_len]);
+          std::copy_n(
+              state.acc.begin(),
+              p.q_len * p.v_head_dim,
+              &accs[t * p.q_len * p.v_head_dim]);
+        }
+      });
+
+      cpu::parallel_for(
+          n_heads * p.q_len,
+          cpu::row_grain(n_parts * p.v_head_dim),
+          [&](int64_t begin, int64_t end) {
+            std::vector<AccT> o(p.v_head_dim);
+            for (int64_t r = begin; r < end; r++) {
+              int64_t bh = r / p.q_len;
+              int qi = r % p.q_len;
+              AccT max = -std::numeric_limits<AccT>::infinity();
+              for (int part = 0; part < n_parts; part++) {
+                max = std::max(max, maxs[(bh * n_parts + part) * p.q_len + qi]);
+              }
+              AccT sum = 0;
+              std::fill(o.begin(), o.end(), AccT(0));
+              for (int part = 0; part < n_parts; part++) {
+                int64_t idx = (bh * n_parts + part) * p.q_len + qi;
+                if (sums[idx] == AccT(0)) {
+                  continue;
+                }
+                AccT factor = std::exp(maxs[idx] - max);
+                sum += sums[idx] * factor;
+                const AccT* a = &accs[idx * p.v_head_dim];
+                for (int d = 0; d < p.v_head_dim; d++) {
+                  o[d] += a[d] * factor;
+                }
+              }
+              T* y = out_row(bh, qi);
+              for (int d = 0; d < p.v_head_dim; d++) {
+                y[d] = static_cast<T>(o[d] / sum);
+              }
+            }
+          });
+      return;
+    }
+
+    int n_q_tiles = (p.q_len + query_tile - 1) / query_tile;
+    cpu::parallel_for(n_heads * n_q_tiles, 1, [&](int64_t begin, int64_t end) {
+      TileState<AccT> state(p);
+      for (int64_t t = begin; t < end; t++) {
+        int64_t bh = t / n_q_tiles;
+        int q_begin = (t % n_q_tiles) * query_tile;
+        int q_end = std::min(p.q_len, q_begin + query_tile);
+        attend_tile<T, MaskT, AccT>(
+            q_ptr,
+            k_ptr,
+            v_ptr,
+            mask_ptr,
+            p,
+            bh / p.n_q_heads,
+            bh % p.n_q_heads,
+            q_begin,
+            q_end,
+            0,
+            p.k_len,
+            state);
+        for (int i = 0; i < q_end - q_begin; i++) {
+          T* y = out_row(bh, q_begin + i);
+          const AccT* o = state.acc.data() + i * p.v_head_dim;
+          for (int d = 0; d < p.v_head_dim; d++) {
+            y[d] = static_cast<T>(o[d] / state.sum[i]);
+          }
+        }
+      }
+    });
+  });
+}
+
+template <typename T>
+void sdpa_dispatch_mask(
+    const array& q,
+    const array& k,
+    const array& v,
+    const std::optional<array>& mask,
+    array& out,
+    const AttentionParams& p,
+    Stream s) {
+  if (!mask) {
+    sdpa<T, T>(q, k, v, nullptr, out, p, s);
+  } else if (mask->dtype() == bool_) {
+    sdpa<T, bool>(q, k, v, mask->data<bool>(), out, p, s);
+  } else {
+    sdpa<T, T>(q, k, v, mask->data<T>(), out, p, s);
+  }
+}
+
+} // namespace
+
+void ScaledDotProductAttention::eval_cpu(
+    const std::vector<array>& inputs,
+    std::vector<array>& outputs) {
+  assert(outputs.size() == 1);
+  auto& encoder = cpu::get_command_encoder(stream());
+  auto& out = outputs[0];
+
+  // Only the head dimension needs to be contiguous
+  auto ensure_head_contiguous = [&](const array& x) {
+    if (x.strides(-1) == 1) {
+      return x;
+    }
+    array x_copy = contiguous_copy_cpu(x, stream());
+    encoder.add_temporary(x_copy);
+    return x_copy;
+  };
+  auto q = ensure_head_contiguous(inputs[0]);
+  auto k = ensure_head_contiguous(inputs[1]);
+  auto v = ensure_head_contiguous(inputs[2]);
+  std::optional<array> mask;
+  if (inputs.size() > 3) {
+    mask = inputs[3];
+    encoder.set_input_array(*mask);
+  }
+  out.set_data(allocator::malloc(out.nbytes()));
+  encoder.set_input_array(q);
+  encoder.set_input_array(k);
+  encoder.set_input_array(v);
+  encoder.set_output_array(out);
+
+  AttentionParams p;
+  p.n_q_heads = q.shape(1);
+  p.gqa_factor = q.shape(1) / k.shape(1);
+  p.q_len = q.shape(2);
+  p.k_len = k.shape(2);
+  p.head_dim = q.shape(3);
+  p.v_head_dim = v.shape(3);
+  p.q_offset = std::max(0, p.k_len - p.q_len);
+  p.scale = scale_;
+  p.do_causal = do_causal_;
+  for (int i = 0; i < 3; i++) {
+    p.q_strides[i] = q.strides(i);
+    p.k_strides[i] = k.strides(i);
+    p.v_strides[i] = v.strides(i);
+  }
+  for (int i = 0; i < 4; i++) {
+    p.mask_strides[i] = mask ? mask->strides(i) : 0;
+  }
+
+  switch (out.dtype()) {
+    case float32:
+      sdpa_dispatch_mask<float>(q, k, v, mask, out, p, stream());
+      break;
+    case float16:
+      sdpa_dispatch_mask<float16_t>(q, k, v, mask, out, p, stream());
+      break;
+    case bfloat16:
+      sdpa_dispatch_mask<bfloat16_t>(q, k, v, mask, out, p, stream());
+      break;
+    case float64:
+      sdpa_dispatch_mask<double>(q, k, v, mask, out, p, stream());
+      break;
+    default:
+      throw std::runtime_error(
+          "[scaled_dot_product_attention] Only defined for floating point "
+          "types.");
+  }
+}
+
+} // namespace mlx::core::fast
@@ -6,6 +6,14 @@
 #include <complex>
 #include <functional>
 
+// Vector helpers are always inlined so they are compiled for the instruction
+// set of the kernel using them (see simd/dispatch.h).
+#if defined(__GNUC__) || defined(__clang__)
+#define MLX_SIMD_ALWAYS_INLINE inline __attribute__((always_inline))
+#else
+#define MLX_SIMD_ALWAYS_INLINE inline
+#endif
+
 namespace mlx::core::simd {
 template <typename T, int N>
 struct Simd;
@@ -25,12 +33,12 @@ struct Simd<T, 1> {
 };
 
 template <typename T, int N>
-Simd<T, N> load(const T* x) {
+MLX_SIMD_ALWAYS_INLINE Simd<T, N> load(const T* x) {
   return *(Simd<T, N>*)x;
 }
 
 template <typename T, int N>
-void store(T* dst, Simd<T, N> x) {
+MLX_SIMD_ALWAYS_INLINE void store(T* dst, Simd<T, N> x) {
   // Maintain invariant that bool is either 0 or 1 as
   // simd comparison ops set all bits in the result to 1
   if constexpr (std::is_same_v<T, bool> && N > 1) {
@@ -39,6 +47,26 @@ void store(T* dst, Simd<T, N> x) {
   *(Simd<T, N>*)dst = x;
 }
 
+// Load the n < N elements at x, the remaining lanes repeat the last one so
+// an op on the padding does whatever it does on real data. Kernels use these
+// for their tails so that every element is computed by the same vector code
+// wherever a parallel_for splits the range.
+template <typename T, int N>
+MLX_SIMD_ALWAYS_INLINE Simd<T, N> load_partial(const T* x, int n) {
+  T buf[N];
+  std::copy_n(x, n, buf);
+  std::fill(buf + n, buf + N, x[n - 1]);
+  return load<T, N>(buf);
+}
+
+// Store the first n < N lanes of x
+template <typename T, int N>
+MLX_SIMD_ALWAYS_INLINE void store_partial(T* dst, Simd<T, N> x, int n) {
+  T buf[N];
+  store(buf, x);
+  std::copy_n(buf, n, dst);
+}
+
 template <typename, typename = void>
 constexpr bool is_complex = false;
 
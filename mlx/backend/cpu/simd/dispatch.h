@@ -0,0 +1,132 @@
+// Copyright © 2025 Apple Inc.
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <type_traits>
+
+#include "mlx/backend/cpu/simd/type.h"
+#include "mlx/utils.h"
+
+// Element-wise kernels are compiled a second and third time for AVX2 and
+// AVX-512 and the widest version the CPU supports is picked at run time, so
+// the same binary uses 32 byte vectors on Zen and 64 byte vectors on
+// Sapphire Rapids.
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__)) && \
+    !defined(MLX_USE_ACCELERATE)
+#define MLX_SIMD_DISPATCH
+#define MLX_SIMD_TARGET_AVX2 \
+  __attribute__((target("avx2,fma,f16c"), flatten))
+// AVX512-BF16 is only used after checking for it (see simd/x86_simd.h)
+#define MLX_SIMD_TARGET_AVX512                                               \
+  __attribute__((                                                            \
+      target("avx512f,avx512bw,avx512dq,avx512vl,avx512bf16,avx2,fma,f16c"), \
+      flatten))
+#endif
+
+#ifndef MLX_SIMD_BYTES
+#define MLX_SIMD_BYTES 16
+#endif
+
+namespace mlx::core::simd {
+
+// The widest vectors in bytes the CPU supports
+inline int supported_width() {
+#ifdef MLX_SIMD_DISPATCH
+  static int width = [] {
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f") &&
+        __builtin_cpu_supports("avx512bw") &&
+        __builtin_cpu_supports("avx512dq") &&
+        __builtin_cpu_supports("avx512vl")) {
+      return 64;
+    }
+    if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma") &&
+        __builtin_cpu_supports("f16c")) {
+      return 32;
+    }
+    return 16;
+  }();
+  return std::max(width, MLX_SIMD_BYTES);
+#else
+  return MLX_SIMD_BYTES;
+#endif
+}
+
+namespace detail {
+
+inline std::atomic<int>& width_limit() {
+  static std::atomic<int> limit{[] {
+    int bytes = env::cpu_simd_width();
+    return bytes > 0 ? bytes : supported_width();
+  }()};
+  return limit;
+}
+
+} // namespace detail
+
+// The widest vectors the kernels dispatch to. It defaults to the widest the
+// CPU supports and can be lowered with MLX_CPU_SIMD_WIDTH.
+inline int max_width() {
+  return std::min(
+      detail::width_limit().load(std::memory_order_relaxed), supported_width());
+}
+
+inline void set_max_width(int bytes) {
+  detail::width_limit() = bytes;
+}
+
+// Bytes per lane of T. Half precision is computed in float.
+template <typename T>
+inline constexpr int lane_bytes =
+    std::is_same_v<T, float16_t> || std::is_same_v<T, bfloat16_t>
+    ? int(sizeof(float))
+    : int(sizeof(T));
+
+// Lanes of T and U per vector of the given bytes, types without a vector
+// implementation have a single lane.
+template <typename T, typename U = T>
+constexpr int lanes(int bytes) {
+  if constexpr (max_size<T> == 1 || max_size<U> == 1) {
+    return 1;
+  } else {
+    return std::min(
+        std::max(bytes / lane_bytes<T>, max_size<T>),
+        std::max(bytes / lane_bytes<U>, max_size<U>));
+  }
+}
+
+#ifdef MLX_SIMD_DISPATCH
+template <typename T, typename U, typename F>
+MLX_SIMD_TARGET_AVX2 void dispatch_avx2(F& f) {
+  f(std::integral_constant<int, lanes<T, U>(32)>{});
+}
+
+template <typename T, typename U, typename F>
+MLX_SIMD_TARGET_AVX512 void dispatch_avx512(F& f) {
+  f(std::integral_constant<int, lanes<T, U>(64)>{});
+}
+#endif
+
+// Call f(std::integral_constant<int, N>{}) with the widest N lanes of T and
+// U the running CPU supports.
+template <typename T, typename U = T, typename F>
+void dispatch(F&& f) {
+#ifdef MLX_SIMD_DISPATCH
+  if constexpr (lanes<T, U>(64) > lanes<T, U>(MLX_SIMD_BYTES)) {
+    int width = max_width();
+    if (width >= 64) {
+      return dispatch_avx512<T, U>(f);
+    }
+    if constexpr (lanes<T, U>(32) > lanes<T, U>(MLX_SIMD_BYTES)) {
+      if (width >= 32) {
+        return dispatch_avx2<T, U>(f);
+      }
+    }
+  }
+#endif
+  f(std::integral_constant<int, lanes<T, U>(MLX_SIMD_BYTES)>{});
+}
+
+} // namespace mlx::core::simd
@@ -2,6 +2,8 @@
 
 #pragma once
 
+#include <cstring>
+
 #include "mlx/backend/cpu/simd/type.h"
 
 namespace mlx::core::simd {
@@ -25,7 +27,7 @@ constexpr float inf = std::numeric_limits<float>::infinity();
  *       implementations for numbers strictly < 0.
  */
 template <typename T, int N>
-Simd<T, N> exp(Simd<T, N> in) {
+MLX_SIMD_ALWAYS_INLINE Simd<T, N> exp(Simd<T, N> in) {
   if constexpr (is_complex<T>) {
     return Simd<T, 1>{std::exp(in.value)};
   } else {
@@ -46,9 +48,11 @@ Simd<T, N> exp(Simd<T, N> in) {
     // generate 2**ipart in the floating point representation using integer
     // bitshifting
     Simd<int, N> epart = (Simd<int, N>(ipart) + 127) << 23;
+    Simd<float, N> two_ipart;
+    std::memcpy(&two_ipart, &epart, sizeof(two_ipart));
 
     // Deal with NaN and Inf
-    auto result = select(isnan(x_init), x_init, (*(Simd<float, N>*)&epart) * x);
+    auto result = select(isnan(x_init), x_init, two_ipart * x);
     result = select(x_init > 88.0f, Simd<float, N>(inf), result);
     result = select(x_init < -88.0f, Simd<float, N>(0), result);
     return Simd<T, N>(result);
@@ -60,7 +64,7 @@ Simd<T, N> exp(Simd<T, N> in) {
  * which originally came from the Cephes math library.
  */
 template <bool Sine, typename T, int N>
-Simd<T, N> sincos(Simd<T, N> in) {
+MLX_SIMD_ALWAYS_INLINE Simd<T, N> sincos(Simd<T, N> in) {
   auto sign_mask_sin = in < 0;
   in = abs(in);
   Simd<float, N> x = in;
@@ -116,7 +120,7 @@ Simd<T, N> sincos(Simd<T, N> in) {
 }
 
 template <typename T, int N>
-Simd<T, N> sin(Simd<T, N> x) {
+MLX_SIMD_ALWAYS_INLINE Simd<T, N> sin(Simd<T, N> x) {
   if constexpr (is_complex<T>) {
     return std::sin(x.value);
   } else {
@@ -125,7 +129,7 @@ Simd<T, N> sin(Simd<T, N> x) {
 }
 
 template <typename T, int N>
-Simd<T, N> cos(Simd<T, N> x) {
+MLX_SIMD_ALWAYS_INLINE Simd<T, N> cos(Simd<T, N> x) {
   if constexpr (is_complex<T>) {
     return std::cos(x.value);
   } else {
@@ -134,7 +138,7 @@ Simd<T, N> cos(Simd<T, N> x) {
 }
 
 template <typename T, int N>
-Simd<T, N> erf(Simd<T, N> x) {
+MLX_SIMD_ALWAYS_INLINE Simd<T, N> erf(Simd<T, N> x) {
   // https://github.com/pytorch/pytorch/blob/abf28982a8cb43342e7669d859de9543fd804cc9/aten/src/ATen/cpu/vec/vec256/vec256_float.h#L175
   Simd<float, N> v = x;
   auto t = recip(fma(Simd<float, N>(0.3275911f), abs(v), 1.0f));
@@ -148,7 +152,7 @@ Simd<T, N> erf(Simd<T, N> x) {
 }
 
 template <typename T, int N>
-Simd<T, N> erfinv(Simd<T, N> a_) {
+MLX_SIMD_ALWAYS_INLINE Simd<T, N> erfinv(Simd<T, N> a_) {
   Simd<float, N> a = a_;
   auto t = fma(a, 0.0f - a, 1.0f);
   t = log(t);
@@ -4,4 +4,6 @@
 
 #ifdef MLX_USE_ACCELERATE
 #include "mlx/backend/cpu/simd/accelerate_simd.h"
+#elif defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#include "mlx/backend/cpu/simd/x86_simd.h"
 #endif
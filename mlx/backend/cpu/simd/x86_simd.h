@@ -0,0 +1,799 @@
+// Copyright © 2025 Apple Inc.
+
+#pragma once
+
+#include <stdint.h>
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <cstring>
+#include <type_traits>
+
+#include "mlx/backend/cpu/simd/base_simd.h"
+#include "mlx/types/half_types.h"
+
+// Width in bytes of the vectors the library is compiled for. Kernels that
+// dispatch on the running CPU (see simd/dispatch.h) also use wider vectors.
+#if defined(__AVX512F__)
+#define MLX_SIMD_BYTES 64
+#elif defined(__AVX__)
+#define MLX_SIMD_BYTES 32
+#else
+#define MLX_SIMD_BYTES 16
+#endif
+
+// Everything here is always inlined (MLX_SIMD_ALWAYS_INLINE) since a call
+// between code compiled for different instruction sets would disagree on how
+// to pass the vectors. Helpers write wide vectors through a reference rather
+// than returning them for the same reason.
+
+// GCC checks the instruction set of a builtin where it ends up after
+// inlining, so the F16C and AVX-512 conversions can be used in code that is
+// only reached from the dispatched kernels. Clang checks where it is written.
+#if defined(__GNUC__) && !defined(__clang__)
+#define MLX_SIMD_HALF_BUILTINS
+// Declares the builtins without pulling in immintrin.h
+#pragma GCC push_options
+#pragma GCC target("avx512f,f16c,avx512bf16")
+#pragma GCC pop_options
+#endif
+
+namespace mlx::core::simd {
+
+template <typename T>
+inline constexpr bool is_half_v =
+    std::is_same_v<T, float16_t> || std::is_same_v<T, bfloat16_t>;
+
+// The lane type of the vector of a Simd. Booleans are kept as bytes that are
+// either 0 or 1 like in memory and the half precision types as their bits.
+// Arithmetic on half precision vectors is done in float.
+template <typename T>
+struct ScalarT {
+  using v = T;
+};
+template <>
+struct ScalarT<bool> {
+  using v = int8_t;
+};
+template <>
+struct ScalarT<float16_t> {
+  using v = uint16_t;
+};
+template <>
+struct ScalarT<bfloat16_t> {
+  using v = uint16_t;
+};
+
+// Vectors are only aligned like their lanes since loads and stores are from
+// arbitrary offsets into arrays
+template <typename S, int N>
+struct Vec {
+  typedef S type
+      __attribute__((vector_size(N * sizeof(S)), aligned(sizeof(S))));
+};
+
+// Naturally aligned vectors for the builtins
+template <typename S, int N>
+struct NativeVec {
+  typedef S type __attribute__((vector_size(N * sizeof(S))));
+};
+
+template <int Bytes>
+struct IntOf;
+template <>
+struct IntOf<1> {
+  using v = int8_t;
+};
+template <>
+struct IntOf<2> {
+  using v = int16_t;
+};
+template <>
+struct IntOf<4> {
+  using v = int32_t;
+};
+template <>
+struct IntOf<8> {
+  using v = int64_t;
+};
+
+template <typename S, int N>
+using mask_t = typename Vec<typename IntOf<sizeof(S)>::v, N>::type;
+
+namespace x86 {
+
+template <int N>
+using f32_t = typename Vec<float, N>::type;
+template <int N>
+using u32_t = typename Vec<uint32_t, N>::type;
+template <int N>
+using u16_t = typename Vec<uint16_t, N>::type;
+
+// Broadcast s to every lane. Going through memory compiles to a single
+// broadcast in the dispatched kernels, while setting the lanes of the vector
+// one by one or a scalar operand are lowered to an insert per lane when the
+// vector is wider than the baseline.
+template <typename V, typename S>
+MLX_SIMD_ALWAYS_INLINE void splat(V& out, S s) {
+  S lanes[sizeof(V) / sizeof(S)];
+  std::fill_n(lanes, sizeof(V) / sizeof(S), s);
+  std::memcpy(&out, lanes, sizeof(V));
+}
+
+#ifdef MLX_SIMD_HALF_BUILTINS
+inline bool has_avx512bf16() {
+  static bool supported = [] {
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx512bf16") != 0;
+  }();
+  return supported;
+}
+#endif
+
+// The builtins return vectors wider than the baseline but they are single
+// instructions rather than calls
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wpsabi"
+
+// The conversions match mlx/types/fp16.h and mlx/types/bf16.h bit for bit
+// except for the payload of NaNs and for bfloat16 denormals, which the
+// AVX512-BF16 conversion flushes to zero.
+template <int N>
+MLX_SIMD_ALWAYS_INLINE void fp16_to_float(f32_t<N>& out, const u16_t<N>& h) {
+#ifdef MLX_SIMD_HALF_BUILTINS
+  // 16 lanes are only used by AVX-512 kernels and 8 lanes without AVX by the
+  // dispatched AVX2 kernels which enable F16C
+  constexpr bool f16c = N == 16 || (N == 8 && MLX_SIMD_BYTES < 32) ||
+#ifdef __F16C__
+      N == 8 || N == 4;
+#else
+      false;
+#endif
+  if constexpr (f16c) {
+    using F = typename NativeVec<float, N>::type;
+    typename NativeVec<short, (N < 8 ? 8 : N)>::type x = {};
+    std::memcpy(&x, &h, sizeof(h));
+    F f;
+    if constexpr (N == 16) {
+      f = __builtin_ia32_vcvtph2ps512_mask(x, F{}, -1, 4);
+    } else if constexpr (N == 8) {
+      f = __builtin_ia32_vcvtph2ps256(x);
+    } else {
+      f = __builtin_ia32_vcvtph2ps(x);
+    }
+    std::memcpy(&out, &f, sizeof(out));
+    return;
+  }
+#endif
+  auto w = __builtin_convertvector(h, u32_t<N>) << 16;
+  auto sign = w & 0x80000000u;
+  auto two_w = w + w;
+  auto denorm = (f32_t<N>)((two_w >> 17) | (126u << 23)) - 0.5f;
+  auto norm = (f32_t<N>)((two_w >> 4) + (0xE0u << 23)) * 0x1.0p-112f;
+  auto bits = (two_w < (1u << 27)) ? (u32_t<N>)denorm : (u32_t<N>)norm;
+  out = (f32_t<N>)(bits | sign);
+}
+
+template <int N>
+MLX_SIMD_ALWAYS_INLINE void float_to_fp16(u16_t<N>& out, const f32_t<N>& f) {
+#ifdef MLX_SIMD_HALF_BUILTINS
+  constexpr bool f16c = N == 16 || (N == 8 && MLX_SIMD_BYTES < 32) ||
+#ifdef __F16C__
+      N == 8 || N == 4;
+#else
+      false;
+#endif
+  if constexpr (f16c) {
+    using H = typename NativeVec<short, (N < 8 ? 8 : N)>::type;
+    typename NativeVec<float, N>::type x;
+    std::memcpy(&x, &f, sizeof(f));
+    H h;
+    if constexpr (N == 16) {
+      h = __builtin_ia32_vcvtps2ph512_mask(x, 0, H{}, -1);
+    } else if constexpr (N == 8) {
+      h = __builtin_ia32_vcvtps2ph256(x, 0);
+    } else {
+      h = __builtin_ia32_vcvtps2ph(x, 0);
+    }
+    std::memcpy(&out, &h, sizeof(out));
+    return;
+  }
+#endif
+  auto u = (u32_t<N>)f;
+  auto sign = (u & 0x80000000u) >> 16;
+  auto expo = u & 0x7f800000u;
+  u32_t<N> min_expo;
+  splat(min_expo, 0x38800000u);
+  expo = (expo < 0x38800000u) ? min_expo : expo;
+  expo += 15u << 23;
+  auto abs_f = (f32_t<N>)(u & 0x7fffffffu);
+  auto magic =
+      (u32_t<N>)((f32_t<N>)expo + (abs_f * 0x1.0p+112f) * 0x1.0p-110f);
+  auto bits = sign | (((magic >> 13) & 0x7c00u) + (magic & 0x0fffu));
+  bits = (f != f) ? (sign | 0x7D00u) : bits;
+  out = __builtin_convertvector(bits, u16_t<N>);
+}
+
+template <int N>
+MLX_SIMD_ALWAYS_INLINE void bf16_to_float(f32_t<N>& out, const u16_t<N>& h) {
+  out = (f32_t<N>)(__builtin_convertvector(h, u32_t<N>) << 16);
+}
+
+template <int N>
+MLX_SIMD_ALWAYS_INLINE void float_to_bf16(u16_t<N>& out, const f32_t<N>& f) {
+#if defined(MLX_SIMD_HALF_BUILTINS) && \
+    (MLX_SIMD_BYTES < 64 || defined(__AVX512BF16__))
+  // The dispatched AVX-512 kernels enable AVX512-BF16 but it has to be
+  // checked for at run time
+  if constexpr (N == 16) {
+#ifndef __AVX512BF16__
+    if (has_avx512bf16())
+#endif
+    {
+      typename NativeVec<float, N>::type x;
+      std::memcpy(&x, &f, sizeof(f));
+      auto h = __builtin_ia32_cvtneps2bf16_v16sf(x);
+      std::memcpy(&out, &h, sizeof(out));
+      return;
+    }
+  }
+#endif
+  auto u = (u32_t<N>)f;
+  u += ((u >> 16) & 1u) + 0x7FFFu;
+  u >>= 16;
+  u32_t<N> nan;
+  splat(nan, 0x7FC0u);
+  u = (f != f) ? nan : u;
+  out = __builtin_convertvector(u, u16_t<N>);
+}
+
+#pragma GCC diagnostic pop
+
+} // namespace x86
+
+template <typename T, int N>
+struct Simd {
+  static constexpr int size = N;
+  using scalar_t = typename ScalarT<T>::v;
+  using vector_t = typename Vec<scalar_t, N>::type;
+
+  MLX_SIMD_ALWAYS_INLINE Simd() {}
+
+  // Not trivially copyable so that a Simd is always passed in memory. Code
+  // compiled for different instruction sets (see simd/dispatch.h) then
+  // agrees on how to pass vectors wider than 16 bytes.
+  MLX_SIMD_ALWAYS_INLINE Simd(const Simd& other) : value(other.value) {}
+  Simd& operator=(const Simd& other) = default;
+
+  MLX_SIMD_ALWAYS_INLINE Simd(const vector_t& v) : value(v) {}
+
+  template <typename U>
+  MLX_SIMD_ALWAYS_INLINE Simd(const Simd<U, N>& other) {
+    convert(value, other);
+  }
+
+  template <typename U>
+  MLX_SIMD_ALWAYS_INLINE Simd(U v) {
+    splat(value, v);
+  }
+
+  MLX_SIMD_ALWAYS_INLINE Simd(Simd<T, N / 2> x, Simd<T, N / 2> y) {
+    std::memcpy(&value, &x.value, sizeof(value) / 2);
+    std::memcpy(
+        reinterpret_cast<char*>(&value) + sizeof(value) / 2,
+        &y.value,
+        sizeof(value) / 2);
+  }
+
+  MLX_SIMD_ALWAYS_INLINE T operator[](int idx) const {
+    if constexpr (std::is_same_v<T, bool>) {
+      return value[idx] != 0;
+    } else if constexpr (is_half_v<T>) {
+      T out;
+      out.bits_ = value[idx];
+      return out;
+    } else {
+      return value[idx];
+    }
+  }
+
+  template <
+      typename U = T,
+      typename = std::enable_if_t<!std::is_same_v<U, bool>>>
+  MLX_SIMD_ALWAYS_INLINE T& operator[](int idx) {
+    return reinterpret_cast<T*>(&value)[idx];
+  }
+
+  vector_t value;
+
+ private:
+  template <typename U>
+  MLX_SIMD_ALWAYS_INLINE static void splat(vector_t& out, U v) {
+    if constexpr (std::is_same_v<T, bool>) {
+      x86::splat(out, scalar_t(static_cast<bool>(v)));
+    } else if constexpr (is_half_v<T>) {
+      x86::splat(out, T(static_cast<float>(v)).bits_);
+    } else {
+      x86::splat(out, static_cast<scalar_t>(v));
+    }
+  }
+
+  template <typename U>
+  MLX_SIMD_ALWAYS_INLINE static void convert(
+      vector_t& out,
+      const Simd<U, N>& x) {
+    if constexpr (std::is_same_v<T, U>) {
+      out = x.value;
+    } else if constexpr (std::is_same_v<T, float16_t>) {
+      x86::float_to_fp16<N>(out, Simd<float, N>(x).value);
+    } else if constexpr (std::is_same_v<T, bfloat16_t>) {
+      x86::float_to_bf16<N>(out, Simd<float, N>(x).value);
+    } else if constexpr (is_half_v<U>) {
+      Simd<float, N> f;
+      if constexpr (std::is_same_v<U, float16_t>) {
+        x86::fp16_to_float<N>(f.value, x.value);
+      } else {
+        x86::bf16_to_float<N>(f.value, x.value);
+      }
+      out = Simd<T, N>(f).value;
+    } else if constexpr (std::is_same_v<T, bool>) {
+      out = __builtin_convertvector(x.value != 0, vector_t) & 1;
+    } else {
+      out = __builtin_convertvector(x.value, vector_t);
+    }
+  }
+};
+
+// Values chosen to fill one vector register of the baseline instruction set.
+// The half precision types are computed in float.
+template <>
+inline constexpr int max_size<int8_t> = MLX_SIMD_BYTES;
+template <>
+inline constexpr int max_size<int16_t> = MLX_SIMD_BYTES / 2;
+template <>
+inline constexpr int max_size<int32_t> = MLX_SIMD_BYTES / 4;
+template <>
+inline constexpr int max_size<int64_t> = MLX_SIMD_BYTES / 8;
+template <>
+inline constexpr int max_size<uint8_t> = MLX_SIMD_BYTES;
+template <>
+inline constexpr int max_size<uint16_t> = MLX_SIMD_BYTES / 2;
+template <>
+inline constexpr int max_size<uint32_t> = MLX_SIMD_BYTES / 4;
+template <>
+inline constexpr int max_size<uint64_t> = MLX_SIMD_BYTES / 8;
+template <>
+inline constexpr int max_size<float> = MLX_SIMD_BYTES / 4;
+template <>
+inline constexpr int max_size<double> = MLX_SIMD_BYTES / 8;
+template <>
+inline constexpr int max_size<float16_t> = MLX_SIMD_BYTES / 4;
+template <>
+inline constexpr int max_size<bfloat16_t> = MLX_SIMD_BYTES / 4;
+
+template <int N, typename V>
+MLX_SIMD_ALWAYS_INLINE Simd<bool, N> to_mask(const V& m) {
+  return __builtin_convertvector(m, typename Simd<bool, N>::vector_t) & 1;
+}
+
+// Apply a scalar function to every lane
+template <typename T, int N, typename F>
+MLX_SIMD_ALWAYS_INLINE Simd<T, N> lanewise(Simd<T, N> x, F f) {
+  Simd<T, N> out;
+  for (int i = 0; i < N; i++) {
+    out.value[i] = f(x.value[i]);
+  }
+  return out;
+}
+
+template <typename T, int N, typename F>
+MLX_SIMD_ALWAYS_INLINE Simd<T, N> lanewise(Simd<T, N> x, Simd<T, N> y, F f) {
+  Simd<T, N> out;
+  for (int i = 0; i < N; i++) {
+    out.value[i] = f(x.value[i], y.value[i]);
+  }
+  return out;
+}
+
+#define SIMD_HALF_UNARY(name)                   \
+  if constexpr (is_half_v<T>) {                 \
+    return Simd<T, N>(name(Simd<float, N>(v))); \
+  }
+
+#define SIMD_LANEWISE_UNARY(name, op)                    \
+  template <typename T, int N>                           \
+  MLX_SIMD_ALWAYS_INLINE Simd<T, N> name(Simd<T, N> v) { \
+    SIMD_HALF_UNARY(name)                                \
+    else {                                               \
+      return lanewise(v, [](auto x) { return op(x); });  \
+    }                                                    \
+  }
+
+SIMD_LANEWISE_UNARY(acos, std::acos)
+SIMD_LANEWISE_UNARY(acosh, std::acosh)
+SIMD_LANEWISE_UNARY(asin, std::asin)
+SIMD_LANEWISE_UNARY(asinh, std::asinh)
+SIMD_LANEWISE_UNARY(atan, std::atan)
+SIMD_LANEWISE_UNARY(atanh, std::atanh)
+SIMD_LANEWISE_UNARY(cosh, std::cosh)
+SIMD_LANEWISE_UNARY(expm1, std::expm1)
+SIMD_LANEWISE_UNARY(log, std::log)
+SIMD_LANEWISE_UNARY(log2, std::log2)
+SIMD_LANEWISE_UNARY(log10, std::log10)
+SIMD_LANEWISE_UNARY(log1p, std::log1p)
+SIMD_LANEWISE_UNARY(sinh, std::sinh)
+SIMD_LANEWISE_UNARY(tan, std::tan)
+SIMD_LANEWISE_UNARY(tanh, std::tanh)
+
+template <typename T, int N>
+MLX_SIMD_ALWAYS_INLINE Simd<T, N> operator-(Simd<T, N> v) {
+  SIMD_HALF_UNARY(operator-)
+  else {
+    return -v.value;
+  }
+}
+
+template <typename T, int N>
+MLX_SIMD_ALWAYS_INLINE Simd<T, N> operator~(Simd<T, N> v) {
+  return ~v.value;
+}
+
+template <typename T, int N>
+MLX_SIMD_ALWAYS_INLINE Simd<T, N> abs(Simd<T, N> v) {
+  SIMD_HALF_UNARY(abs)
+  else if constexpr (std::is_floating_point_v<T>) {
+    using M = mask_t<T, N>;
+    return (typename Simd<T, N>::vector_t)(
+        (M)v.value & std::numeric_limits<typename IntOf<sizeof(T)>::v>::max());
+  } else if constexpr (std::is_signed_v<T>) {
+    return (v.value < 0) ? -v.value : v.value;
+  } else {
+    return v;
+  }
+}
+
+// Round to integral values with the magic number trick. Values at or above
+// it are already integral, as are NaNs and infinities.
+template <typename T, int N>
+MLX_SIMD_ALWAYS_INLINE Simd<T, N> rint(Simd<T, N> v) {
+  SIMD_HALF_UNARY(rint)
+  else if constexpr (std::is_floating_point_v<T>) {
+    using M = mask_t<T, N>;
+    constexpr T magic = std::is_same_v<T, float> ? 0x1.0p23f : 0x1.0p52;
+    auto a = abs(v).value;
+    auto sign =
+        (M)v.value & ~std::numeric_limits<typename IntOf<sizeof(T)>::v>::max();
+    auto r = (typename Simd<T, N>::vector_t)((M)((a + magic) - magic) | sign);
+    return (a < magic) ? r : v.value;
+  } else {
+    return v;
+  }
+}
+
+template <typename T, int N>
+MLX_SIMD_ALWAYS_INLINE Simd<T, N> floor(Simd<T, N> v) {
+  SIMD_HALF_UNARY(floor)
+  else if constexpr (std::is_floating_point_v<T>) {
+    auto r = rint(v).value;
+    r = (r > v.value) ? r - 1 : r;
+    return r;
+  } else {
+    return v;
+  }
+}
+
+template <typename T, int N>
+MLX_SIMD_ALWAYS_INLINE Simd<T, N> ceil(Simd<T, N> v) {
+  SIMD_HALF_UNARY(ceil)
+  else if constexpr (std::is_floating_point_v<T>) {
+    using M = mask_t<T, N>;
+    auto r = rint(v).value;
+    r = (r < v.value) ? r + 1 : r;
+    // ceil(-0.5) is -0
+    auto sign =
+        (M)v.value & ~std::numeric_limits<typename IntOf<sizeof(T)>::v>::max();
+    return (typename Simd<T, N>::vector_t)((M)r | sign);
+  } else {
+    return v;
+  }
+}
+
+template <typename T, int N>
+MLX_SIMD_ALWAYS_INLINE Simd<T, N> sqrt(Simd<T, N> v) {
+  SIMD_HALF_UNARY(sqrt)
+  else if constexpr (std::is_same_v<T, float> && N % 4 == 0) {
+    typedef float v4 __attribute__((vector_size(16)));
+    Simd<T, N> out;
+    for (int i = 0; i < N; i += 4) {
+      v4 x;
+      std::memcpy(&x, reinterpret_cast<const float*>(&v.value) + i, 16);
+      x = __builtin_ia32_sqrtps(x);
+      std::memcpy(reinterpret_cast<float*>(&out.value) + i, &x, 16);
+    }
+    return out;
+  } else if constexpr (std::is_same_v<T, double> && N % 2 == 0) {
+    typedef double v2 __attribute__((vector_size(16)));
+    Simd<T, N> out;
+    for (int i = 0; i < N; i += 2) {
+      v2 x;
+      std::memcpy(&x, reinterpret_cast<const double*>(&v.value) + i, 16);
+      x = __builtin_ia32_sqrtpd(x);
+      std::memcpy(reinterpret_cast<double*>(&out.value) + i, &x, 16);
+    }
+    return out;
+  } else {
+    return lanewise(v, [](auto x) { return std::sqrt(x); });
+  }
+}
+
+template <typename T, int N>
+MLX_SIMD_ALWAYS_INLINE Simd<T, N> rsqrt(Simd<T, N> v) {
+  return T(1.0) / sqrt(v);
+}
+
+template <typename T, int N>
+MLX_SIMD_ALWAYS_INLINE Simd<T, N> recip(Simd<T, N> v) {
+  return T(1.0) / v;
+}
+
+template <typename T, int N>
+MLX_SIMD_ALWAYS_INLINE Simd<bool, N> isnan(Simd<T, N> v) {
+  if constexpr (is_half_v<T>) {
+    return isnan(Simd<float, N>(v));
+  } else {
+    return to_mask<N>(v.value != v.value);
+  }
+}
+
+template <typename T, int N>
+MLX_SIMD_ALWAYS_INLINE Simd<bool, N> operator!(Simd<T, N> v) {
+  if constexpr (is_half_v<T>) {
+    return !Simd<float, N>(v);
+  } else {
+    return to_mask<N>(v.value == 0);
+  }
+}
+
+#define SIMD_DEFAULT_BINARY(OP)                                         \
+  template <typename T, typename U, int N>                              \
+  MLX_SIMD_ALWAYS_INLINE Simd<T, N> operator OP(Simd<T, N> x, U y) {    \
+    if constexpr (is_half_v<T>) {                                       \
+      return Simd<T, N>(Simd<float, N>(x) OP static_cast<float>(y));    \
+    } else {                                                            \
+      return x.value OP static_cast<typename Simd<T, N>::scalar_t>(y);  \
+    }                                                                   \
+  }                                                                     \
+  template <typename T1, typename T2, int N>                            \
+  MLX_SIMD_ALWAYS_INLINE Simd<T2, N> operator OP(T1 x, Simd<T2, N> y) { \
+    if constexpr (is_half_v<T2>) {                                      \
+      return Simd<T2, N>(static_cast<float>(x) OP Simd<float, N>(y));   \
+    } else {                                                            \
+      return static_cast<typename Simd<T2, N>::scalar_t>(x) OP y.value; \
+    }                                                                   \
+  }                                                                     \
+  template <typename T1, typename T2, int N>                            \
+  MLX_SIMD_ALWAYS_INLINE Simd<T1, N> operator OP(                       \
+      Simd<T1, N> x, Simd<T2, N> y) {                                   \
+    if constexpr (is_half_v<T1>) {                                      \
+      return Simd<T1, N>(Simd<float, N>(x) OP Simd<float, N>(y));       \
+    } else {                                                            \
+      return x.value OP Simd<T1, N>(y).value;                           \
+    }                                                                   \
+  }
+
+SIMD_DEFAULT_BINARY(+)
+SIMD_DEFAULT_BINARY(-)
+SIMD_DEFAULT_BINARY(/)
+SIMD_DEFAULT_BINARY(*)
+SIMD_DEFAULT_BINARY(<<)
+SIMD_DEFAULT_BINARY(>>)
+SIMD_DEFAULT_BINARY(|)
+SIMD_DEFAULT_BINARY(^)
+SIMD_DEFAULT_BINARY(&)
+
+#define SIMD_LOGICAL_BINARY(OP, BITOP)                                       \
+  template <typename T1, typename T2, int N>                                 \
+  MLX_SIMD_ALWAYS_INLINE Simd<T1, N> operator OP(                            \
+      Simd<T1, N> x, Simd<T2, N> y) {                                        \
+    return Simd<T1, N>(                                                      \
+        Simd<bool, N>(Simd<bool, N>(x).value BITOP Simd<bool, N>(y).value)); \
+  }                                                                          \
+  template <typename T, typename U, int N>                                   \
+  MLX_SIMD_ALWAYS_INLINE Simd<T, N> operator OP(Simd<T, N> x, U y) {         \
+    return x OP Simd<T, N>(y);                                               \
+  }                                                                          \
+  template <typename T1, typename T2, int N>                                 \
+  MLX_SIMD_ALWAYS_INLINE Simd<T2, N> operator OP(T1 x, Simd<T2, N> y) {      \
+    return Simd<T2, N>(x) OP y;                                              \
+  }
+
+SIMD_LOGICAL_BINARY(&&, &)
+SIMD_LOGICAL_BINARY(||, |)
+
+#define SIMD_DEFAULT_COMPARISONS(OP)                                    \
+  template <int N, typename T1, typename T2>                            \
+  MLX_SIMD_ALWAYS_INLINE Simd<bool, N> operator OP(                     \
+      Simd<T1, N> a, Simd<T2, N> b) {                                   \
+    if constexpr (is_half_v<T1>) {                                      \
+      return Simd<float, N>(a) OP Simd<float, N>(b);                    \
+    } else {                                                            \
+      return to_mask<N>(a.value OP Simd<T1, N>(b).value);               \
+    }                                                                   \
+  }                                                                     \
+  template <int N, typename T, typename U>                              \
+  MLX_SIMD_ALWAYS_INLINE Simd<bool, N> operator OP(Simd<T, N> a, U b) { \
+    return a OP Simd<T, N>(b);                                          \
+  }                                                                     \
+  template <int N, typename T, typename U>                              \
+  MLX_SIMD_ALWAYS_INLINE Simd<bool, N> operator OP(T a, Simd<U, N> b) { \
+    return Simd<U, N>(a) OP b;                                          \
+  }
+
+SIMD_DEFAULT_COMPARISONS(>)
+SIMD_DEFAULT_COMPARISONS(<)
+SIMD_DEFAULT_COMPARISONS(>=)
+SIMD_DEFAULT_COMPARISONS(<=)
+SIMD_DEFAULT_COMPARISONS(==)
+SIMD_DEFAULT_COMPARISONS(!=)
+
+template <typename MaskT, typename T1, typename T2, int N>
+MLX_SIMD_ALWAYS_INLINE Simd<T1, N>
+select(Simd<MaskT, N> mask, Simd<T1, N> x, Simd<T2, N> y) {
+  static_assert(std::is_same_v<MaskT, bool>);
+  using S = typename Simd<T1, N>::scalar_t;
+  auto m = __builtin_convertvector(mask.value, mask_t<S, N>);
+  return m ? x.value : Simd<T1, N>(y).value;
+}
+
+template <typename T, int N>
+MLX_SIMD_ALWAYS_INLINE Simd<T, N> atan2(Simd<T, N> a, Simd<T, N> b) {
+  if constexpr (is_half_v<T>) {
+    return Simd<T, N>(atan2(Simd<float, N>(a), Simd<float, N>(b)));
+  } else {
+    return lanewise(a, b, [](auto x, auto y) { return std::atan2(x, y); });
+  }
+}
+
+// NaNs propagate from either argument like in base_simd.h
+template <typename T, int N>
+MLX_SIMD_ALWAYS_INLINE Simd<T, N> maximum(Simd<T, N> a, Simd<T, N> b) {
+  if constexpr (is_half_v<T>) {
+    return Simd<T, N>(maximum(Simd<float, N>(a), Simd<float, N>(b)));
+  } else if constexpr (std::is_integral_v<T>) {
+    return (a.value > b.value) ? a.value : b.value;
+  } else {
+    return ((a.value > b.value) | (a.value != a.value)) ? a.value : b.value;
+  }
+}
+
+template <typename T, int N>
+MLX_SIMD_ALWAYS_INLINE Simd<T, N> minimum(Simd<T, N> a, Simd<T, N> b) {
+  if constexpr (is_half_v<T>) {
+    return Simd<T, N>(minimum(Simd<float, N>(a), Simd<float, N>(b)));
+  } else if constexpr (std::is_integral_v<T>) {
+    return (a.value < b.value) ? a.value : b.value;
+  } else {
+    return ((a.value < b.value) | (a.value != a.value)) ? a.value : b.value;
+  }
+}
+
+template <typename T, int N>
+MLX_SIMD_ALWAYS_INLINE Simd<T, N> remainder(Simd<T, N> a, Simd<T, N> b) {
+  if constexpr (is_half_v<T>) {
+    return Simd<T, N>(remainder(Simd<float, N>(a), Simd<float, N>(b)));
+  } else {
+    Simd<T, N> r;
+    if constexpr (!std::is_integral_v<T>) {
+      r = lanewise(
+          a, b, [](auto x, auto y) { return std::remainder(x, y); });
+    } else {
+      r = a - b * (a / b);
+    }
+    if constexpr (std::is_signed_v<T>) {
+      auto mask = r != 0 && (r < 0 != b < 0);
+      r = select(mask, r + b, r);
+    }
+    return r;
+  }
+}
+
+template <typename T, int N>
+MLX_SIMD_ALWAYS_INLINE Simd<T, N> pow(Simd<T, N> base, Simd<T, N> exp) {
+  if constexpr (is_half_v<T>) {
+    return Simd<T, N>(pow(Simd<float, N>(base), Simd<float, N>(exp)));
+  } else if constexpr (!std::is_integral_v<T>) {
+    return lanewise(base, exp, [](auto x, auto y) { return std::pow(x, y); });
+  } else {
+    Simd<T, N> res = 1;
+    // Raising an integer to a negative power is undefined
+    if (any(exp < 0)) {
+      return 0;
+    }
+    while (any(exp > 0)) {
+      res = select((exp & 1) != 0, res * base, res);
+      base = select(exp > 0, base * base, base);
+      exp = exp >> 1;
+    }
+    return res;
+  }
+}
+
+template <typename T, int N>
+MLX_SIMD_ALWAYS_INLINE Simd<T, N>
+clamp(Simd<T, N> v, Simd<T, N> min, Simd<T, N> max) {
+  return select(v < min, min, select(max < v, max, v));
+}
+
+template <typename T, typename U, int N>
+MLX_SIMD_ALWAYS_INLINE Simd<T, N> fma(Simd<T, N> x, Simd<T, N> y, U z) {
+  if constexpr (is_half_v<T>) {
+    return Simd<T, N>(
+        fma(Simd<float, N>(x), Simd<float, N>(y), Simd<float, N>(z)));
+  } else {
+    return x.value * y.value + Simd<T, N>(z).value;
+  }
+}
+
+// Reductions
+
+template <typename T, int N>
+MLX_SIMD_ALWAYS_INLINE bool all(Simd<T, N> x) {
+  auto m = Simd<bool, N>(x);
+  for (int i = 0; i < N; i++) {
+    if (!m.value[i]) {
+      return false;
+    }
+  }
+  return true;
+}
+
+template <typename T, int N>
+MLX_SIMD_ALWAYS_INLINE bool any(Simd<T, N> x) {
+  auto m = Simd<bool, N>(x);
+  for (int i = 0; i < N; i++) {
+    if (m.value[i]) {
+      return true;
+    }
+  }
+  return false;
+}
+
+// Tree reductions over the two halves of the vector
+template <typename T, int N>
+MLX_SIMD_ALWAYS_INLINE Simd<T, N / 2> low_half(Simd<T, N> x) {
+  Simd<T, N / 2> out;
+  std::memcpy(&out.value, &x.value, sizeof(out.value));
+  return out;
+}
+
+template <typename T, int N>
+MLX_SIMD_ALWAYS_INLINE Simd<T, N / 2> high_half(Simd<T, N> x) {
+  Simd<T, N / 2> out;
+  std::memcpy(
+      &out.value,
+      reinterpret_cast<const char*>(&x.value) + sizeof(out.value),
+      sizeof(out.value));
+  return out;
+}
+
+template <typename T, int N>
+MLX_SIMD_ALWAYS_INLINE T sum(Simd<T, N> x) {
+  return sum(low_half(x) + high_half(x));
+}
+
+template <typename T, int N>
+MLX_SIMD_ALWAYS_INLINE T prod(Simd<T, N> x) {
+  return prod(low_half(x) * high_half(x));
+}
+
+template <typename T, int N>
+MLX_SIMD_ALWAYS_INLINE T max(Simd<T, N> x) {
+  return max(maximum(low_half(x), high_half(x)));
+}
+
+template <typename T, int N>
+MLX_SIMD_ALWAYS_INLINE T min(Simd<T, N> x) {
+  return min(minimum(low_half(x), high_half(x)));
+}
+
+} // namespace mlx::core::simd
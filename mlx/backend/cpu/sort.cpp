@@ -8,6 +8,7 @@
 #include "mlx/backend/common/utils.h"
 #include "mlx/backend/cpu/copy.h"
 #include "mlx/backend/cpu/encoder.h"
+#include "mlx/backend/cpu/parallel.h"
 #include "mlx/dtype_utils.h"
 #include "mlx/primitives.h"
 
@@ -121,18 +122,22 @@ void sort(array& out, int axis) {
   auto axis_size = out.shape(axis);
 
   // Perform sorting in place
-  ContiguousIterator src_it(
-      remaining_shape, remaining_strides, remaining_shape.size());
   auto out_ptr = out.data<T>();
-  for (int i = 0; i < n_rows; i++) {
-    T* data_ptr = out_ptr + src_it.loc;
-
-    StridedIterator st(data_ptr, axis_stride, 0);
-    StridedIterator ed(data_ptr, axis_stride, axis_size);
-
-    std::stable_sort(st, ed);
-    src_it.step();
-  }
+  cpu::parallel_for(
+      n_rows, cpu::row_grain(axis_size), [&](int64_t begin, int64_t end) {
+        ContiguousIterator src_it(
+            remaining_shape, remaining_strides, remaining_shape.size());
+        src_it.seek(begin);
+        for (int64_t i = begin; i < end; i++) {
+          T* data_ptr = out_ptr + src_it.loc;
+
+          StridedIterator st(data_ptr, axis_stride, 0);
+          StridedIterator ed(data_ptr, axis_stride, axis_size);
+
+          std::stable_sort(st, ed);
+          src_it.step();
+        }
+      });
 }
 
 template <typename T, typename IdxT = uint32_t>
@@ -158,35 +163,44 @@ void argsort(const array& in, array& out, int axis) {
   auto axis_size = in.shape(axis);
 
   // Perform sorting
-  ContiguousIterator in_it(
-      in_remaining_shape, in_remaining_strides, in_remaining_shape.size());
-  ContiguousIterator out_it(
-      out_remaining_shape, out_remaining_strides, out_remaining_shape.size());
   auto in_ptr = in.data<T>();
   auto out_ptr = out.data<IdxT>();
-  for (int i = 0; i < n_rows; i++) {
-    const T* data_ptr = in_ptr + in_it.loc;
-    IdxT* idx_ptr = out_ptr + out_it.loc;
-
-    in_it.step();
-    out_it.step();
-
-    StridedIterator st_(idx_ptr, out_stride, 0);
-    StridedIterator ed_(idx_ptr, out_stride, axis_size);
-
-    // Initialize with iota
-    std::iota(st_, ed_, IdxT(0));
-
-    // Sort according to vals
-    StridedIterator st(idx_ptr, out_stride, 0);
-    StridedIterator ed(idx_ptr, out_stride, axis_size);
-
-    std::stable_sort(st, ed, [data_ptr, in_stride](IdxT a, IdxT b) {
-      auto v1 = data_ptr[a * in_stride];
-      auto v2 = data_ptr[b * in_stride];
-      return v1 < v2 || (v1 == v2 && a < b);
-    });
-  }
+  cpu::parallel_for(
+      n_rows, cpu::row_grain(axis_size), [&](int64_t begin, int64_t end) {
+        ContiguousIterator in_it(
+            in_remaining_shape,
+            in_remaining_strides,
+            in_remaining_shape.size());
+        ContiguousIterator out_it(
+            out_remaining_shape,
+            out_remaining_strides,
+            out_remaining_shape.size());
+        in_it.seek(begin);
+        out_it.seek(begin);
+        for (int64_t i = begin; i < end; i++) {
+          const T* data_ptr = in_ptr + in_it.loc;
+          IdxT* idx_ptr = out_ptr + out_it.loc;
+
+          in_it.step();
+          out_it.step();
+
+          StridedIterator st_(idx_ptr, out_stride, 0);
+          StridedIterator ed_(idx_ptr, out_stride, axis_size);
+
+          // Initialize with iota
+          std::iota(st_, ed_, IdxT(0));
+
+          // Sort according to vals
+          StridedIterator st(idx_ptr, out_stride, 0);
+          StridedIterator ed(idx_ptr, out_stride, axis_size);
+
+          std::stable_sort(st, ed, [data_ptr, in_stride](IdxT a, IdxT b) {
+            auto v1 = data_ptr[a * in_stride];
+            auto v2 = data_ptr[b * in_stride];
+            return v1 < v2 || (v1 == v2 && a < b);
+          });
+        }
+      });
 }
 
 template <typename T>
@@ -208,19 +222,23 @@ void partition(array& out, int axis, int kth) {
   kth = kth < 0 ? kth + axis_size : kth;
 
   // Perform partition in place
-  ContiguousIterator src_it(
-      remaining_shape, remaining_strides, remaining_shape.size());
   auto out_ptr = out.data<T>();
-  for (int i = 0; i < n_rows; i++) {
-    T* data_ptr = out_ptr + src_it.loc;
-    src_it.step();
-
-    StridedIterator st(data_ptr, axis_stride, 0);
-    StridedIterator md(data_ptr, axis_stride, kth);
-    StridedIterator ed(data_ptr, axis_stride, axis_size);
-
-    std::nth_element(st, md, ed);
-  }
+  cpu::parallel_for(
+      n_rows, cpu::row_grain(axis_size), [&](int64_t begin, int64_t end) {
+        ContiguousIterator src_it(
+            remaining_shape, remaining_strides, remaining_shape.size());
+        src_it.seek(begin);
+        for (int64_t i = begin; i < end; i++) {
+          T* data_ptr = out_ptr + src_it.loc;
+          src_it.step();
+
+          StridedIterator st(data_ptr, axis_stride, 0);
+          StridedIterator md(data_ptr, axis_stride, kth);
+          StridedIterator ed(data_ptr, axis_stride, axis_size);
+
+          std::nth_element(st, md, ed);
+        }
+      });
 }
 
 template <typename T, typename IdxT = uint32_t>
@@ -248,37 +266,45 @@ void argpartition(const array& in, array& out, int axis, int kth) {
   kth = kth < 0 ? kth + axis_size : kth;
 
   // Perform partition
-  ContiguousIterator in_it(
-      in_remaining_shape, in_remaining_strides, in_remaining_shape.size());
-  ContiguousIterator out_it(
-      out_remaining_shape, out_remaining_strides, out_remaining_shape.size());
-
   auto in_ptr = in.data<T>();
   auto out_ptr = out.data<IdxT>();
 
-  for (int i = 0; i < n_rows; i++) {
-    const T* data_ptr = in_ptr + in_it.loc;
-    IdxT* idx_ptr = out_ptr + out_it.loc;
-    in_it.step();
-    out_it.step();
-
-    StridedIterator st_(idx_ptr, out_stride, 0);
-    StridedIterator ed_(idx_ptr, out_stride, axis_size);
-
-    // Initialize with iota
-    std::iota(st_, ed_, IdxT(0));
-
-    // Sort according to vals
-    StridedIterator st(idx_ptr, out_stride, 0);
-    StridedIterator md(idx_ptr, out_stride, kth);
-    StridedIterator ed(idx_ptr, out_stride, axis_size);
-
-    std::nth_element(st, md, ed, [data_ptr, in_stride](IdxT a, IdxT b) {
-      auto v1 = data_ptr[a * in_stride];
-      auto v2 = data_ptr[b * in_stride];
-      return v1 < v2 || (v1 == v2 && a < b);
-    });
-  }
+  cpu::parallel_for(
+      n_rows, cpu::row_grain(axis_size), [&](int64_t begin, int64_t end) {
+        ContiguousIterator in_it(
+            in_remaining_shape,
+            in_remaining_strides,
+            in_remaining_shape.size());
+        ContiguousIterator out_it(
+            out_remaining_shape,
+            out_remaining_strides,
+            out_remaining_shape.size());
+        in_it.seek(begin);
+        out_it.seek(begin);
+        for (int64_t i = begin; i < end; i++) {
+          const T* data_ptr = in_ptr + in_it.loc;
+          IdxT* idx_ptr = out_ptr + out_it.loc;
+          in_it.step();
+          out_it.step();
+
+          StridedIterator st_(idx_ptr, out_stride, 0);
+          StridedIterator ed_(idx_ptr, out_stride, axis_size);
+
+          // Initialize with iota
+          std::iota(st_, ed_, IdxT(0));
+
+          // Sort according to vals
+          StridedIterator st(idx_ptr, out_stride, 0);
+          StridedIterator md(idx_ptr, out_stride, kth);
+          StridedIterator ed(idx_ptr, out_stride, axis_size);
+
+          std::nth_element(st, md, ed, [data_ptr, in_stride](IdxT a, IdxT b) {
+            auto v1 = data_ptr[a * in_stride];
+            auto v2 = data_ptr[b * in_stride];
+            return v1 < v2 || (v1 == v2 && a < b);
+          });
+        }
+      });
 }
 
 } // namespace
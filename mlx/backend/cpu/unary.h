@@ -4,6 +4,8 @@
 
 #include "mlx/backend/common/unary.h"
 #include "mlx/backend/cpu/encoder.h"
+#include "mlx/backend/cpu/parallel.h"
+#include "mlx/backend/cpu/simd/dispatch.h"
 #include "mlx/backend/cpu/simd/simd.h"
 #include "mlx/utils.h"
 
@@ -23,20 +25,24 @@ void unary_op(const array& a, array& out, Op) {
   U* dst = out.data<U>();
   auto ndim = a.ndim();
   if (a.flags().contiguous) {
-    auto size = a.data_size();
-    constexpr int N = simd::max_size<T>;
-    while (size >= N) {
-      simd::store(dst, Op{}(simd::load<T, N>(src)));
-      size -= N;
-      src += N;
-      dst += N;
-    }
-    while (size > 0) {
-      *dst = Op{}(*src);
-      size--;
-      dst++;
-      src++;
-    }
+    cpu::parallel_for(a.data_size(), [src, dst](int64_t begin, int64_t end) {
+      auto a_ptr = src + begin;
+      auto out_ptr = dst + begin;
+      auto size = end - begin;
+      simd::dispatch<T>([&](auto n) {
+        constexpr int N = decltype(n)::value;
+        while (size >= N) {
+          simd::store(out_ptr, Op{}(simd::load<T, N>(a_ptr)));
+          size -= N;
+          a_ptr += N;
+          out_ptr += N;
+        }
+        if (size > 0) {
+          simd::store_partial(
+              out_ptr, Op{}(simd::load_partial<T, N>(a_ptr, size)), size);
+        }
+      });
+    });
   } else {
     size_t shape = ndim > 0 ? a.shape().back() : 1;
     size_t stride = ndim > 0 ? a.strides().back() : 1;
@@ -44,11 +50,19 @@ void unary_op(const array& a, array& out, Op) {
       unary_op<T, U, Op>(src, dst, shape, stride);
       return;
     }
-    auto it = ContiguousIterator(a.shape(), a.strides(), ndim - 1);
-    for (size_t elem = 0; elem < a.size(); elem += shape) {
-      unary_op<T, U, Op>(src + it.loc, dst + elem, shape, stride);
-      it.step();
+    if (shape == 0) {
+      return;
     }
+    int64_t n_rows = a.size() / shape;
+    cpu::parallel_for(
+        n_rows, cpu::row_grain(shape), [&](int64_t begin, int64_t end) {
+          auto it = ContiguousIterator(a.shape(), a.strides(), ndim - 1);
+          it.seek(begin);
+          for (int64_t r = begin; r < end; r++) {
+            unary_op<T, U, Op>(src + it.loc, dst + r * shape, shape, stride);
+            it.step();
+          }
+        });
   }
 }
 
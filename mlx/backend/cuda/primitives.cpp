@@ -41,6 +41,7 @@ NO_GPU_MULTI(Eigh)
 
 namespace distributed {
 NO_GPU_MULTI(AllGather)
+NO_GPU_MULTI(ReduceScatter)
 NO_GPU_MULTI(Send)
 NO_GPU_MULTI(Recv)
 } // namespace distributed
@@ -1,5 +1,6 @@
 // Copyright © 2025 Apple Inc.
 
+#include "mlx/backend/cpu/available.h"
 #include "mlx/backend/cuda/device.h"
 #include "mlx/backend/cuda/kernel_utils.cuh"
 #include "mlx/backend/cuda/reduce/reduce.cuh"
@@ -166,7 +167,7 @@ __global__ void rms_norm_vjp(
 namespace fast {
 
 bool RMSNorm::use_fallback(Stream s) {
-  return s.device == Device::cpu;
+  return s.device == Device::cpu && !cpu::is_available();
 }
 
 // TODO: There are duplicate code with backend/metal/normalization.cpp
@@ -1,5 +1,6 @@
 // Copyright © 2025 Apple Inc.
 
+#include "mlx/backend/cpu/available.h"
 #include "mlx/backend/cuda/device.h"
 #include "mlx/backend/cuda/kernel_utils.cuh"
 #include "mlx/backend/gpu/copy.h"
@@ -232,7 +233,7 @@ __global__ void rope_freqs(
 namespace fast {
 
 bool RoPE::use_fallback(Stream s) {
-  return s.device == Device::cpu;
+  return s.device == Device::cpu && !cpu::is_available();
 }
 
 void RoPE::eval_gpu(
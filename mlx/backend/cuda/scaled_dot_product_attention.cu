@@ -1,5 +1,6 @@
 // Copyright © 2025 Apple Inc.
 
+#include "mlx/backend/cpu/available.h"
 #include "mlx/backend/cuda/device.h"
 #include "mlx/backend/cuda/device/config.h"
 #include "mlx/backend/cuda/device/utils.cuh"
@@ -655,7 +656,7 @@ bool ScaledDotProductAttention::use_fallback(
     return true;
   }
   if (s.device == Device::cpu) {
-    return true;
+    return !cpu::is_available();
   }
 
   const int value_head_dim = v.shape(-1);
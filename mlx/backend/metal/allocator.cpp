@@ -201,6 +201,30 @@ size_t MetalAllocator::size(Buffer buffer) const {
   return static_cast<MTL::Buffer*>(buffer.ptr())->length();
 }
 
+Buffer MetalAllocator::make_buffer(void* ptr, size_t size) {
+  // Metal can only wrap page aligned memory without copying it
+  if (ptr == nullptr || size == 0 ||
+      reinterpret_cast<uintptr_t>(ptr) % vm_page_size != 0) {
+    return Buffer{nullptr};
+  }
+  size = vm_page_size * ((size + vm_page_size - 1) / vm_page_size);
+  if (size > device_->maxBufferLength()) {
+    return Buffer{nullptr};
+  }
+  auto pool = metal::new_scoped_memory_pool();
+  auto buf = device_->newBuffer(ptr, size, resource_options, nullptr);
+  return Buffer{static_cast<void*>(buf)};
+}
+
+void MetalAllocator::release(Buffer buffer) {
+  auto buf = static_cast<MTL::Buffer*>(buffer.ptr());
+  if (buf == nullptr) {
+    return;
+  }
+  auto pool = metal::new_scoped_memory_pool();
+  buf->release();
+}
+
 MetalAllocator& allocator() {
   // By creating the |allocator_| on heap, the destructor of MetalAllocator
   // will not be called on exit and buffers in the cache will be leaked. This
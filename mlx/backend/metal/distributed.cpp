@@ -22,6 +22,11 @@ void AllGather::eval_gpu(const std::vector<array>&, std::vector<array>&) {
   throw std::runtime_error("[AllGather::eval_gpu] has no GPU implementation.");
 }
 
+void ReduceScatter::eval_gpu(const std::vector<array>&, std::vector<array>&) {
+  throw std::runtime_error(
+      "[ReduceScatter::eval_gpu] has no GPU implementation.");
+}
+
 void Send::eval_gpu(const std::vector<array>&, std::vector<array>&) {
   throw std::runtime_error("[Send::eval_gpu] has no GPU implementation.");
 }
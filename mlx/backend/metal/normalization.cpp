@@ -1,6 +1,7 @@
 // Copyright © 2024 Apple Inc.
 #include <algorithm>
 
+#include "mlx/backend/cpu/available.h"
 #include "mlx/backend/gpu/copy.h"
 #include "mlx/backend/metal/device.h"
 #include "mlx/backend/metal/kernels/defines.h"
@@ -11,7 +12,7 @@
 namespace mlx::core::fast {
 
 bool RMSNorm::use_fallback(Stream s) {
-  return s.device == Device::cpu;
+  return s.device == Device::cpu && !cpu::is_available();
 }
 
 void RMSNorm::eval_gpu(
@@ -209,7 +210,7 @@ void RMSNormVJP::eval_gpu(
 }
 
 bool LayerNorm::use_fallback(Stream s) {
-  return s.device == Device::cpu;
+  return s.device == Device::cpu && !cpu::is_available();
 }
 
 void LayerNorm::eval_gpu(
@@ -1,4 +1,5 @@
 // Copyright © 2023-2024 Apple Inc.
+#include "mlx/backend/cpu/available.h"
 #include "mlx/backend/gpu/copy.h"
 #include "mlx/backend/metal/utils.h"
 #include "mlx/fast_primitives.h"
@@ -8,7 +9,7 @@ namespace mlx::core::fast {
 constexpr int n_per_thread = 4;
 
 bool RoPE::use_fallback(Stream s) {
-  return s.device == Device::cpu;
+  return s.device == Device::cpu && !cpu::is_available();
 }
 
 void RoPE::eval_gpu(
@@ -2,6 +2,7 @@
 #include <sstream>
 
 #include "mlx/backend/common/compiled.h"
+#include "mlx/backend/cpu/available.h"
 #include "mlx/backend/gpu/copy.h"
 #include "mlx/backend/metal/device.h"
 #include "mlx/backend/metal/kernels/steel/attn/params.h"
@@ -351,7 +352,7 @@ bool ScaledDotProductAttention::use_fallback(
     return true;
   }
   if (s.device == Device::cpu) {
-    return true;
+    return !cpu::is_available();
   }
 
   const int value_head_dim = v.shape(-1);
@@ -1,5 +1,6 @@
 // Copyright © 2023-2024 Apple Inc.
 
+#include "mlx/compile.h"
 #include "mlx/compile_impl.h"
 #include "mlx/primitives.h"
 
@@ -14,6 +15,18 @@ bool compile_available_for_device(const Device& device) {
 }
 } // namespace detail
 
+void set_cpu_async_compile(bool) {}
+
+CompileStats cpu_compile_stats() {
+  return CompileStats{};
+}
+
+void record_cpu_kernels(const std::string&) {}
+
+size_t prewarm_cpu_kernels(const std::string&) {
+  return 0;
+}
+
 void Compiled::eval_cpu(
     const std::vector<array>& inputs,
     std::vector<array>& outputs) {
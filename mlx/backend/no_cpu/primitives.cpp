@@ -129,6 +129,12 @@ NO_CPU(Inverse)
 NO_CPU(View)
 
 namespace fast {
+NO_CPU_MULTI(LayerNorm)
+NO_CPU_MULTI(LayerNormVJP)
+NO_CPU_MULTI(RMSNorm)
+NO_CPU_MULTI(RMSNormVJP)
+NO_CPU_MULTI(RoPE)
+NO_CPU_MULTI(ScaledDotProductAttention)
 NO_CPU_MULTI(Quantize)
 } // namespace fast
 
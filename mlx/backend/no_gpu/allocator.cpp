@@ -1,13 +1,21 @@
 // Copyright © 2023 Apple Inc.
 
 #include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdlib>
 #include <mutex>
+#include <new>
+#include <unordered_set>
+#include <vector>
 
 #include "mlx/allocator.h"
+#include "mlx/backend/common/buffer_cache.h"
 
 #ifdef __APPLE__
 #include "mlx/backend/no_gpu/apple_memory.h"
 #elif defined(__linux__)
+#include <sys/mman.h>
 #include "mlx/backend/no_gpu/linux_memory.h"
 #else
 size_t get_memory_size() {
@@ -19,12 +27,118 @@ namespace mlx::core {
 
 namespace allocator {
 
+namespace {
+
+// Allocations up to this size are rounded to a size class and cached in
+// per-thread magazines backed by global free lists. Larger allocations are
+// rounded to pages and cached in a BufferCache.
+constexpr size_t small_limit = 1 << 16;
+constexpr size_t page_size = 16384;
+
+// Allocations of at least this size are aligned to and advised as huge pages.
+constexpr size_t huge_page_size = 1 << 21;
+
+// Size classes are 16 bytes apart up to 128 bytes and then four per power of
+// two up to small_limit.
+constexpr int n_linear_classes = 8;
+constexpr int n_size_classes = n_linear_classes + 4 * 9;
+
+// The number of bytes each thread keeps per size class before returning
+// blocks to the global free lists.
+constexpr size_t magazine_bytes = 1 << 18;
+constexpr size_t max_magazine_blocks = 64;
+
+// Header in front of every allocation. Keeps the data 16 byte aligned.
+struct alignas(16) Block {
+  size_t size;
+  int size_class;
+};
+
+// Size class of blocks wrapping external memory. The pointer to the memory
+// is stored right after the header.
+constexpr int external_class = -2;
+
+int size_class(size_t size) {
+  if (size <= 128) {
+    return size <= 16 ? 0 : (size - 1) / 16;
+  }
+  int log = 7;
+  while ((size_t(1) << (log + 1)) < size) {
+    log++;
+  }
+  int sub = ((size - 1) >> (log - 2)) & 3;
+  return n_linear_classes + 4 * (log - 7) + sub;
+}
+
+size_t class_size(int c) {
+  if (c < n_linear_classes) {
+    return 16 * (c + 1);
+  }
+  int log = (c - n_linear_classes) / 4 + 7;
+  int sub = (c - n_linear_classes) % 4;
+  return (size_t(1) << log) + (sub + 1) * (size_t(1) << (log - 2));
+}
+
+// The size of a large block holding size bytes. Blocks backed by huge pages
+// are rounded to whole huge pages so the buffer cache looks them up by the
+// same size they are stored under.
+size_t large_block_size(size_t size) {
+  size = page_size * ((size + page_size - 1) / page_size);
+#if defined(__linux__)
+  size_t total = size + sizeof(Block);
+  if (total >= huge_page_size) {
+    total = huge_page_size * ((total + huge_page_size - 1) / huge_page_size);
+    size = total - sizeof(Block);
+  }
+#endif
+  return size;
+}
+
+size_t magazine_capacity(int c) {
+  return std::clamp<size_t>(
+      magazine_bytes / class_size(c), 4, max_magazine_blocks);
+}
+
+Block* system_malloc(size_t size, int size_class) {
+  void* ptr = nullptr;
+  size_t total = size + sizeof(Block);
+#if defined(__linux__)
+  if (total >= huge_page_size) {
+    if (posix_memalign(&ptr, huge_page_size, total) != 0) {
+      ptr = nullptr;
+    } else {
+      madvise(ptr, total, MADV_HUGEPAGE);
+    }
+  } else {
+    ptr = std::malloc(total);
+  }
+#else
+  ptr = std::malloc(total);
+#endif
+  if (ptr == nullptr) {
+    return nullptr;
+  }
+  return new (ptr) Block{size, size_class};
+}
+
+void system_free(Block* block) {
+  std::free(block);
+}
+
+size_t block_size(Block* block) {
+  return block->size;
+}
+
+} // namespace
+
 class CommonAllocator : public Allocator {
-  /** A general CPU allocator. */
+  /** A general CPU allocator with a size-class cache. */
  public:
   virtual Buffer malloc(size_t size) override;
   virtual void free(Buffer buffer) override;
   virtual size_t size(Buffer buffer) const override;
+  virtual Buffer make_buffer(void* ptr, size_t size) override;
+  virtual void release(Buffer buffer) override;
   size_t get_active_memory() const {
     return active_memory_;
   };
@@ -32,35 +146,98 @@ class CommonAllocator : public Allocator {
     return peak_memory_;
   };
   void reset_peak_memory() {
-    std::unique_lock lk(mutex_);
     peak_memory_ = 0;
   };
   size_t get_memory_limit() {
     return memory_limit_;
   }
   size_t set_memory_limit(size_t limit) {
-    std::unique_lock lk(mutex_);
-    std::swap(memory_limit_, limit);
-    return limit;
+    return memory_limit_.exchange(limit);
+  }
+  size_t get_cache_memory() const {
+    return small_cache_memory_ + large_cache_memory_;
   }
+  size_t set_cache_limit(size_t limit);
+  void clear_cache();
 
  private:
-  size_t memory_limit_;
-  size_t active_memory_{0};
-  size_t peak_memory_{0};
+  // Blocks cached by a single thread. The mutex is only contended when
+  // another thread clears the cache.
+  struct Magazine {
+    explicit Magazine(bool& destroyed);
+    ~Magazine();
+    std::mutex mutex;
+    std::array<std::vector<Block*>, n_size_classes> blocks;
+    bool& destroyed;
+  };
+
+  // The magazine of the calling thread or nullptr once it has been destroyed
+  // during thread exit.
+  static Magazine* magazine() {
+    static thread_local bool destroyed_ = false;
+    if (destroyed_) {
+      return nullptr;
+    }
+    static thread_local Magazine magazine_(destroyed_);
+    return &magazine_;
+  }
+
+  Block* malloc_small(size_t size);
+  Block* malloc_large(size_t size);
+  void free_small(Block* block);
+  void free_large(Block* block);
+
+  // Move blocks between a magazine and the global free lists. Must be called
+  // with the magazine locked.
+  void refill(Magazine& mag, int c);
+  void flush(Magazine& mag, int c, size_t keep);
+
+  // Move the blocks of every magazine to the global free lists
+  void flush_magazines();
+
+  // Return cached memory to the system until at least min_bytes are freed.
+  // Blocks held in magazines are flushed first so they can be freed too.
+  void release_cached(size_t min_bytes);
+
+  void add_active(size_t size) {
+    auto active = active_memory_.fetch_add(size) + size;
+    auto peak = peak_memory_.load();
+    while (active > peak && !peak_memory_.compare_exchange_weak(peak, active))
+      ;
+  }
+
+  std::atomic<size_t> memory_limit_;
+  std::atomic<size_t> max_pool_size_;
+  std::atomic<size_t> active_memory_{0};
+  std::atomic<size_t> peak_memory_{0};
+  std::atomic<size_t> small_cache_memory_{0};
+  std::atomic<size_t> large_cache_memory_{0};
+
+  // Guards the global free lists and the buffer cache
   std::mutex mutex_;
-  CommonAllocator() : memory_limit_(0.8 * get_memory_size()) {
+  std::array<std::vector<Block*>, n_size_classes> free_lists_;
+  BufferCache<Block> buffer_cache_;
+
+  // Guards the set of live magazines
+  std::mutex magazines_mutex_;
+  std::unordered_set<Magazine*> magazines_;
+
+  CommonAllocator()
+      : memory_limit_(0.8 * get_memory_size()),
+        buffer_cache_(page_size, block_size, system_free) {
     if (memory_limit_ == 0) {
       memory_limit_ = 1UL << 33;
     }
+    max_pool_size_ = memory_limit_.load();
   };
 
   friend CommonAllocator& common_allocator();
 };
 
 CommonAllocator& common_allocator() {
-  static CommonAllocator allocator_;
-  return allocator_;
+  // Leaked so that thread local magazines can be flushed at any time
+  static CommonAllocator* allocator_ = new CommonAllocator;
+  return *allocator_;
 }
 
 Allocator& allocator() {
@@ -71,32 +248,208 @@ void* Buffer::raw_ptr() {
   if (!ptr_) {
     return nullptr;
   }
-  return static_cast<size_t*>(ptr_) + 1;
+  auto block = static_cast<Block*>(ptr_);
+  if (block->size_class == external_class) {
+    return *reinterpret_cast<void**>(block + 1);
+  }
+  return block + 1;
+}
+
+CommonAllocator::Magazine::Magazine(bool& destroyed) : destroyed(destroyed) {
+  auto& alloc = common_allocator();
+  std::lock_guard lk(alloc.magazines_mutex_);
+  alloc.magazines_.insert(this);
+}
+
+CommonAllocator::Magazine::~Magazine() {
+  auto& alloc = common_allocator();
+  std::lock_guard lk(alloc.magazines_mutex_);
+  alloc.magazines_.erase(this);
+  std::lock_guard mlk(mutex);
+  for (int c = 0; c < n_size_classes; ++c) {
+    alloc.flush(*this, c, 0);
+  }
+  destroyed = true;
+}
+
+void CommonAllocator::refill(Magazine& mag, int c) {
+  std::lock_guard lk(mutex_);
+  auto& src = free_lists_[c];
+  size_t n = std::min(src.size(), magazine_capacity(c) / 2 + 1);
+  mag.blocks[c].insert(mag.blocks[c].end(), src.end() - n, src.end());
+  src.resize(src.size() - n);
+}
+
+void CommonAllocator::flush(Magazine& mag, int c, size_t keep) {
+  auto& src = mag.blocks[c];
+  if (src.size() <= keep) {
+    return;
+  }
+  std::lock_guard lk(mutex_);
+  free_lists_[c].insert(free_lists_[c].end(), src.begin() + keep, src.end());
+  src.resize(keep);
+}
+
+void CommonAllocator::flush_magazines() {
+  std::lock_guard lk(magazines_mutex_);
+  for (auto mag : magazines_) {
+    std::lock_guard mlk(mag->mutex);
+    for (int c = 0; c < n_size_classes; ++c) {
+      flush(*mag, c, 0);
+    }
+  }
+}
+
+void CommonAllocator::release_cached(size_t min_bytes) {
+  flush_magazines();
+  std::lock_guard lk(mutex_);
+  size_t freed = large_cache_memory_;
+  buffer_cache_.release_cached_buffers(min_bytes);
+  large_cache_memory_ = buffer_cache_.cache_size();
+  freed -= large_cache_memory_;
+  for (int c = n_size_classes - 1; c >= 0 && freed < min_bytes; --c) {
+    auto sz = class_size(c);
+    for (auto block : free_lists_[c]) {
+      system_free(block);
+    }
+    freed += sz * free_lists_[c].size();
+    small_cache_memory_ -= sz * free_lists_[c].size();
+    free_lists_[c].clear();
+  }
+}
+
+Block* CommonAllocator::malloc_small(size_t size) {
+  int c = size_class(size);
+  Block* block = nullptr;
+  if (auto mag = magazine(); mag) {
+    std::lock_guard lk(mag->mutex);
+    if (mag->blocks[c].empty()) {
+      refill(*mag, c);
+    }
+    if (!mag->blocks[c].empty()) {
+      block = mag->blocks[c].back();
+      mag->blocks[c].pop_back();
+    }
+  } else {
+    std::lock_guard lk(mutex_);
+    if (!free_lists_[c].empty()) {
+      block = free_lists_[c].back();
+      free_lists_[c].pop_back();
+    }
+  }
+  if (block) {
+    small_cache_memory_ -= block->size;
+    return block;
+  }
+  return system_malloc(class_size(c), c);
+}
+
+Block* CommonAllocator::malloc_large(size_t size) {
+  size = large_block_size(size);
+  {
+    std::lock_guard lk(mutex_);
+    if (auto block = buffer_cache_.reuse_from_cache(size)) {
+      large_cache_memory_ = buffer_cache_.cache_size();
+      return block;
+    }
+  }
+  return system_malloc(size, -1);
 }
 
 Buffer CommonAllocator::malloc(size_t size) {
-  void* ptr = std::malloc(size + sizeof(size_t));
-  if (ptr != nullptr) {
-    *static_cast<size_t*>(ptr) = size;
+  Block* block = size <= small_limit ? malloc_small(size) : malloc_large(size);
+
+  if (block == nullptr) {
+    // Give the cache back to the system and try once more
+    clear_cache();
+    block = size <= small_limit ? malloc_small(size) : malloc_large(size);
+    if (block == nullptr) {
+      return Buffer{nullptr};
+    }
+  }
+  add_active(block->size);
+
+  // If we have a lot of memory pressure try to reclaim memory from the cache
+  size_t mem_required = get_active_memory() + get_cache_memory();
+  if (mem_required > memory_limit_ && get_cache_memory() > 0) {
+    release_cached(mem_required - memory_limit_);
+  }
+  return Buffer{block};
+}
+
+void CommonAllocator::free_small(Block* block) {
+  int c = block->size_class;
+  small_cache_memory_ += block->size;
+  auto mag = magazine();
+  if (!mag) {
+    std::lock_guard lk(mutex_);
+    free_lists_[c].push_back(block);
+    return;
   }
-  std::unique_lock lk(mutex_);
-  active_memory_ += size;
-  peak_memory_ = std::max(active_memory_, peak_memory_);
-  return Buffer{ptr};
+  std::lock_guard lk(mag->mutex);
+  mag->blocks[c].push_back(block);
+  if (mag->blocks[c].size() > magazine_capacity(c)) {
+    flush(*mag, c, magazine_capacity(c) / 2);
+  }
+}
+
+void CommonAllocator::free_large(Block* block) {
+  std::lock_guard lk(mutex_);
+  buffer_cache_.recycle_to_cache(block);
+  large_cache_memory_ = buffer_cache_.cache_size();
 }
 
 void CommonAllocator::free(Buffer buffer) {
-  auto sz = size(buffer);
-  std::free(buffer.ptr());
-  std::unique_lock lk(mutex_);
-  active_memory_ -= sz;
+  auto block = static_cast<Block*>(buffer.ptr());
+  if (block == nullptr) {
+    return;
+  }
+  if (block->size_class == external_class) {
+    release(buffer);
+    return;
+  }
+  active_memory_ -= block->size;
+  if (get_cache_memory() + block->size > max_pool_size_) {
+    system_free(block);
+  } else if (block->size_class >= 0) {
+    free_small(block);
+  } else {
+    free_large(block);
+  }
 }
 
 size_t CommonAllocator::size(Buffer buffer) const {
   if (buffer.ptr() == nullptr) {
     return 0;
   }
-  return *static_cast<size_t*>(buffer.ptr());
+  return static_cast<const Block*>(buffer.ptr())->size;
+}
+
+Buffer CommonAllocator::make_buffer(void* ptr, size_t size) {
+  void* header = std::malloc(sizeof(Block) + sizeof(void*));
+  if (header == nullptr) {
+    return Buffer{nullptr};
+  }
+  auto block = new (header) Block{size, external_class};
+  *reinterpret_cast<void**>(block + 1) = ptr;
+  return Buffer{block};
+}
+
+void CommonAllocator::release(Buffer buffer) {
+  std::free(buffer.ptr());
+}
+
+size_t CommonAllocator::set_cache_limit(size_t limit) {
+  limit = max_pool_size_.exchange(limit);
+  auto cache_memory = get_cache_memory();
+  if (cache_memory > max_pool_size_) {
+    release_cached(cache_memory - max_pool_size_);
+  }
+  return limit;
+}
+
+void CommonAllocator::clear_cache() {
+  release_cached(get_cache_memory());
 }
 
 } // namespace allocator
@@ -116,17 +469,19 @@ size_t set_memory_limit(size_t limit) {
 size_t get_memory_limit() {
   return allocator::common_allocator().get_memory_limit();
 }
-
-// No-ops for common allocator
 size_t get_cache_memory() {
-  return 0;
+  return allocator::common_allocator().get_cache_memory();
 }
-size_t set_cache_limit(size_t) {
-  return 0;
+size_t set_cache_limit(size_t limit) {
+  return allocator::common_allocator().set_cache_limit(limit);
+}
+void clear_cache() {
+  allocator::common_allocator().clear_cache();
 }
+
+// No-op for common allocator
 size_t set_wired_limit(size_t) {
   return 0;
 }
-void clear_cache() {}
 
 } // namespace mlx::core
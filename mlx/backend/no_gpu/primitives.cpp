@@ -3,6 +3,7 @@
 #include "mlx/primitives.h"
 #include "mlx/distributed/primitives.h"
 #include "mlx/fast_primitives.h"
+#include "mlx/transforms_impl.h"
 
 #define NO_GPU_MULTI(func)                                             \
   void func::eval_gpu(                                                 \
@@ -10,9 +11,9 @@
     throw std::runtime_error(#func " has no GPU implementation.");     \
   }
 
-#define NO_GPU_USE_FALLBACK(func)     \
+#define NO_GPU_USE_CPU(func)          \
   bool func::use_fallback(Stream s) { \
-    return true;                      \
+    return false;                     \
   }                                   \
   NO_GPU_MULTI(func)
 
@@ -31,7 +32,7 @@ bool fast::ScaledDotProductAttention::use_fallback(
     bool has_arr_mask,
     bool do_causal,
     Stream s) {
-  return true;
+  return detail::in_grad_tracing();
 }
 
 NO_GPU(Abs)
@@ -148,11 +149,11 @@ NO_GPU_MULTI(Eig)
 NO_GPU(View)
 
 namespace fast {
-NO_GPU_USE_FALLBACK(LayerNorm)
+NO_GPU_USE_CPU(LayerNorm)
 NO_GPU_MULTI(LayerNormVJP)
-NO_GPU_USE_FALLBACK(RMSNorm)
+NO_GPU_USE_CPU(RMSNorm)
 NO_GPU_MULTI(RMSNormVJP)
-NO_GPU_USE_FALLBACK(RoPE)
+NO_GPU_USE_CPU(RoPE)
 NO_GPU(ScaledDotProductAttention)
 NO_GPU_MULTI(Quantize)
 NO_GPU_MULTI(CustomKernel)
@@ -161,6 +162,7 @@ NO_GPU_MULTI(CustomKernel)
 namespace distributed {
 NO_GPU_MULTI(AllReduce)
 NO_GPU_MULTI(AllGather)
+NO_GPU_MULTI(ReduceScatter)
 NO_GPU_MULTI(Send)
 NO_GPU_MULTI(Recv)
 } // namespace distributed
@@ -0,0 +1,296 @@
+// Copyright © 2025 Apple Inc.
+
+#include <optional>
+#include <unordered_map>
+#include <unordered_set>
+
+#include "mlx/backend/cpu/eval.h"
+#include "mlx/backend/gpu/eval.h"
+#include "mlx/compile.h"
+#include "mlx/compile_impl.h"
+#include "mlx/event.h"
+#include "mlx/fence.h"
+#include "mlx/memory.h"
+#include "mlx/primitives.h"
+#include "mlx/scheduler.h"
+#include "mlx/transforms.h"
+
+namespace mlx::core {
+
+namespace {
+
+static constexpr int MAX_ACTIVE_TASKS = 10;
+
+// Arrays of a replay live in slots: the inputs first and then the constants
+// of the graph and the outputs of each step in the order of the tape.
+struct CaptureStep {
+  std::shared_ptr<Primitive> primitive;
+  std::vector<int> inputs;
+  std::vector<int> outputs;
+  std::vector<Shape> shapes;
+  std::vector<Dtype> dtypes;
+  // Slots last read by this step
+  std::vector<int> release;
+};
+
+struct CaptureEntry {
+  CaptureEntry(Stream stream) : stream(stream) {}
+
+  Stream stream;
+  std::vector<Shape> shapes;
+  std::vector<Dtype> dtypes;
+
+  std::vector<array> constants;
+  std::vector<int> constant_slots;
+  std::vector<CaptureStep> steps;
+  std::vector<int> outputs;
+  int n_slots{0};
+  // Slots which are read from other streams keep the stream they are
+  // computed on
+  std::vector<int> fence_stream;
+  // Slots which are read by a step or returned
+  std::vector<bool> used;
+};
+
+bool is_load(const array& a) {
+  return a.has_primitive() && typeid(a.primitive()) == typeid(Load);
+}
+
+void record(
+    CaptureEntry& entry,
+    const std::function<std::vector<array>(const std::vector<array>&)>& fun,
+    const std::vector<array>& inputs) {
+  auto [trace_inputs, tape, trace_outputs] =
+      detail::compile_build(fun, inputs, /* shapeless = */ false);
+
+  std::unordered_map<std::uintptr_t, int> slot;
+  for (auto& in : trace_inputs) {
+    slot.emplace(in.id(), entry.n_slots++);
+  }
+  for (auto& a : tape) {
+    if (slot.find(a.id()) != slot.end()) {
+      continue;
+    }
+    if (!a.has_primitive() || is_load(a)) {
+      entry.constants.push_back(a);
+      entry.constant_slots.push_back(entry.n_slots);
+      slot.emplace(a.id(), entry.n_slots++);
+      continue;
+    }
+    CaptureStep step;
+    step.primitive = a.primitive_ptr();
+    for (auto& in : a.inputs()) {
+      step.inputs.push_back(slot.at(in.id()));
+    }
+    for (auto& o : a.outputs()) {
+      step.outputs.push_back(entry.n_slots);
+      step.shapes.push_back(o.shape());
+      step.dtypes.push_back(o.dtype());
+      slot.emplace(o.id(), entry.n_slots++);
+    }
+    entry.steps.push_back(std::move(step));
+  }
+  for (auto& o : trace_outputs) {
+    entry.outputs.push_back(slot.at(o.id()));
+  }
+
+  // Loads become constants after their first eval
+  eval(entry.constants);
+
+  std::vector<int> producer_stream(entry.n_slots, -1);
+  std::vector<int> last_use(entry.n_slots, -1);
+  entry.fence_stream.assign(entry.n_slots, -1);
+  entry.used.assign(entry.n_slots, false);
+  for (int i = 0; i < entry.steps.size(); i++) {
+    auto& step = entry.steps[i];
+    auto stream = step.primitive->stream().index;
+    for (auto in : step.inputs) {
+      last_use[in] = i;
+      entry.used[in] = true;
+      if (producer_stream[in] >= 0 && producer_stream[in] != stream) {
+        entry.fence_stream[in] = producer_stream[in];
+      }
+    }
+    for (auto out : step.outputs) {
+      producer_stream[out] = stream;
+    }
+  }
+  for (auto out : entry.outputs) {
+    last_use[out] = -1;
+    entry.used[out] = true;
+  }
+  for (int s = 0; s < entry.n_slots; s++) {
+    if (last_use[s] >= 0) {
+      entry.steps[last_use[s]].release.push_back(s);
+    }
+  }
+}
+
+std::vector<array> replay(
+    const CaptureEntry& entry,
+    const std::vector<array>& inputs) {
+  std::vector<std::optional<array>> slots(entry.n_slots);
+  for (int i = 0; i < inputs.size(); i++) {
+    slots[i] = inputs[i];
+  }
+  for (int i = 0; i < entry.constants.size(); i++) {
+    slots[entry.constant_slots[i]] = entry.constants[i];
+  }
+
+  std::unordered_map<uint32_t, Fence> fences;
+  std::unordered_map<uint32_t, Event> events;
+  std::unordered_set<int> open_streams;
+  std::vector<int> produced_on(entry.n_slots, -1);
+
+  for (auto& step : entry.steps) {
+    auto stream = step.primitive->stream();
+    open_streams.insert(stream.index);
+
+    std::vector<array> step_inputs;
+    step_inputs.reserve(step.inputs.size());
+    for (auto in : step.inputs) {
+      auto& a = *slots[in];
+      if (int s = entry.fence_stream[in]; s >= 0) {
+        fences[s].wait(stream, a);
+      } else if (a.event().valid()) {
+        if (a.event().is_signaled()) {
+          a.detach_event();
+        } else if (a.event().stream() != stream) {
+          // Use event to wait across async eval
+          a.event().wait(stream);
+        }
+      }
+      step_inputs.push_back(a);
+    }
+    // Let the step donate inputs it reads last
+    for (auto in : step.release) {
+      slots[in].reset();
+    }
+
+    auto outputs = array::make_arrays(
+        step.shapes, step.dtypes, step.primitive, std::move(step_inputs));
+    auto& arr = outputs[0];
+    if (stream.device == Device::gpu) {
+      gpu::eval(arr);
+    } else {
+      cpu::eval(arr);
+    }
+
+    if (scheduler::n_active_tasks() > MAX_ACTIVE_TASKS ||
+        (get_active_memory() > get_memory_limit() &&
+         scheduler::n_active_tasks() > 0)) {
+      // Commit any open streams
+      for (auto i : open_streams) {
+        auto s = get_stream(i);
+        if (s.device == Device::gpu) {
+          gpu::finalize(s);
+        }
+      }
+      scheduler::wait_for_one();
+      while (get_active_memory() > get_memory_limit() &&
+             scheduler::n_active_tasks() > 0) {
+        scheduler::wait_for_one();
+      }
+    }
+
+    for (int i = 0; i < outputs.size(); i++) {
+      auto out = step.outputs[i];
+      outputs[i].set_status(array::Status::evaluated);
+      if (entry.fence_stream[out] >= 0) {
+        auto it = fences.find(stream.index);
+        if (it == fences.end()) {
+          it = fences.emplace(stream.index, Fence{stream}).first;
+        }
+        it->second.update(stream, outputs[i]);
+      }
+      produced_on[out] = stream.index;
+    }
+    arr.detach();
+    for (int i = 0; i < outputs.size(); i++) {
+      if (entry.used[step.outputs[i]]) {
+        slots[step.outputs[i]] = std::move(outputs[i]);
+      }
+    }
+  }
+
+  // The outputs are available once the event of their stream is signaled
+  std::vector<array> outputs;
+  for (auto out : entry.outputs) {
+    auto& a = *slots[out];
+    if (auto s = produced_on[out]; s >= 0) {
+      auto e = events.find(s);
+      if (e == events.end()) {
+        e = events.emplace(s, Event{get_stream(s)}).first;
+        e->second.set_value(1);
+      }
+      a.attach_event(e->second);
+    }
+    outputs.push_back(a);
+  }
+  for (auto i : open_streams) {
+    auto s = get_stream(i);
+    if (auto e = events.find(i); e != events.end()) {
+      e->second.signal(s);
+    }
+    if (s.device == Device::gpu) {
+      gpu::finalize(s);
+    }
+  }
+  return outputs;
+}
+
+} // namespace
+
+std::function<std::vector<array>(const std::vector<array>&)> capture(
+    std::function<std::vector<array>(const std::vector<array>&)> fun) {
+  if (!fun) {
+    throw std::invalid_argument(
+        "[capture] Cannot capture a function without a target.");
+  }
+  auto entries = std::make_shared<std::vector<CaptureEntry>>();
+  return [fun = std::move(fun), entries](const std::vector<array>& inputs) {
+    // If the inputs are tracers, trace the original graph
+    if (std::any_of(inputs.begin(), inputs.end(), [](auto& in) {
+          return in.is_tracer();
+        })) {
+      return fun(inputs);
+    }
+
+    std::vector<array> pending;
+    for (auto& in : inputs) {
+      if (in.status() == array::Status::unscheduled) {
+        pending.push_back(in);
+      }
+    }
+    async_eval(std::move(pending));
+
+    // Recordings depend on the default stream, the shapes and the dtypes
+    auto stream = default_stream(default_device());
+    auto matches = [&](const CaptureEntry& entry) {
+      if (entry.stream != stream || entry.shapes.size() != inputs.size()) {
+        return false;
+      }
+      for (int i = 0; i < inputs.size(); i++) {
+        if (entry.shapes[i] != inputs[i].shape() ||
+            entry.dtypes[i] != inputs[i].dtype()) {
+          return false;
+        }
+      }
+      return true;
+    };
+    auto it = std::find_if(entries->begin(), entries->end(), matches);
+    if (it == entries->end()) {
+      CaptureEntry entry(stream);
+      for (auto& in : inputs) {
+        entry.shapes.push_back(in.shape());
+        entry.dtypes.push_back(in.dtype());
+      }
+      record(entry, fun, inputs);
+      entries->push_back(std::move(entry));
+      it = entries->end() - 1;
+    }
+    return replay(*it, inputs);
+  };
+}
+
+} // namespace mlx::core
@@ -928,6 +928,35 @@ bool skip_compile() {
       !(compile_available_for_device(default_device()));
 }
 
+std::tuple<std::vector<array>, std::vector<array>, std::vector<array>>
+compile_build(
+    const std::function<std::vector<array>(const std::vector<array>&)>& fun,
+    const std::vector<array>& inputs,
+    bool shapeless) {
+  // Trace to build the graph
+  auto [trace_inputs, trace_outputs] = compile_trace(fun, inputs, shapeless);
+
+  // DFS the graph and get a tape, and a map of array id to (parent,
+  // position in parent inputs)
+  auto [tape, parents_map] = compile_dfs(trace_inputs, trace_outputs, inputs);
+
+  if (skip_compile()) {
+    return {std::move(trace_inputs), std::move(tape), std::move(trace_outputs)};
+  }
+
+  // Simplify the tape
+  if (compile_mode() != CompileMode::no_simplify) {
+    compile_simplify(tape, parents_map, trace_outputs, /* passes */ 3);
+  }
+
+  // Kernel fusion to generate Compiled primitives. The tape and
+  // new outputs must be updated accordingly
+  if (compile_mode() != CompileMode::no_fuse) {
+    compile_fuse(tape, parents_map, trace_inputs, trace_outputs);
+  }
+  return {std::move(trace_inputs), std::move(tape), std::move(trace_outputs)};
+}
+
 std::function<std::vector<array>(const std::vector<array>&)> compile(
     std::function<std::vector<array>(const std::vector<array>&)> fun,
     std::uintptr_t fun_id,
@@ -961,28 +990,8 @@ std::function<std::vector<array>(const std::vector<array>&)> compile(
       entry.empty = false;
       // Set the constants
       entry.constants = std::move(constants);
-      // Trace to build the graph
-      std::tie(entry.inputs, entry.outputs) =
-          compile_trace(fun, inputs, shapeless);
-
-      // DFS the graph and get a tape, and a map of array id to (parent,
-      // position in parent inputs)
-      std::unordered_map<uintptr_t, std::vector<std::pair<array, int>>>
-          parents_map;
-      std::tie(entry.tape, parents_map) =
-          compile_dfs(entry.inputs, entry.outputs, inputs);
-
-      // Simplify the tape
-      if (compile_mode() != CompileMode::no_simplify) {
-        compile_simplify(
-            entry.tape, parents_map, entry.outputs, /* passes */ 3);
-      }
-
-      // Kernel fusion to generate Compiled primitives. The tape and
-      // new outputs must be updated accordingly
-      if (compile_mode() != CompileMode::no_fuse) {
-        compile_fuse(entry.tape, parents_map, entry.inputs, entry.outputs);
-      }
+      std::tie(entry.inputs, entry.tape, entry.outputs) =
+          compile_build(fun, inputs, shapeless);
     }
 
     // At this point we must have a tape, now replace the placeholders
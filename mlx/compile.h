@@ -28,6 +28,20 @@ std::function<std::vector<array>(const std::vector<array>&)> compile(
   return compile(+f, shapeless);
 }
 
+/** Capture a function for replay.
+ *
+ * The first call with inputs of a given shape and dtype compiles the function
+ * and records how its graph is evaluated: the primitives in execution order,
+ * their streams, the fences between streams and the output shapes. Later
+ * calls with the same shapes and dtypes run the recording on the new inputs
+ * without tracing the function or traversing the graph, and calls with new
+ * shapes or dtypes record again. The outputs are scheduled as by async_eval.
+ *
+ * The function must be pure, as for compile.
+ */
+std::function<std::vector<array>(const std::vector<array>&)> capture(
+    std::function<std::vector<array>(const std::vector<array>&)> fun);
+
 /** Globally disable compilation.
  * Setting the environment variable ``MLX_DISABLE_COMPILE`` can also
  * be used to disable compilation.
@@ -41,4 +55,45 @@ void enable_compile();
 
 /** Set the compiler mode to the given value. */
 void set_compile_mode(CompileMode mode);
+
+/** Statistics of the CPU kernel compiler. */
+struct CompileStats {
+  // Kernel lookups which found a loaded kernel
+  size_t hits;
+  // Kernel lookups which had to wait for or fall back from a kernel
+  size_t misses;
+  // Kernels loaded from a library built by an earlier process
+  size_t disk_hits;
+  // Kernels built with the system compiler
+  size_t compiled;
+  size_t failed;
+  // Kernels being built in the background
+  size_t pending;
+  // Time spent building kernels in milliseconds
+  double total_compile_ms;
+  double max_compile_ms;
+};
+
+/** Return the statistics of the CPU kernel compiler. */
+CompileStats cpu_compile_stats();
+
+/** Build CPU kernels in the background.
+ * While a kernel is being built the compiled graph runs one primitive at a
+ * time. Enabled by default, setting the environment variable
+ * ``MLX_CPU_ASYNC_COMPILE=0`` also disables it.
+ */
+void set_cpu_async_compile(bool enable);
+
+/** Append the source of every CPU kernel built from now on to a file.
+ * The file can be given to prewarm_cpu_kernels() to build the kernels ahead
+ * of time. Pass an empty path to stop recording. Setting the environment
+ * variable ``MLX_CPU_KERNEL_RECORD`` also enables recording.
+ */
+void record_cpu_kernels(const std::string& path);
+
+/** Build and load the CPU kernels of a recording.
+ * Kernels found in the on-disk kernel cache are only loaded. Returns the
+ * number of kernels which are ready to use.
+ */
+size_t prewarm_cpu_kernels(const std::string& path);
 } // namespace mlx::core
@@ -2,6 +2,7 @@
 
 #pragma once
 
+#include <tuple>
 #include <unordered_map>
 
 #include "mlx/array.h"
@@ -55,4 +56,12 @@ std::vector<array> compile_replace(
 
 void compile_validate_shapeless(const std::vector<array>& tape);
 
+// Trace the function on the inputs and build its simplified and fused tape.
+// Returns the trace inputs, the tape and the trace outputs.
+std::tuple<std::vector<array>, std::vector<array>, std::vector<array>>
+compile_build(
+    const std::function<std::vector<array>(const std::vector<array>&)>& fun,
+    const std::vector<array>& inputs,
+    bool shapeless);
+
 } // namespace mlx::core::detail
@@ -122,6 +122,7 @@ struct MPIWrapper {
     LOAD_SYMBOL(MPI_Comm_free, comm_free);
     LOAD_SYMBOL(MPI_Allreduce, all_reduce);
     LOAD_SYMBOL(MPI_Allgather, all_gather);
+    LOAD_SYMBOL(MPI_Reduce_scatter_block, reduce_scatter);
     LOAD_SYMBOL(MPI_Send, send);
     LOAD_SYMBOL(MPI_Recv, recv);
     LOAD_SYMBOL(MPI_Type_contiguous, mpi_type_contiguous);
@@ -283,6 +284,13 @@ struct MPIWrapper {
       int,
       MPI_Datatype,
       MPI_Comm);
+  int (*reduce_scatter)(
+      const void*,
+      void*,
+      int,
+      MPI_Datatype,
+      MPI_Op,
+      MPI_Comm);
   int (*comm_split)(MPI_Comm, int, int, MPI_Comm*);
   int (*comm_free)(MPI_Comm*);
   int (*send)(const void*, int, MPI_Datatype, int, int, MPI_Comm);
@@ -439,6 +447,20 @@ class MPIGroup : public GroupImpl {
         comm_);
   }
 
+  void sum_scatter(const array& input, array& output, Stream stream) override {
+    auto& encoder = cpu::get_command_encoder(stream);
+    encoder.set_input_array(input);
+    encoder.set_output_array(output);
+    encoder.dispatch(
+        mpi().reduce_scatter,
+        input.data<void>(),
+        output.data<void>(),
+        output.size(),
+        mpi().datatype(output),
+        mpi().op_sum(output),
+        comm_);
+  }
+
   void send(const array& input, int dst, Stream stream) override {
     auto& encoder = cpu::get_command_encoder(stream);
     encoder.set_input_array(input);
@@ -304,6 +304,11 @@ class NCCLGroup : public GroupImpl {
     throw std::runtime_error("[nccl] All min not supported in NCCL backend.");
   }
 
+  void sum_scatter(const array& input, array& output, Stream stream) override {
+    throw std::runtime_error(
+        "[nccl] Sum scatter not supported in NCCL backend.");
+  }
+
   template <typename T>
   void all_reduce_impl(
       const array& input,
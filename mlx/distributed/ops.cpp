@@ -100,6 +100,33 @@ array all_gather(
       {x});
 }
 
+array sum_scatter(
+    const array& x,
+    std::optional<Group> group_ /* = std::nullopt */,
+    StreamOrDevice s /* = {} */) {
+  auto group = to_group(group_);
+
+  if (group.size() == 1) {
+    return x;
+  }
+  if (x.ndim() == 0 || x.shape(0) % group.size() != 0) {
+    std::ostringstream msg;
+    msg << "[sum_scatter] Cannot split an array with shape " << x.shape()
+        << " along the first axis across a group of size " << group.size()
+        << ".";
+    throw std::invalid_argument(msg.str());
+  }
+  auto stream = detail::communication_stream(group, s);
+
+  auto result_shape = x.shape();
+  result_shape[0] /= group.size();
+  return array(
+      std::move(result_shape),
+      x.dtype(),
+      std::make_shared<ReduceScatter>(stream, group),
+      {x});
+}
+
 array send(
     const array& x,
     int dst,
@@ -19,6 +19,14 @@ array all_gather(
     std::optional<Group> group = std::nullopt,
     StreamOrDevice S = {});
 
+/* Sum x across the group and split the result along the first axis so
+ * that rank i gets the i-th block. The first axis of x must be divisible by
+ * the size of the group. */
+array sum_scatter(
+    const array& x,
+    std::optional<Group> group = std::nullopt,
+    StreamOrDevice s = {});
+
 array send(
     const array& x,
     int dst,
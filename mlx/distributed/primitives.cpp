@@ -77,6 +77,35 @@ std::vector<array> AllGather::vjp(
   return {slice(cotangents[0], starts, stops)};
 }
 
+std::pair<std::vector<array>, std::vector<int>> ReduceScatter::vmap(
+    const std::vector<array>& inputs,
+    const std::vector<int>& axes) {
+  // Keep the vmapped axis out of the way of the scattered one
+  auto x = inputs[0];
+  int ax = axes[0];
+  if (ax == 0) {
+    x = swapaxes(x, 0, 1, stream());
+    ax = 1;
+  }
+  return {{sum_scatter(x, group(), stream())}, {ax}};
+}
+
+std::vector<array> ReduceScatter::jvp(
+    const std::vector<array>& primals,
+    const std::vector<array>& tangents,
+    const std::vector<int>& argnums) {
+  return {sum_scatter(tangents[0], group(), stream())};
+}
+
+std::vector<array> ReduceScatter::vjp(
+    const std::vector<array>& primals,
+    const std::vector<array>& cotangents,
+    const std::vector<int>& argnums,
+    const std::vector<array>& outputs) {
+  // Every block of the input reaches the rank that owns it
+  return {all_gather(cotangents[0], group(), stream())};
+}
+
 std::pair<std::vector<array>, std::vector<int>> Send::vmap(
     const std::vector<array>& inputs,
     const std::vector<int>& axes) {
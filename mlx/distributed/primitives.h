@@ -92,6 +92,33 @@ class AllGather : public DistPrimitive {
   DEFINE_NAME(AllGather);
 };
 
+// Sums the inputs of the group and keeps the block of the first axis that
+// belongs to this rank
+class ReduceScatter : public DistPrimitive {
+ public:
+  ReduceScatter(Stream stream, Group group) : DistPrimitive(stream, group) {}
+
+  void eval_cpu(const std::vector<array>& inputs, std::vector<array>& outputs)
+      override;
+  void eval_gpu(const std::vector<array>& inputs, std::vector<array>& outputs)
+      override;
+
+  std::pair<std::vector<array>, std::vector<int>> vmap(
+      const std::vector<array>& inputs,
+      const std::vector<int>& axes) override;
+  std::vector<array> jvp(
+      const std::vector<array>& primals,
+      const std::vector<array>& tangents,
+      const std::vector<int>& argnums) override;
+  std::vector<array> vjp(
+      const std::vector<array>& primals,
+      const std::vector<array>& cotangents,
+      const std::vector<int>& argnums,
+      const std::vector<array>& outputs) override;
+
+  DEFINE_NAME(ReduceScatter);
+};
+
 class Send : public DistPrimitive {
  public:
   Send(Stream stream, Group group, int dst)
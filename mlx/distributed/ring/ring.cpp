@@ -5,6 +5,7 @@
 #include <netdb.h>
 #include <netinet/in.h>
 #include <netinet/tcp.h>
+#include <poll.h>
 #include <sys/socket.h>
 #include <unistd.h>
 
@@ -19,6 +20,7 @@
 
 #include <json.hpp>
 
+#include "mlx/allocator.h"
 #include "mlx/backend/cpu/encoder.h"
 #include "mlx/distributed/distributed.h"
 #include "mlx/distributed/distributed_impl.h"
@@ -90,8 +92,10 @@
 
 namespace mlx::core::distributed::ring {
 
-constexpr const size_t ALL_SUM_SIZE = 8 * 1024 * 1024;
-constexpr const size_t ALL_SUM_BUFFERS = 2;
+// Bytes moved through the ring at a time. MLX_RING_CHUNK_SIZE overrides it.
+constexpr const size_t RING_CHUNK_SIZE = 1024 * 1024;
+// Received chunks that can be in flight while earlier ones are reduced
+constexpr const size_t RING_PIPELINE_DEPTH = 4;
 constexpr const int CONN_ATTEMPTS = 5;
 constexpr const int CONN_WAIT = 1000;
 
@@ -128,6 +132,14 @@ decltype(T() * U()) ceildiv(T a, U b) {
 class SocketThread {
  public:
   SocketThread(int fd) : fd_(fd), stop_(false) {
+    if (pipe(wake_) < 0) {
+      std::ostringstream msg;
+      msg << "[ring] Couldn't create a pipe (error: " << errno << ")";
+      throw std::runtime_error(msg.str());
+    }
+    for (int p : wake_) {
+      fcntl(p, F_SETFL, fcntl(p, F_GETFL, 0) | O_NONBLOCK);
+    }
     worker_ = std::thread(&SocketThread::worker, this);
     int flags = fcntl(fd, F_GETFL, 0);
     fcntl(fd, F_SETFL, flags | O_NONBLOCK);
@@ -135,9 +147,12 @@ class SocketThread {
   ~SocketThread() {
     stop_ = true;
     condition_.notify_all();
+    wake();
     worker_.join();
     int flags = fcntl(fd_, F_GETFL, 0);
     fcntl(fd_, F_SETFL, flags & ~O_NONBLOCK);
+    close(wake_[0]);
+    close(wake_[1]);
   }
 
   template <typename T>
@@ -175,6 +190,7 @@ class SocketThread {
           const_cast<char*>(buffer), size, std::move(send_completed_promise)));
     }
     condition_.notify_one();
+    wake();
     return send_completed_future;
   }
 
@@ -192,6 +208,7 @@ class SocketThread {
           SocketTask(buffer, size, std::move(recv_completed_promise)));
     }
     condition_.notify_one();
+    wake();
     return recv_completed_future;
   }
 
@@ -199,6 +216,28 @@ class SocketThread {
     return !(sends_.empty() && recvs_.empty());
   }
 
+  // Interrupt a worker waiting on the socket so that it sees new tasks
+  void wake() {
+    char c = 0;
+    ssize_t r = write(wake_[1], &c, 1);
+    (void)r;
+  }
+
+  // Sleep until the socket can make progress or there are new tasks instead
+  // of spinning on a socket that would block, which takes the CPU away from
+  // the reductions.
+  void wait_for_socket(bool recv, bool send) {
+    pollfd fds[2];
+    fds[0].fd = fd_;
+    fds[0].events = (recv ? POLLIN : 0) | (send ? POLLOUT : 0);
+    fds[1].fd = wake_[0];
+    fds[1].events = POLLIN;
+    poll(fds, 2, -1);
+    char buffer[64];
+    while (read(wake_[0], buffer, sizeof(buffer)) > 0) {
+    }
+  }
+
   void worker() {
     int error_count = 0;
     bool delete_recv = false;
@@ -230,6 +269,8 @@ class SocketThread {
         }
       }
 
+      bool recv_blocked = false;
+      bool send_blocked = false;
       if (!recvs_.empty()) {
         auto& task = recvs_.front();
         ssize_t r = ::recv(fd_, task.buffer, task.size, 0);
@@ -238,7 +279,9 @@ class SocketThread {
           task.size -= r;
           delete_recv = task.size == 0;
           error_count = 0;
-        } else if (errno != EAGAIN) {
+        } else if (errno == EAGAIN) {
+          recv_blocked = true;
+        } else {
           error_count++;
           log_info(
               true, "Receiving from socket", fd_, "failed with errno", errno);
@@ -252,11 +295,17 @@ class SocketThread {
           task.size -= r;
           delete_send = task.size == 0;
           error_count = 0;
-        } else if (errno != EAGAIN) {
+        } else if (errno == EAGAIN) {
+          send_blocked = true;
+        } else {
           error_count++;
           log_info(true, "Sending to socket", fd_, "failed with errno", errno);
         }
       }
+      if ((recv_blocked || recvs_.empty()) &&
+          (send_blocked || sends_.empty())) {
+        wait_for_socket(recv_blocked, send_blocked);
+      }
 
       if (error_count >= 10) {
         log_info(true, "Too many send/recv errors. Aborting...");
@@ -266,6 +315,7 @@ class SocketThread {
   }
 
   int fd_;
+  int wake_[2];
   bool stop_;
   std::thread worker_;
   std::mutex queue_mutex_;
@@ -503,6 +553,21 @@ std::vector<int> make_connections(
 
   return sockets;
 }
+/**
+ * The blocks of data that a ring pass moves around. Block k starts at
+ * k * stride and holds size elements, cut short at total.
+ */
+struct RingSegments {
+  size_t stride;
+  size_t size;
+  size_t total;
+
+  size_t length(int k) const {
+    size_t start = k * stride;
+    return (start >= total) ? 0 : std::min(size, total - start);
+  }
+};
+
 template <typename T>
 struct SumOp {
   void operator()(const T* input, T* output, size_t N) {
@@ -540,8 +605,12 @@ struct MinOp {
 
 class RingGroup : public GroupImpl {
  public:
-  RingGroup(int rank, std::vector<std::vector<address_t>> nodes, bool verbose)
-      : rank_(rank), verbose_(verbose), pool_(0) {
+  RingGroup(
+      int rank,
+      std::vector<std::vector<address_t>> nodes,
+      size_t chunk_size,
+      bool verbose)
+      : rank_(rank), chunk_size_(chunk_size), verbose_(verbose), pool_(0) {
     if (rank_ > 0 && rank_ >= nodes.size()) {
       throw std::runtime_error(
           "[ring] Rank cannot be larger than the size of the group");
@@ -602,10 +671,10 @@ class RingGroup : public GroupImpl {
     comm_.add(sockets_right_);
     comm_.add(sockets_left_);
 
-    // Allocate buffers for the all sum
+    // Allocate the receive buffers of the reductions
     buffers_.resize(
-        (sockets_right_.size() + sockets_left_.size()) * ALL_SUM_BUFFERS *
-        ALL_SUM_SIZE);
+        (sockets_right_.size() + sockets_left_.size()) * RING_PIPELINE_DEPTH *
+        chunk_size_);
   }
 
   ~RingGroup() {
@@ -646,6 +715,12 @@ class RingGroup : public GroupImpl {
         output, all_reduce<T, MinOp<T>>(input, output, stream, MinOp<T>()));
   }
 
+  void sum_scatter(const array& input, array& output, Stream stream) override {
+    SWITCH_TYPE(
+        output,
+        reduce_scatter<T, SumOp<T>>(input, output, stream, SumOp<T>()));
+  }
+
   std::shared_ptr<GroupImpl> split(int color, int key = -1) override {
     throw std::runtime_error("[ring] Group split not supported.");
   }
@@ -658,6 +733,9 @@ class RingGroup : public GroupImpl {
                       nbytes = input.nbytes(),
                       output_ptr = output.data<char>(),
                       this]() {
+      // Copy our own block in the output
+      std::memcpy(output_ptr + rank_ * nbytes, input_ptr, nbytes);
+
       constexpr size_t min_send_size = 262144;
       size_t n_gathers = std::max(
           std::min(
@@ -668,14 +746,12 @@ class RingGroup : public GroupImpl {
       std::vector<std::future<void>> all_gathers;
       for (int i = 0; i < n_gathers; i++) {
         auto offset = i * bytes_per_gather;
+        auto size = std::min(nbytes, offset + bytes_per_gather) - offset;
         all_gathers.emplace_back(pool_.enqueue(std::bind(
-            &RingGroup::all_gather_impl,
+            &RingGroup::all_gather_impl<char>,
             this,
-            input_ptr + offset,
             output_ptr + offset,
-            nbytes,
-            offset + bytes_per_gather > nbytes ? nbytes - offset
-                                               : bytes_per_gather,
+            RingSegments{nbytes, size, nbytes * (size_ - 1) + size},
             sockets_right_[i / 2],
             sockets_left_[i / 2],
             (i % 2) ? -1 : 1)));
@@ -792,7 +868,7 @@ class RingGroup : public GroupImpl {
             &RingGroup::all_reduce_impl<T, ReduceOp>,
             this,
             reinterpret_cast<T*>(
-                buffers_.data() + i * ALL_SUM_SIZE * ALL_SUM_BUFFERS),
+                buffers_.data() + i * RING_PIPELINE_DEPTH * chunk_size_),
             reinterpret_cast<T*>(out_ptr) + i * step,
             std::min(size, (i + 1) * step) - i * step,
             sockets_right_[i / 2],
@@ -806,6 +882,59 @@ class RingGroup : public GroupImpl {
     });
   }
 
+  template <typename T, typename ReduceOp>
+  void reduce_scatter(
+      const array& input,
+      array& output,
+      Stream stream,
+      ReduceOp reduce_op) {
+    // The ring reduces in place so it works on a copy of the input
+    array scratch(input.shape(), input.dtype(), nullptr, {});
+    scratch.set_data(allocator::malloc(scratch.nbytes()));
+
+    auto& encoder = cpu::get_command_encoder(stream);
+    encoder.set_input_array(input);
+    encoder.set_output_array(output);
+    encoder.dispatch([in_ptr = input.data<T>(),
+                      scratch_ptr = scratch.data<T>(),
+                      out_ptr = output.data<T>(),
+                      size = output.size(),
+                      this,
+                      reduce_op]() {
+      std::memcpy(scratch_ptr, in_ptr, size * size_ * sizeof(T));
+
+      // Every reduce scatter moves a slice of each rank's block
+      constexpr size_t min_send_size = 262144;
+      size_t n_reduces = std::max(
+          std::min(
+              sockets_right_.size() + sockets_left_.size(),
+              size * sizeof(T) / min_send_size),
+          size_t(1));
+      size_t step = ceildiv(size, n_reduces);
+      std::vector<std::future<void>> reduces;
+      for (int i = 0; i < n_reduces; i++) {
+        size_t slice = std::min(size, (i + 1) * step) - i * step;
+        int direction = (i % 2) ? -1 : 1;
+        reduces.emplace_back(pool_.enqueue(std::bind(
+            &RingGroup::reduce_scatter_impl<T, ReduceOp>,
+            this,
+            reinterpret_cast<T*>(
+                buffers_.data() + i * RING_PIPELINE_DEPTH * chunk_size_),
+            scratch_ptr + i * step,
+            RingSegments{size, slice, size * (size_ - 1) + slice},
+            sockets_right_[i / 2],
+            sockets_left_[i / 2],
+            direction,
+            reduce_op)));
+      }
+      for (auto& f : reduces) {
+        f.wait();
+      }
+      std::memcpy(out_ptr, scratch_ptr + rank_ * size, size * sizeof(T));
+    });
+    encoder.add_temporary(std::move(scratch));
+  }
+
   template <typename T, typename ReduceOp>
   void all_reduce_impl(
       T* buffer,
@@ -815,100 +944,111 @@ class RingGroup : public GroupImpl {
       int socket_left,
       int direction,
       ReduceOp reduce_op) {
+    // Reduce scatter the data in size_ segments and then gather the segments
+    // reduced by the rest of the ring
+    size_t segment_size = ceildiv(data_size, size_);
+    RingSegments segments{segment_size, segment_size, data_size};
+    reduce_scatter_impl<T, ReduceOp>(
+        buffer,
+        data,
+        segments,
+        socket_right,
+        socket_left,
+        direction,
+        reduce_op);
+    all_gather_impl<T>(data, segments, socket_right, socket_left, direction);
+  }
+
+  // Segment rank_ + step * direction. We receive from rank_ + direction, so
+  // at every step we receive the segment one step ahead of the one we send.
+  // A reduce scatter sends from step 1 in order to end with the reduction
+  // of segment rank_, which the all gather then sends from step 0.
+  int ring_segment(int step, int direction) {
+    return (rank_ + step * direction + 2 * size_) % size_;
+  }
+
+  /**
+   * Run the first half of a ring all reduce leaving the reduction of segment
+   * rank_ in data.
+   *
+   * Every segment is moved in chunks of chunk_size_ bytes. Up to
+   * RING_PIPELINE_DEPTH chunks are received in buffer while we reduce earlier
+   * ones, and a chunk is sent on as soon as it is reduced, so the
+   * communication threads keep both sockets busy while we compute.
+   */
+  template <typename T, typename ReduceOp>
+  void reduce_scatter_impl(
+      T* buffer,
+      T* data,
+      RingSegments segments,
+      int socket_right,
+      int socket_left,
+      int direction,
+      ReduceOp reduce_op) {
     // Choose which socket we send to and recv from
     int socket_send = (direction < 0) ? socket_right : socket_left;
     int socket_recv = (direction < 0) ? socket_left : socket_right;
 
-    // We split the data into `size_` segments of size `segment_size` and each
-    // of these in smaller segments of ALL_SUM_SIZE which we 'll call packets.
-    size_t segment_size = ceildiv(data_size, size_);
-    size_t BUFFER_SIZE = std::max(
-        size_t(32768), std::min(ALL_SUM_SIZE / sizeof(T), segment_size / 2));
-    size_t n_packets = ceildiv(segment_size, BUFFER_SIZE);
-
-    // Initial segments
-    int send_segment = rank_;
-    int recv_segment = (rank_ + direction + size_) % size_;
-
-    // Plan the whole reduce in terms of sends and recvs as indices in data.
-    // It makes the actual async send and recv a bit simpler to follow when
-    // there are less offset calculations around.
-    std::vector<std::pair<size_t, size_t>> send_plan;
-    std::vector<std::pair<size_t, size_t>> recv_plan;
-
-    // Two times the same send/recv operations, first scatter reduce and then
-    // gather.
-    for (int k = 0; k < 2; k++) {
-      for (int i = 0; i < size_ - 1; i++) {
-        size_t send_start = send_segment * segment_size;
-        size_t send_stop =
-            std::min((send_segment + 1) * segment_size, data_size);
-        size_t recv_start = recv_segment * segment_size;
-        size_t recv_stop =
-            std::min((recv_segment + 1) * segment_size, data_size);
-
-        for (size_t j = 0; j < n_packets; j++) {
-          send_plan.emplace_back(
-              std::min(send_start + j * BUFFER_SIZE, send_stop),
-              std::min(send_start + (j + 1) * BUFFER_SIZE, send_stop));
-          recv_plan.emplace_back(
-              std::min(recv_start + j * BUFFER_SIZE, recv_stop),
-              std::min(recv_start + (j + 1) * BUFFER_SIZE, recv_stop));
-        }
-
-        send_segment = (send_segment + size_ + direction) % size_;
-        recv_segment = (recv_segment + size_ + direction) % size_;
-      }
-    }
+    size_t chunk = std::max(chunk_size_ / sizeof(T), size_t(1));
+    size_t n_chunks = ceildiv(segments.size, chunk);
+    size_t n = (size_ - 1) * n_chunks;
+
+    // The i-th transfer is chunk i % n_chunks of the segment at step
+    // i / n_chunks
+    auto chunk_of = [&](size_t i, int segment) -> std::pair<T*, size_t> {
+      size_t start = (i % n_chunks) * chunk;
+      size_t length = segments.length(segment);
+      return {
+          data + segment * segments.stride + std::min(start, length),
+          std::min(start + chunk, length) - std::min(start, length)};
+    };
+    auto send_chunk = [&](size_t i) {
+      return chunk_of(i, ring_segment(i / n_chunks + 1, direction));
+    };
+    auto recv_chunk = [&](size_t i) {
+      return chunk_of(i, ring_segment(i / n_chunks + 2, direction));
+    };
 
-    // Running the plan is fairly simple, we keep a send and a recv in flight
-    // while doing the summation.
-    T* recv_buffers[ALL_SUM_BUFFERS];
-    for (int i = 0; i < ALL_SUM_BUFFERS; i++) {
-      recv_buffers[i] = buffer + i * BUFFER_SIZE;
-    }
-    std::future<void> sends[2], recvs[2];
-    int a = 0;
-    int b = (n_packets > 1) ? 1 : 0;
-    for (int i = 0, j = -b; i < send_plan.size(); j++, i++) {
-      sends[a] = comm_.send(
-          socket_send,
-          data + send_plan[i].first,
-          send_plan[i].second - send_plan[i].first);
-      if (2 * i < send_plan.size()) {
-        recvs[a] = comm_.recv(
-            socket_recv,
-            recv_buffers[i % ALL_SUM_BUFFERS],
-            recv_plan[i].second - recv_plan[i].first);
-      } else {
-        recvs[a] = comm_.recv(
+    std::vector<std::future<void>> sends;
+    std::vector<std::future<void>> recvs;
+    sends.reserve(n);
+    recvs.reserve(n);
+    for (size_t i = 0; i < n; i++) {
+      // Receive into the free buffers
+      while (recvs.size() < std::min(n, i + RING_PIPELINE_DEPTH)) {
+        size_t j = recvs.size();
+        recvs.push_back(comm_.recv(
             socket_recv,
-            data + recv_plan[i].first,
-            recv_plan[i].second - recv_plan[i].first);
+            buffer + (j % RING_PIPELINE_DEPTH) * chunk,
+            recv_chunk(j).second));
       }
 
-      if (j >= 0) {
-        sends[b].wait();
-        recvs[b].wait();
-        if (2 * j < send_plan.size()) {
-          reduce_op(
-              recv_buffers[j % ALL_SUM_BUFFERS],
-              data + recv_plan[j].first,
-              recv_plan[j].second - recv_plan[j].first);
-        }
+      // Send the chunks of the first step and the ones already reduced
+      while (sends.size() < std::min(n, i + n_chunks)) {
+        auto [ptr, length] = send_chunk(sends.size());
+        sends.push_back(comm_.send(socket_send, ptr, length));
       }
 
-      std::swap(a, b);
+      recvs[i].wait();
+      auto [ptr, length] = recv_chunk(i);
+      reduce_op(buffer + (i % RING_PIPELINE_DEPTH) * chunk, ptr, length);
+    }
+    for (auto& f : sends) {
+      f.wait();
     }
-    sends[b].wait();
-    recvs[b].wait();
   }
 
+  /**
+   * Gather the segments of the other ranks in data given that segment rank_
+   * is already in place.
+   *
+   * The segments are moved in chunks of chunk_size_ bytes and each chunk is
+   * forwarded as soon as it arrives.
+   */
+  template <typename T>
   void all_gather_impl(
-      const char* input,
-      char* output,
-      size_t input_size,
-      size_t data_size,
+      T* data,
+      RingSegments segments,
       int socket_right,
       int socket_left,
       int direction) {
@@ -916,27 +1056,41 @@ class RingGroup : public GroupImpl {
     int socket_send = (direction < 0) ? socket_right : socket_left;
     int socket_recv = (direction < 0) ? socket_left : socket_right;
 
-    // Initial segments
-    int send_segment = rank_;
-    int recv_segment = (rank_ + direction + size_) % size_;
-
-    // Copy our own segment in the output
-    std::memcpy(output + rank_ * input_size, input, data_size);
+    size_t chunk = std::max(chunk_size_ / sizeof(T), size_t(1));
+    size_t n_chunks = ceildiv(segments.size, chunk);
+    size_t n = (size_ - 1) * n_chunks;
 
-    // Simple send/recv all gather. Possible performance improvement by
-    // splitting to multiple chunks and allowing send/recv to run a bit ahead.
-    // See all_sum_impl for an example.
-    for (int i = 0; i < size_ - 1; i++) {
-      auto sent = comm_.send(
-          socket_send, output + send_segment * input_size, data_size);
-      auto recvd = comm_.recv(
-          socket_recv, output + recv_segment * input_size, data_size);
+    auto chunk_of = [&](size_t i, int segment) -> std::pair<T*, size_t> {
+      size_t start = (i % n_chunks) * chunk;
+      size_t length = segments.length(segment);
+      return {
+          data + segment * segments.stride + std::min(start, length),
+          std::min(start + chunk, length) - std::min(start, length)};
+    };
 
-      send_segment = (send_segment + size_ + direction) % size_;
-      recv_segment = (recv_segment + size_ + direction) % size_;
-
-      sent.wait();
-      recvd.wait();
+    // Everything is received in place so all receives can be queued now
+    std::vector<std::future<void>> sends;
+    std::vector<std::future<void>> recvs;
+    sends.reserve(n);
+    recvs.reserve(n);
+    for (size_t i = 0; i < n; i++) {
+      auto [ptr, length] =
+          chunk_of(i, ring_segment(i / n_chunks + 1, direction));
+      recvs.push_back(comm_.recv(socket_recv, ptr, length));
+    }
+    for (size_t i = 0; i <= n; i++) {
+      // Send our segment and the chunks received so far
+      while (sends.size() < std::min(n, i + n_chunks)) {
+        size_t j = sends.size();
+        auto [ptr, length] = chunk_of(j, ring_segment(j / n_chunks, direction));
+        sends.push_back(comm_.send(socket_send, ptr, length));
+      }
+      if (i < n) {
+        recvs[i].wait();
+      }
+    }
+    for (auto& f : sends) {
+      f.wait();
     }
   }
 
@@ -980,6 +1134,7 @@ class RingGroup : public GroupImpl {
   int rank_;
   int size_;
 
+  size_t chunk_size_;
   bool verbose_;
 
   ThreadPool pool_;
@@ -1014,8 +1169,13 @@ std::shared_ptr<GroupImpl> init(bool strict /* = false */) {
 
   auto nodes = load_nodes(hostfile);
   int rank = std::atoi(rank_str);
+  size_t chunk_size = RING_CHUNK_SIZE;
+  if (const char* chunk_str = std::getenv("MLX_RING_CHUNK_SIZE")) {
+    chunk_size = std::max(std::atol(chunk_str), 1024l);
+  }
 
-  return std::make_shared<RingGroup>(rank, nodes, ring_verbose != nullptr);
+  return std::make_shared<RingGroup>(
+      rank, nodes, chunk_size, ring_verbose != nullptr);
 }
 
 } // namespace mlx::core::distributed::ring
@@ -2,6 +2,7 @@
 
 #pragma once
 
+#include <optional>
 #include <unordered_map>
 #include <variant>
 
@@ -36,9 +37,15 @@ array load(std::string file, StreamOrDevice s = {});
 SafetensorsLoad load_safetensors(
     std::shared_ptr<io::Reader> in_stream,
     StreamOrDevice s = {});
+
+/**
+ * Load array map from .safetensors file format. If mmap is given the file is
+ * memory mapped and the arrays alias the file pages when possible.
+ */
 SafetensorsLoad load_safetensors(
     const std::string& file,
-    StreamOrDevice s = {});
+    StreamOrDevice s = {},
+    std::optional<io::MmapOptions> mmap = std::nullopt);
 
 void save_safetensors(
     std::shared_ptr<io::Writer> in_stream,
@@ -49,9 +56,20 @@ void save_safetensors(
     std::unordered_map<std::string, array>,
     std::unordered_map<std::string, std::string> metadata = {});
 
-/** Load array map and metadata from .gguf file format */
-
-GGUFLoad load_gguf(const std::string& file, StreamOrDevice s = {});
+/**
+ * Load array map and metadata from .gguf file format. If mmap is given the
+ * file is memory mapped and unquantized tensors alias the file pages when
+ * possible.
+ *
+ * Q4_0, Q4_1, Q8_0 and Q2_K to Q6_K tensors stay quantized: ``name.weight``
+ * is loaded as packed weights with ``name.scales`` and ``name.biases`` for
+ * quantized_matmul, and the metadata entry ``name.quantization`` holds the
+ * ``[group_size, bits]`` to call it with.
+ */
+GGUFLoad load_gguf(
+    const std::string& file,
+    StreamOrDevice s = {},
+    std::optional<io::MmapOptions> mmap = std::nullopt);
 
 void save_gguf(
     std::string file,
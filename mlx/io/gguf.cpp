@@ -7,6 +7,7 @@
 
 #include "mlx/io/gguf.h"
 #include "mlx/ops.h"
+#include "mlx/primitives.h"
 
 namespace mlx::core {
 
@@ -204,7 +205,14 @@ std::unordered_map<std::string, GGUFMetaData> load_metadata(gguf_ctx* ctx) {
   return metadata;
 }
 
-std::unordered_map<std::string, array> load_arrays(gguf_ctx* ctx) {
+// When reader is given, tensors stored as an MLX dtype are loaded lazily from
+// it instead of being copied out of the gguf mapping. Quantized tensors record
+// their group size and bits in metadata.
+std::unordered_map<std::string, array> load_arrays(
+    gguf_ctx* ctx,
+    std::unordered_map<std::string, GGUFMetaData>& metadata,
+    std::shared_ptr<io::MmapReader> reader = nullptr,
+    Stream stream = Stream(0, Device::cpu)) {
   std::unordered_map<std::string, array> array_map;
   gguf_tensor tensor;
 
@@ -218,9 +226,17 @@ std::unordered_map<std::string, array> load_arrays(gguf_ctx* ctx) {
   };
 
   while (gguf_get_tensor(ctx, &tensor)) {
-    if (tensor.type == GGUF_TYPE_Q4_0 || tensor.type == GGUF_TYPE_Q4_1 ||
-        tensor.type == GGUF_TYPE_Q8_0) {
-      gguf_load_quantized(array_map, tensor);
+    if (gguf_is_quantized(tensor.type)) {
+      gguf_load_quantized(array_map, metadata, tensor);
+    } else if (auto dtype = gguf_type_to_dtype(tensor.type); reader && dtype) {
+      std::string name(tensor.name, tensor.namelen);
+      size_t offset = static_cast<uint8_t*>(tensor.weights_data) - ctx->data;
+      array loaded_array = array(
+          get_shape(tensor),
+          *dtype,
+          std::make_shared<Load>(stream, reader, offset, false),
+          std::vector<array>{});
+      check_insert(array_map.insert({name, loaded_array}));
     } else {
       std::string name(tensor.name, tensor.namelen);
       const auto& [data, dtype] = extract_tensor_data(&tensor);
@@ -231,7 +247,10 @@ std::unordered_map<std::string, array> load_arrays(gguf_ctx* ctx) {
   return array_map;
 }
 
-GGUFLoad load_gguf(const std::string& file, StreamOrDevice s) {
+GGUFLoad load_gguf(
+    const std::string& file,
+    StreamOrDevice s,
+    std::optional<io::MmapOptions> mmap) {
   bool exists;
   {
     std::ifstream f(file.c_str());
@@ -247,7 +266,16 @@ GGUFLoad load_gguf(const std::string& file, StreamOrDevice s) {
     throw std::runtime_error("[load_gguf] gguf_init failed");
   }
   auto metadata = load_metadata(ctx.get());
-  auto arrays = load_arrays(ctx.get());
+  if (mmap) {
+    auto stream = to_stream(s, Device::cpu);
+    if (stream.device != Device::cpu) {
+      throw std::runtime_error("[load_gguf] Must run on a CPU stream.");
+    }
+    auto reader = std::make_shared<io::MmapReader>(file, *mmap);
+    auto arrays = load_arrays(ctx.get(), metadata, reader, stream);
+    return {arrays, metadata};
+  }
+  auto arrays = load_arrays(ctx.get(), metadata);
   return {arrays, metadata};
 }
 
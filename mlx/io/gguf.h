@@ -13,8 +13,10 @@ extern "C" {
 namespace mlx::core {
 
 Shape get_shape(const gguf_tensor& tensor);
+bool gguf_is_quantized(uint32_t type);
 void gguf_load_quantized(
     std::unordered_map<std::string, array>& a,
+    std::unordered_map<std::string, GGUFMetaData>& metadata,
     const gguf_tensor& tensor);
 
 } // namespace mlx::core
@@ -97,21 +97,271 @@ void extract_q8_0_data(
   }
 }
 
+// The K-quants store super-blocks of 256 weights split into groups of 16 or
+// 32 that each have their own scale and minimum. Every group maps to one
+// affine group with scale * q + bias, so the weights stay quantized. The
+// layouts follow dequantize_row_q*_K in ggml-quants.c.
+constexpr int k_quant_block = 256;
+
+float load_f16(const uint8_t* data) {
+  float16_t x;
+  std::memcpy(&x, data, sizeof(x));
+  return static_cast<float>(x);
+}
+
+// Packs 256 values of the given bits back to back from the low bit of each
+// byte, which is the layout of MLX quantized weights.
+template <int bits>
+void pack_k_quant_block(const uint8_t* q, uint8_t* out) {
+  uint32_t acc = 0;
+  int filled = 0;
+  for (int i = 0; i < k_quant_block; i++) {
+    acc |= static_cast<uint32_t>(q[i]) << filled;
+    filled += bits;
+    while (filled >= 8) {
+      *out++ = acc & 0xff;
+      acc >>= 8;
+      filled -= 8;
+    }
+  }
+}
+
+// The 6 bit scales and minimums of Q4_K and Q5_K.
+void get_scale_min_k4(int j, const uint8_t* q, uint8_t& d, uint8_t& m) {
+  if (j < 4) {
+    d = q[j] & 63;
+    m = q[j + 4] & 63;
+  } else {
+    d = (q[j + 4] & 0xF) | ((q[j - 4] >> 6) << 4);
+    m = (q[j + 4] >> 4) | ((q[j] >> 6) << 4);
+  }
+}
+
+// Data layout is: |16 x 8bit scale and min|256 x 2bit weights|16 bit scale|
+// |16 bit min|.
+void unpack_q2_k(
+    const uint8_t* data,
+    uint8_t* q,
+    float* scales,
+    float* biases) {
+  const uint8_t* qs = data + 16;
+  float d = load_f16(data + 80);
+  float dmin = load_f16(data + 82);
+  for (int g = 0; g < 16; g++) {
+    int shift = 2 * ((g % 8) / 2);
+    const uint8_t* src = qs + 32 * (g / 8) + 16 * (g % 2);
+    for (int l = 0; l < 16; l++) {
+      q[16 * g + l] = (src[l] >> shift) & 3;
+    }
+    scales[g] = d * (data[g] & 0xF);
+    biases[g] = -dmin * (data[g] >> 4);
+  }
+}
+
+// Data layout is: |256 x 1bit high bits|256 x 2bit low bits|16 x 6bit scale|
+// |16 bit scale|. Weights are stored offset by 4.
+void unpack_q3_k(
+    const uint8_t* data,
+    uint8_t* q,
+    float* scales,
+    float* biases) {
+  const uint8_t* hmask = data;
+  const uint8_t* qs = data + 32;
+  float d = load_f16(data + 108);
+
+  constexpr uint32_t kmask1 = 0x03030303;
+  constexpr uint32_t kmask2 = 0x0f0f0f0f;
+  uint32_t aux[4];
+  std::memcpy(aux, data + 96, 12);
+  uint32_t tmp = aux[2];
+  aux[2] = ((aux[0] >> 4) & kmask2) | (((tmp >> 4) & kmask1) << 4);
+  aux[3] = ((aux[1] >> 4) & kmask2) | (((tmp >> 6) & kmask1) << 4);
+  aux[0] = (aux[0] & kmask2) | (((tmp >> 0) & kmask1) << 4);
+  aux[1] = (aux[1] & kmask2) | (((tmp >> 2) & kmask1) << 4);
+  auto sc = reinterpret_cast<const int8_t*>(aux);
+
+  for (int g = 0; g < 16; g++) {
+    int j = (g % 8) / 2;
+    int half = 16 * (g % 2);
+    uint8_t m = 1 << (4 * (g / 8) + j);
+    const uint8_t* src = qs + 32 * (g / 8) + half;
+    for (int l = 0; l < 16; l++) {
+      uint8_t high = (hmask[half + l] & m) ? 4 : 0;
+      q[16 * g + l] = ((src[l] >> (2 * j)) & 3) | high;
+    }
+    scales[g] = d * (sc[g] - 32);
+    biases[g] = -4 * scales[g];
+  }
+}
+
+// Data layout is: |16 bit scale|16 bit min|8 x 6bit scale and min|
+// |256 x 4bit weights|.
+void unpack_q4_k(
+    const uint8_t* data,
+    uint8_t* q,
+    float* scales,
+    float* biases) {
+  float d = load_f16(data);
+  float dmin = load_f16(data + 2);
+  const uint8_t* qs = data + 16;
+  for (int g = 0; g < 8; g++) {
+    const uint8_t* src = qs + 32 * (g / 2);
+    int shift = 4 * (g % 2);
+    for (int l = 0; l < 32; l++) {
+      q[32 * g + l] = (src[l] >> shift) & 0xF;
+    }
+    uint8_t sc, m;
+    get_scale_min_k4(g, data + 4, sc, m);
+    scales[g] = d * sc;
+    biases[g] = -dmin * m;
+  }
+}
+
+// Data layout is: |16 bit scale|16 bit min|8 x 6bit scale and min|
+// |256 x 1bit high bits|256 x 4bit low bits|.
+void unpack_q5_k(
+    const uint8_t* data,
+    uint8_t* q,
+    float* scales,
+    float* biases) {
+  float d = load_f16(data);
+  float dmin = load_f16(data + 2);
+  const uint8_t* qh = data + 16;
+  const uint8_t* qs = data + 48;
+  for (int g = 0; g < 8; g++) {
+    const uint8_t* src = qs + 32 * (g / 2);
+    int shift = 4 * (g % 2);
+    for (int l = 0; l < 32; l++) {
+      uint8_t high = (qh[l] & (1 << g)) ? 16 : 0;
+      q[32 * g + l] = ((src[l] >> shift) & 0xF) | high;
+    }
+    uint8_t sc, m;
+    get_scale_min_k4(g, data + 4, sc, m);
+    scales[g] = d * sc;
+    biases[g] = -dmin * m;
+  }
+}
+
+// Data layout is: |256 x 4bit low bits|256 x 2bit high bits|16 x 8bit scale|
+// |16 bit scale|. Weights are stored offset by 32.
+void unpack_q6_k(
+    const uint8_t* data,
+    uint8_t* q,
+    float* scales,
+    float* biases) {
+  const uint8_t* ql = data;
+  const uint8_t* qh = data + 128;
+  auto sc = reinterpret_cast<const int8_t*>(data + 192);
+  float d = load_f16(data + 208);
+  for (int i = 0; i < k_quant_block; i++) {
+    int half = i / 128;
+    int quarter = (i % 128) / 32;
+    int l = i % 32;
+    uint8_t low = ql[64 * half + 32 * (quarter % 2) + l];
+    low >>= 4 * (quarter / 2);
+    uint8_t high = qh[32 * half + l] >> (2 * quarter);
+    q[i] = (low & 0xF) | ((high & 3) << 4);
+  }
+  for (int g = 0; g < 16; g++) {
+    scales[g] = d * sc[g];
+    biases[g] = -32 * scales[g];
+  }
+}
+
+// Extracts (weight, scales, biases) from K-quant tensors one super-block at
+// a time.
+template <int bits, int group_size, typename Unpack>
+void extract_k_quant_data(
+    const gguf_tensor& tensor,
+    uint64_t bytes_per_block,
+    Unpack unpack,
+    array& weights_arr,
+    array& scales_arr,
+    array& biases_arr) {
+  constexpr int groups = k_quant_block / group_size;
+  auto data = static_cast<uint8_t*>(tensor.weights_data);
+  auto weights = weights_arr.data<uint8_t>();
+  auto scales = scales_arr.data<float16_t>();
+  auto biases = biases_arr.data<float16_t>();
+  uint8_t q[k_quant_block];
+  float block_scales[groups];
+  float block_biases[groups];
+  for (int64_t i = 0; i < scales_arr.size() / groups; i++) {
+    unpack(data, q, block_scales, block_biases);
+    pack_k_quant_block<bits>(q, weights);
+    for (int g = 0; g < groups; g++) {
+      *scales++ = static_cast<float16_t>(block_scales[g]);
+      *biases++ = static_cast<float16_t>(block_biases[g]);
+    }
+    weights += k_quant_block * bits / 8;
+    data += bytes_per_block;
+  }
+}
+
+bool gguf_is_quantized(uint32_t type) {
+  switch (type) {
+    case GGUF_TYPE_Q4_0:
+    case GGUF_TYPE_Q4_1:
+    case GGUF_TYPE_Q8_0:
+    case GGUF_TYPE_Q2_K:
+    case GGUF_TYPE_Q3_K:
+    case GGUF_TYPE_Q4_K:
+    case GGUF_TYPE_Q5_K:
+    case GGUF_TYPE_Q6_K:
+      return true;
+    default:
+      return false;
+  }
+}
+
 void gguf_load_quantized(
     std::unordered_map<std::string, array>& a,
+    std::unordered_map<std::string, GGUFMetaData>& metadata,
     const gguf_tensor& tensor) {
-  uint64_t weights_per_byte;
-  if (tensor.type == GGUF_TYPE_Q4_0 || tensor.type == GGUF_TYPE_Q4_1) {
-    weights_per_byte = 2;
-  } else { // tensor.type == GGUF_TYPE_Q8_0
-    weights_per_byte = 1;
+  int bits;
+  int group_size;
+  int block_size = 32;
+  switch (tensor.type) {
+    case GGUF_TYPE_Q4_0:
+    case GGUF_TYPE_Q4_1:
+      bits = 4;
+      group_size = 32;
+      break;
+    case GGUF_TYPE_Q8_0:
+      bits = 8;
+      group_size = 32;
+      break;
+    case GGUF_TYPE_Q2_K:
+      bits = 2;
+      group_size = 16;
+      block_size = k_quant_block;
+      break;
+    case GGUF_TYPE_Q3_K:
+      bits = 3;
+      group_size = 16;
+      block_size = k_quant_block;
+      break;
+    case GGUF_TYPE_Q4_K:
+      bits = 4;
+      group_size = 32;
+      block_size = k_quant_block;
+      break;
+    case GGUF_TYPE_Q5_K:
+      bits = 5;
+      group_size = 32;
+      block_size = k_quant_block;
+      break;
+    default: // tensor.type == GGUF_TYPE_Q6_K
+      bits = 6;
+      group_size = 16;
+      block_size = k_quant_block;
+      break;
   }
 
   std::string name(tensor.name, tensor.namelen);
 
   auto shape = get_shape(tensor);
-  const uint64_t weights_per_block = 32;
-  if (shape[shape.size() - 1] % weights_per_block != 0) {
+  if (shape[shape.size() - 1] % block_size != 0) {
     std::ostringstream msg;
     msg << "[load_gguf] tensor " << name
         << "has incompatible last dim shape: " << shape[shape.size() - 1];
@@ -119,7 +369,7 @@ void gguf_load_quantized(
   }
 
   auto weights_shape = shape;
-  weights_shape.back() /= (weights_per_byte * 4);
+  weights_shape.back() = weights_shape.back() * bits / 32;
   auto w_nbytes = uint32.size() *
       std::accumulate(weights_shape.begin(),
                       weights_shape.end(),
@@ -129,18 +379,42 @@ void gguf_load_quantized(
   array weights(allocator::malloc(w_nbytes), std::move(weights_shape), uint32);
 
   // For scales and bias
-  shape[shape.size() - 1] = shape[shape.size() - 1] / weights_per_block;
+  shape[shape.size() - 1] = shape[shape.size() - 1] / group_size;
   auto sb_nbytes = float16.size() *
       std::accumulate(shape.begin(), shape.end(), 1, std::multiplies<size_t>());
 
   array scales(allocator::malloc(sb_nbytes), shape, float16);
   array biases(allocator::malloc(sb_nbytes), std::move(shape), float16);
-  if (tensor.type == GGUF_TYPE_Q4_0) {
-    extract_q4_0_data(tensor, weights, scales, biases);
-  } else if (tensor.type == GGUF_TYPE_Q4_1) {
-    extract_q4_1_data(tensor, weights, scales, biases);
-  } else if (tensor.type == GGUF_TYPE_Q8_0) {
-    extract_q8_0_data(tensor, weights, scales, biases);
+  switch (tensor.type) {
+    case GGUF_TYPE_Q4_0:
+      extract_q4_0_data(tensor, weights, scales, biases);
+      break;
+    case GGUF_TYPE_Q4_1:
+      extract_q4_1_data(tensor, weights, scales, biases);
+      break;
+    case GGUF_TYPE_Q8_0:
+      extract_q8_0_data(tensor, weights, scales, biases);
+      break;
+    case GGUF_TYPE_Q2_K:
+      extract_k_quant_data<2, 16>(
+          tensor, 84, unpack_q2_k, weights, scales, biases);
+      break;
+    case GGUF_TYPE_Q3_K:
+      extract_k_quant_data<3, 16>(
+          tensor, 110, unpack_q3_k, weights, scales, biases);
+      break;
+    case GGUF_TYPE_Q4_K:
+      extract_k_quant_data<4, 32>(
+          tensor, 144, unpack_q4_k, weights, scales, biases);
+      break;
+    case GGUF_TYPE_Q5_K:
+      extract_k_quant_data<5, 32>(
+          tensor, 176, unpack_q5_k, weights, scales, biases);
+      break;
+    case GGUF_TYPE_Q6_K:
+      extract_k_quant_data<6, 16>(
+          tensor, 210, unpack_q6_k, weights, scales, biases);
+      break;
   }
 
   a.emplace(name, std::move(weights));
@@ -159,6 +433,8 @@ void gguf_load_quantized(
       name.substr(0, name.length() - weight_suffix.length());
   check_insert(a.emplace(name_prefix + ".scales", std::move(scales)));
   check_insert(a.emplace(name_prefix + ".biases", std::move(biases)));
+  metadata.insert_or_assign(
+      name_prefix + ".quantization", array({group_size, bits}));
 }
 
 } // namespace mlx::core
@@ -13,6 +13,10 @@
 #include <windows.h>
 #endif // _WIN32
 
+#ifndef _WIN32
+#include <sys/mman.h>
+#endif
+
 #include "mlx/io/load.h"
 #include "mlx/ops.h"
 #include "mlx/primitives.h"
@@ -388,6 +392,67 @@ void ParallelFileReader::read(char* data, size_t n, size_t offset) {
   }
 }
 
+MmapReader::MmapReader(std::string file_path, MmapOptions options)
+    : ParallelFileReader(std::move(file_path)) {
+#ifndef _WIN32
+  struct stat st;
+  if (!is_open() || fstat(fd_, &st) != 0 || st.st_size == 0) {
+    return;
+  }
+  int flags = MAP_PRIVATE;
+#ifdef MAP_POPULATE
+  if (options.populate) {
+    flags |= MAP_POPULATE;
+  }
+#endif
+  // Writable so that donated arrays can be written to, the private mapping
+  // gives them copy-on-write pages
+  void* data =
+      mmap(nullptr, st.st_size, PROT_READ | PROT_WRITE, flags, fd_, 0);
+  if (data == MAP_FAILED) {
+    return;
+  }
+  int advice = MADV_NORMAL;
+  switch (options.advice) {
+    case MmapOptions::Advice::normal:
+      break;
+    case MmapOptions::Advice::sequential:
+      advice = MADV_SEQUENTIAL;
+      break;
+    case MmapOptions::Advice::random:
+      advice = MADV_RANDOM;
+      break;
+    case MmapOptions::Advice::willneed:
+      advice = MADV_WILLNEED;
+      break;
+  }
+  if (advice != MADV_NORMAL) {
+    madvise(data, st.st_size, advice);
+  }
+#ifndef MAP_POPULATE
+  if (options.populate) {
+    madvise(data, st.st_size, MADV_WILLNEED);
+  }
+#endif
+  buffer_ = allocator::make_buffer(data, st.st_size);
+  if (buffer_.ptr() == nullptr) {
+    munmap(data, st.st_size);
+    return;
+  }
+  data_ = data;
+  size_ = st.st_size;
+#endif
+}
+
+MmapReader::~MmapReader() {
+#ifndef _WIN32
+  if (data_ != nullptr) {
+    allocator::release(buffer_);
+    munmap(data_, size_);
+  }
+#endif
+}
+
 } // namespace io
 
 } // namespace mlx::core
@@ -13,6 +13,7 @@
 #include <unistd.h>
 #endif
 
+#include "mlx/allocator.h"
 #include "mlx/threadpool.h"
 
 // Strictly we need to operate on files in binary mode (to avoid \r getting
@@ -99,13 +100,56 @@ class ParallelFileReader : public Reader {
     return "file " + label_;
   }
 
+ protected:
+  int fd_;
+
  private:
   static constexpr size_t batch_size_ = 1 << 25;
   static ThreadPool& thread_pool();
-  int fd_;
   std::string label_;
 };
 
+struct MmapOptions {
+  enum class Advice { normal, sequential, random, willneed };
+
+  // Fault in the whole file up front instead of on first touch
+  bool populate{false};
+  // Access pattern hint passed to madvise
+  Advice advice{Advice::normal};
+};
+
+// A file reader which also maps the file into memory so that loaded arrays
+// can alias the file pages instead of copying them. The mapping is private
+// and copy-on-write so writes to the arrays never reach the file. When the
+// file cannot be mapped or the allocator cannot wrap the mapping the reader
+// behaves exactly like a ParallelFileReader.
+class MmapReader : public ParallelFileReader {
+ public:
+  explicit MmapReader(std::string file_path, MmapOptions options = {});
+  ~MmapReader() override;
+
+  MmapReader(const MmapReader&) = delete;
+  MmapReader& operator=(const MmapReader&) = delete;
+
+  bool is_mapped() const {
+    return buffer_.ptr() != nullptr;
+  }
+
+  // The buffer wrapping the whole mapping, null if the file is not mapped
+  allocator::Buffer buffer() const {
+    return buffer_;
+  }
+
+  size_t size() const {
+    return size_;
+  }
+
+ private:
+  void* data_{nullptr};
+  size_t size_{0};
+  allocator::Buffer buffer_{nullptr};
+};
+
 class FileWriter : public Writer {
  public:
   explicit FileWriter(std::string file_path)
@@ -10,7 +10,10 @@ SafetensorsLoad load_safetensors(std::shared_ptr<io::Reader>, StreamOrDevice) {
       "to enable safetensors support.");
 }
 
-SafetensorsLoad load_safetensors(const std::string&, StreamOrDevice) {
+SafetensorsLoad load_safetensors(
+    const std::string&,
+    StreamOrDevice,
+    std::optional<io::MmapOptions>) {
   throw std::runtime_error(
       "[load_safetensors] Compile with MLX_BUILD_SAFETENSORS=ON "
       "to enable safetensors support.");
@@ -251,7 +251,13 @@ SafetensorsLoad load_safetensors(
   return {res, metadata_map};
 }
 
-SafetensorsLoad load_safetensors(const std::string& file, StreamOrDevice s) {
+SafetensorsLoad load_safetensors(
+    const std::string& file,
+    StreamOrDevice s,
+    std::optional<io::MmapOptions> mmap) {
+  if (mmap) {
+    return load_safetensors(std::make_shared<io::MmapReader>(file, *mmap), s);
+  }
   return load_safetensors(std::make_shared<io::ParallelFileReader>(file), s);
 }
 
@@ -75,4 +75,33 @@ void clear_cache();
  * */
 size_t set_wired_limit(size_t limit);
 
+/* Enable or disable memory planning in eval.
+ *
+ * When enabled, eval orders the graph to keep the bytes of live intermediate
+ * arrays low and plans offsets for them in a single arena where arrays with
+ * disjoint lifetimes share memory. A planned eval resets the peak memory to
+ * measure its own peak. It is disabled by default and can also be enabled
+ * with the ``MLX_EVAL_MEMORY_PLAN`` environment variable.
+ *
+ * Returns the previous setting.
+ * */
+bool set_memory_planning(bool enable);
+
+/* The memory plan of the most recent planned eval.
+ *
+ * Sizes are in bytes and do not include memory in use before the eval.
+ * */
+struct MemoryPlanReport {
+  // Number of arrays in the plan
+  size_t num_arrays{0};
+  // Peak bytes of live arrays in the planned order
+  size_t predicted_peak{0};
+  // Size of the arena holding every array at its planned offset
+  size_t arena_size{0};
+  // Measured peak active memory, only set by eval and not async_eval
+  size_t actual_peak{0};
+};
+
+MemoryPlanReport get_memory_plan_report();
+
 } // namespace mlx::core
@@ -59,6 +59,12 @@ class Primitive {
     return stream_;
   }
 
+  /** Move the primitive to another stream on the same device. Eval uses this
+   * to run independent branches of a graph on separate CPU streams. */
+  void set_stream(const Stream& stream) {
+    stream_ = stream;
+  }
+
   /**
    * A primitive must know how to evaluate itself on
    * the CPU/GPU for the given inputs and populate the output arrays.
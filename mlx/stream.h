@@ -38,4 +38,17 @@ void synchronize();
 /* Synchronize with the provided stream. */
 void synchronize(Stream);
 
+/**
+ * Set the number of CPU streams eval spreads independent branches of a graph
+ * over. Ops on the default CPU stream are moved to the other streams and
+ * fences are added where branches join. The default of 1 disables it, it can
+ * also be set with the ``MLX_EVAL_CPU_STREAMS`` environment variable.
+ *
+ * Returns the previous number of streams.
+ */
+int set_eval_cpu_streams(int n);
+
+/** Get the number of CPU streams eval spreads independent branches over. */
+int get_eval_cpu_streams();
+
 } // namespace mlx::core
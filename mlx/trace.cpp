@@ -0,0 +1,208 @@
+// Copyright © 2025 Apple Inc.
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <mutex>
+#include <sstream>
+
+#include "mlx/memory.h"
+#include "mlx/primitives.h"
+#include "mlx/trace.h"
+#include "mlx/utils.h"
+
+namespace mlx::core {
+
+namespace detail {
+
+std::atomic<bool> tracing_enabled{false};
+
+} // namespace detail
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+// Events of a trace which was restarted before they finished are dropped
+struct PendingEvent : TraceEvent {
+  int generation;
+};
+
+struct Trace {
+  std::mutex mtx;
+  std::vector<TraceEvent> events;
+  std::atomic<Clock::rep> origin{Clock::now().time_since_epoch().count()};
+  std::atomic<int> generation{0};
+};
+
+Trace& trace() {
+  static Trace trace_;
+  return trace_;
+}
+
+void write_string(std::ostream& os, const std::string& s) {
+  os << '"';
+  for (auto c : s) {
+    if (c == '"' || c == '\\') {
+      os << '\\' << c;
+    } else if (static_cast<unsigned char>(c) < 0x20) {
+      os << ' ';
+    } else {
+      os << c;
+    }
+  }
+  os << '"';
+}
+
+void write_shapes(std::ostream& os, const std::vector<Shape>& shapes) {
+  os << '[';
+  for (int i = 0; i < shapes.size(); i++) {
+    os << (i > 0 ? "," : "") << '[';
+    for (int j = 0; j < shapes[i].size(); j++) {
+      os << (j > 0 ? "," : "") << shapes[i][j];
+    }
+    os << ']';
+  }
+  os << ']';
+}
+
+} // namespace
+
+void start_trace() {
+  auto& t = trace();
+  {
+    std::lock_guard<std::mutex> lk(t.mtx);
+    t.events.clear();
+    t.origin = Clock::now().time_since_epoch().count();
+    t.generation++;
+  }
+  detail::tracing_enabled = true;
+}
+
+void stop_trace() {
+  detail::tracing_enabled = false;
+}
+
+std::vector<TraceEvent> get_trace() {
+  auto& t = trace();
+  std::vector<TraceEvent> events;
+  {
+    std::lock_guard<std::mutex> lk(t.mtx);
+    events = t.events;
+  }
+  std::stable_sort(events.begin(), events.end(), [](auto& a, auto& b) {
+    return a.start < b.start;
+  });
+  return events;
+}
+
+std::string get_chrome_trace() {
+  auto events = get_trace();
+  std::ostringstream os;
+  os.precision(3);
+  os << std::fixed;
+  os << "{\"traceEvents\":[";
+  std::vector<int> streams;
+  bool first = true;
+  auto sep = [&]() {
+    os << (first ? "\n" : ",\n");
+    first = false;
+  };
+  for (auto& e : events) {
+    sep();
+    if (e.kind == TraceEvent::primitive) {
+      if (std::find(streams.begin(), streams.end(), e.stream) ==
+          streams.end()) {
+        streams.push_back(e.stream);
+      }
+      os << "{\"name\":";
+      write_string(os, e.name);
+      os << ",\"cat\":\"primitive\",\"ph\":\"X\",\"pid\":0,\"tid\":"
+         << e.stream << ",\"ts\":" << e.start
+         << ",\"dur\":" << (e.end - e.start) << ",\"args\":{\"inputs\":";
+      write_shapes(os, e.input_shapes);
+      os << ",\"outputs\":";
+      write_shapes(os, e.output_shapes);
+      os << ",\"bytes\":" << e.bytes
+         << ",\"queued_us\":" << (e.start - e.enqueue) << "}}";
+    } else {
+      // Allocations are instants on the process and a memory counter
+      os << "{\"name\":\"" << e.name
+         << "\",\"cat\":\"allocator\",\"ph\":\"i\",\"s\":\"p\",\"pid\":0,"
+         << "\"tid\":0,\"ts\":" << e.start << ",\"args\":{\"bytes\":"
+         << e.bytes << "}},\n";
+      os << "{\"name\":\"active memory\",\"ph\":\"C\",\"pid\":0,\"ts\":"
+         << e.start << ",\"args\":{\"bytes\":" << e.active_memory << "}}";
+    }
+  }
+  for (auto s : streams) {
+    std::ostringstream name;
+    name << get_stream(s);
+    sep();
+    os << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":" << s
+       << ",\"args\":{\"name\":";
+    write_string(os, name.str());
+    os << "}}";
+  }
+  os << "\n],\"displayTimeUnit\":\"ms\"}\n";
+  return os.str();
+}
+
+void save_trace(const std::string& path) {
+  std::ofstream out(path);
+  if (!out) {
+    std::ostringstream msg;
+    msg << "[save_trace] Unable to open file " << path << ".";
+    throw std::runtime_error(msg.str());
+  }
+  out << get_chrome_trace();
+}
+
+namespace detail {
+
+double trace_time() {
+  auto origin = Clock::time_point(Clock::duration(trace().origin));
+  return std::chrono::duration<double, std::micro>(Clock::now() - origin)
+      .count();
+}
+
+std::shared_ptr<TraceEvent> trace_primitive(const array& arr) {
+  auto event = std::make_shared<PendingEvent>();
+  event->generation = trace().generation;
+  event->name = arr.primitive().name();
+  event->stream = arr.primitive().stream().index;
+  for (auto& in : arr.inputs()) {
+    event->input_shapes.push_back(in.shape());
+    event->bytes += in.nbytes();
+  }
+  for (auto& out : arr.outputs()) {
+    event->output_shapes.push_back(out.shape());
+    event->bytes += out.nbytes();
+  }
+  event->enqueue = trace_time();
+  return event;
+}
+
+void trace_record(std::shared_ptr<TraceEvent> event) {
+  auto& t = trace();
+  std::lock_guard<std::mutex> lk(t.mtx);
+  if (static_cast<PendingEvent&>(*event).generation == t.generation) {
+    t.events.push_back(std::move(*event));
+  }
+}
+
+void trace_allocation(TraceEvent::Kind kind, size_t bytes) {
+  TraceEvent event;
+  event.kind = kind;
+  event.name = kind == TraceEvent::malloc ? "malloc" : "free";
+  event.bytes = bytes;
+  event.active_memory = get_active_memory();
+  event.enqueue = event.start = event.end = trace_time();
+  auto& t = trace();
+  std::lock_guard<std::mutex> lk(t.mtx);
+  t.events.push_back(std::move(event));
+}
+
+} // namespace detail
+
+} // namespace mlx::core
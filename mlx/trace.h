@@ -0,0 +1,85 @@
+// Copyright © 2025 Apple Inc.
+
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "mlx/array.h"
+
+namespace mlx::core {
+
+/* A primitive evaluated or an allocator call made while tracing. */
+struct TraceEvent {
+  enum Kind { primitive, malloc, free };
+
+  Kind kind{primitive};
+
+  // The primitive name or "malloc" and "free"
+  std::string name;
+
+  // Index of the stream the primitive ran on, -1 for allocator events
+  int stream{-1};
+
+  std::vector<Shape> input_shapes;
+  std::vector<Shape> output_shapes;
+
+  // Bytes read and written by a primitive, or allocated and freed
+  size_t bytes{0};
+
+  // Active memory after an allocator event
+  size_t active_memory{0};
+
+  // Microseconds since the trace started. A primitive is enqueued by eval
+  // and starts and ends on the thread of its stream. Allocator events have
+  // the same three times.
+  double enqueue{0};
+  double start{0};
+  double end{0};
+};
+
+/* Start recording primitives and allocations into a new trace.
+ *
+ * Primitives on CPU streams record their name, stream, shapes and bytes and
+ * when they were enqueued, started and ended. Tracing is off by default and
+ * costs one relaxed atomic load per primitive and allocation while off.
+ * */
+void start_trace();
+
+/* Stop recording, keeping the recorded events. */
+void stop_trace();
+
+/* The events of the current or last trace sorted by start time. */
+std::vector<TraceEvent> get_trace();
+
+/* The events of the current or last trace in the Chrome trace JSON format,
+ * which can be opened with Perfetto or chrome://tracing. */
+std::string get_chrome_trace();
+
+/* Save the Chrome trace JSON to the file at `path`. */
+void save_trace(const std::string& path);
+
+namespace detail {
+
+extern std::atomic<bool> tracing_enabled;
+
+inline bool trace_enabled() {
+  return tracing_enabled.load(std::memory_order_relaxed);
+}
+
+// Microseconds since the trace started
+double trace_time();
+
+// Start an event for a primitive about to be enqueued by eval
+std::shared_ptr<TraceEvent> trace_primitive(const array& arr);
+
+// Record a finished primitive event
+void trace_record(std::shared_ptr<TraceEvent> event);
+
+void trace_allocation(TraceEvent::Kind kind, size_t bytes);
+
+} // namespace detail
+
+} // namespace mlx::core
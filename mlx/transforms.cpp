@@ -1,7 +1,10 @@
 // Copyright © 2023-2024 Apple Inc.
 #include <algorithm>
+#include <atomic>
 #include <deque>
 #include <future>
+#include <limits>
+#include <mutex>
 #include <numeric>
 #include <set>
 #include <sstream>
@@ -11,6 +14,7 @@
 
 #include "mlx/backend/cpu/eval.h"
 #include "mlx/backend/gpu/eval.h"
+#include "mlx/distributed/primitives.h"
 #include "mlx/fence.h"
 #include "mlx/memory.h"
 #include "mlx/ops.h"
@@ -49,6 +53,313 @@ std::vector<std::pair<char, char>>& detail::InTracing::trace_stack() {
 int detail::InTracing::grad_counter{0};
 int detail::RetainGraph::tracing_counter{0};
 
+namespace {
+
+std::atomic<bool>& memory_planning() {
+  static std::atomic<bool> memory_planning_{
+      env::get_var("MLX_EVAL_MEMORY_PLAN", 0) != 0};
+  return memory_planning_;
+}
+
+std::mutex memory_plan_mtx;
+MemoryPlanReport memory_plan_report;
+
+// The dependencies between the arrays of a tape. Nodes are tape positions
+// and the siblings of an array map to its node.
+struct TapeGraph {
+  explicit TapeGraph(const std::deque<array>& tape)
+      : bytes(tape.size(), 0), inputs(tape.size()), consumers(tape.size()) {
+    int n = tape.size();
+    for (int i = 0; i < n; i++) {
+      node.emplace(tape[i].id(), i);
+      if (i > 0) {
+        bytes[i] = tape[i].nbytes();
+      }
+      for (auto& s : tape[i].siblings()) {
+        node.emplace(s.id(), i);
+        bytes[i] += s.nbytes();
+      }
+    }
+    for (int i = 0; i < n; i++) {
+      for (auto& in : tape[i].inputs()) {
+        if (auto it = node.find(in.id()); it != node.end()) {
+          inputs[i].push_back(it->second);
+        }
+      }
+      std::sort(inputs[i].begin(), inputs[i].end());
+      inputs[i].erase(
+          std::unique(inputs[i].begin(), inputs[i].end()), inputs[i].end());
+      for (auto in : inputs[i]) {
+        consumers[in].push_back(i);
+      }
+    }
+  }
+
+  std::unordered_map<std::uintptr_t, int> node;
+  // Bytes of the outputs of each node
+  std::vector<size_t> bytes;
+  std::vector<std::vector<int>> inputs;
+  std::vector<std::vector<int>> consumers;
+};
+
+// Offsets in the planned arena are aligned like allocations
+constexpr size_t arena_alignment = 64;
+
+// Reorder the tape, which runs back to front with the synchronizer in front,
+// so the bytes of live arrays stay low. A ready array is scheduled by the
+// bytes it allocates minus the bytes of the inputs it is the last consumer
+// of, which favors ops that free memory and, on ties, the most recently
+// readied ops to finish a branch before starting another. Arrays are then
+// placed in an arena largest first at the lowest offset that does not
+// overlap an array with an overlapping lifetime. Returns the arena size.
+size_t plan_tape(std::deque<array>& tape) {
+  TapeGraph graph(tape);
+  int n = tape.size();
+  auto& bytes = graph.bytes;
+  auto& inputs = graph.inputs;
+  auto& consumers = graph.consumers;
+
+  // The outputs of the eval stay live after it
+  std::vector<bool> pinned(n, false);
+  for (auto in : inputs[0]) {
+    pinned[in] = true;
+  }
+
+  std::vector<int> pending(n);
+  std::vector<int> remaining(n);
+  for (int i = 0; i < n; i++) {
+    pending[i] = inputs[i].size();
+    remaining[i] = consumers[i].size();
+  }
+
+  auto delta = [&](int i) {
+    int64_t d = bytes[i];
+    for (auto in : inputs[i]) {
+      if (!pinned[in] && remaining[in] == 1) {
+        d -= bytes[in];
+      }
+    }
+    return d;
+  };
+
+  using Key = std::pair<int64_t, int64_t>;
+  std::set<std::pair<Key, int>> ready;
+  std::vector<Key> keys(n);
+  int64_t stamp = 0;
+  auto push = [&](int i) {
+    keys[i] = {delta(i), -(stamp++)};
+    ready.emplace(keys[i], i);
+  };
+  for (int i = 0; i < n; i++) {
+    if (pending[i] == 0) {
+      push(i);
+    }
+  }
+
+  std::vector<int> order;
+  std::vector<bool> done(n, false);
+  order.reserve(n);
+  while (!ready.empty()) {
+    int i = ready.begin()->second;
+    ready.erase(ready.begin());
+    order.push_back(i);
+    done[i] = true;
+    for (auto in : inputs[i]) {
+      if (--remaining[in] != 1 || pinned[in]) {
+        continue;
+      }
+      // The last consumer of the input now frees it
+      for (auto c : consumers[in]) {
+        if (!done[c] && pending[c] == 0) {
+          ready.erase({keys[c], c});
+          keys[c].first = delta(c);
+          ready.emplace(keys[c], c);
+        }
+      }
+    }
+    for (auto c : consumers[i]) {
+      if (--pending[c] == 0) {
+        push(c);
+      }
+    }
+  }
+
+  // Lifetimes in steps of the planned order
+  std::vector<int> start(n);
+  std::vector<int> end(n);
+  for (int t = 0; t < order.size(); t++) {
+    start[order[t]] = t;
+  }
+  for (int i = 0; i < n; i++) {
+    end[i] = start[i];
+    for (auto c : consumers[i]) {
+      end[i] = std::max(end[i], start[c]);
+    }
+    if (pinned[i]) {
+      end[i] = order.size();
+    }
+  }
+
+  size_t live = 0;
+  size_t peak = 0;
+  std::vector<size_t> freed(order.size() + 1, 0);
+  for (int t = 0; t < order.size(); t++) {
+    live += bytes[order[t]];
+    peak = std::max(peak, live);
+    freed[end[order[t]]] += bytes[order[t]];
+    live -= freed[t];
+  }
+
+  auto align = [](size_t x) {
+    return (x + arena_alignment - 1) / arena_alignment * arena_alignment;
+  };
+  std::vector<int> by_size(order.begin(), order.end());
+  std::stable_sort(by_size.begin(), by_size.end(), [&](int a, int b) {
+    return bytes[a] > bytes[b];
+  });
+  std::vector<size_t> offset(n, 0);
+  std::vector<int> placed;
+  size_t arena_size = 0;
+  for (auto i : by_size) {
+    if (bytes[i] == 0) {
+      continue;
+    }
+    std::vector<std::pair<size_t, size_t>> taken;
+    for (auto j : placed) {
+      if (start[j] <= end[i] && start[i] <= end[j]) {
+        taken.emplace_back(offset[j], offset[j] + align(bytes[j]));
+      }
+    }
+    std::sort(taken.begin(), taken.end());
+    size_t o = 0;
+    for (auto& [lo, hi] : taken) {
+      if (o + align(bytes[i]) <= lo) {
+        break;
+      }
+      o = std::max(o, hi);
+    }
+    offset[i] = o;
+    placed.push_back(i);
+    arena_size = std::max(arena_size, o + align(bytes[i]));
+  }
+
+  std::deque<array> planned;
+  planned.push_back(std::move(tape[0]));
+  for (auto it = order.rbegin(); it != order.rend(); ++it) {
+    if (*it != 0) {
+      planned.push_back(std::move(tape[*it]));
+    }
+  }
+  tape = std::move(planned);
+
+  std::lock_guard<std::mutex> lock(memory_plan_mtx);
+  memory_plan_report = {
+      static_cast<size_t>(n - 1), peak, arena_size, /* actual_peak = */ 0};
+  return arena_size;
+}
+
+std::atomic<int>& eval_cpu_streams() {
+  static std::atomic<int> eval_cpu_streams_{
+      std::max(env::get_var("MLX_EVAL_CPU_STREAMS", 1), 1)};
+  return eval_cpu_streams_;
+}
+
+// Ops that read and write less than this stay on the stream of their inputs
+// instead of starting a branch
+constexpr size_t min_branch_bytes = 1 << 18;
+
+bool can_move_stream(const array& a, const Stream& s) {
+  auto& p = a.primitive();
+  return !a.is_tracer() && p.stream() == s &&
+      !dynamic_cast<distributed::DistPrimitive*>(&p) &&
+      !dynamic_cast<Load*>(&p);
+}
+
+// Spread the ops of the default CPU stream over n_streams CPU streams.
+// Following the execution order, an op continues the stream of the first
+// input that has not passed its stream on to another consumer, so chains
+// stay on one stream. Other ops start a branch on the least loaded stream,
+// counting the bytes an op reads and writes as its load. Returns the new
+// stream of each moved array and its siblings by id.
+std::unordered_map<std::uintptr_t, Stream> assign_streams(
+    const std::deque<array>& tape,
+    int n_streams) {
+  static std::vector<Stream> extra_streams;
+  while (extra_streams.size() < n_streams - 1) {
+    extra_streams.push_back(new_stream(Device::cpu));
+  }
+  std::vector<Stream> pool = {default_stream(Device::cpu)};
+  pool.insert(
+      pool.end(), extra_streams.begin(), extra_streams.begin() + n_streams - 1);
+
+  TapeGraph graph(tape);
+  int n = tape.size();
+  std::vector<int> stream_of(n, -1);
+  std::vector<bool> handed_on(n, false);
+  std::vector<size_t> load(pool.size(), 0);
+  for (int i = n - 1; i > 0; i--) {
+    if (!can_move_stream(tape[i], pool[0])) {
+      continue;
+    }
+    size_t cost = graph.bytes[i];
+    for (auto& in : tape[i].inputs()) {
+      cost += in.nbytes();
+    }
+    int s = -1;
+    for (auto in : graph.inputs[i]) {
+      if (stream_of[in] >= 0 && !handed_on[in]) {
+        s = stream_of[in];
+        handed_on[in] = true;
+        break;
+      }
+    }
+    if (s < 0 && cost < min_branch_bytes) {
+      s = 0;
+      for (auto in : graph.inputs[i]) {
+        if (stream_of[in] >= 0) {
+          s = stream_of[in];
+          break;
+        }
+      }
+    } else if (s < 0) {
+      s = std::min_element(load.begin(), load.end()) - load.begin();
+    }
+    stream_of[i] = s;
+    load[s] += cost;
+  }
+
+  std::unordered_map<std::uintptr_t, Stream> moved;
+  for (int i = 1; i < n; i++) {
+    if (stream_of[i] > 0) {
+      auto& s = pool[stream_of[i]];
+      moved.emplace(tape[i].id(), s);
+      for (auto& sib : tape[i].siblings()) {
+        moved.emplace(sib.id(), s);
+      }
+    }
+  }
+  return moved;
+}
+
+} // namespace
+
+int set_eval_cpu_streams(int n) {
+  return eval_cpu_streams().exchange(std::max(n, 1));
+}
+
+int get_eval_cpu_streams() {
+  return eval_cpu_streams();
+}
+
+bool set_memory_planning(bool enable) {
+  return memory_planning().exchange(enable);
+}
+
+MemoryPlanReport get_memory_plan_report() {
+  std::lock_guard<std::mutex> lock(memory_plan_mtx);
+  return memory_plan_report;
+}
+
 array eval_impl(std::vector<array> outputs, bool async) {
   std::deque<array> tape;
 
@@ -189,13 +500,50 @@ array eval_impl(std::vector<array> outputs, bool async) {
     }
   }
 
+  // A planned eval also waits on running tasks to keep the memory allocated
+  // ahead of them within the plan. The last task is not waited on since
+  // wait_for_one returns right away for it.
+  size_t plan_limit = std::numeric_limits<size_t>::max();
+  if (memory_planning()) {
+    plan_limit = get_active_memory() + plan_tape(tape);
+  }
+  // Independent branches of the default CPU stream run on a pool of CPU
+  // streams with fences where they join
+  std::unordered_map<std::uintptr_t, Stream> moved;
+  if (int n_streams = eval_cpu_streams(); n_streams > 1) {
+    moved = assign_streams(tape, n_streams);
+  }
+  auto stream_of = [&moved](array& a) {
+    if (auto it = moved.find(a.id()); it != moved.end()) {
+      return it->second;
+    }
+    return a.primitive().stream();
+  };
+  if (!moved.empty()) {
+    needs_fence.clear();
+    for (auto& a : tape) {
+      for (auto& in : a.inputs()) {
+        if (in.status() == array::Status::unscheduled &&
+            stream_of(a) != stream_of(in)) {
+          needs_fence.emplace(in.id(), stream_of(in).index);
+        }
+      }
+    }
+  }
+
+  auto over_memory = [plan_limit]() {
+    auto active = get_active_memory();
+    return (active > get_memory_limit() && scheduler::n_active_tasks() > 0) ||
+        (active > plan_limit && scheduler::n_active_tasks() > 1);
+  };
+
   std::unordered_set<int> open_streams;
 
   while (!tape.empty()) {
     auto arr = std::move(tape.back());
     tape.pop_back();
 
-    auto stream = arr.primitive().stream();
+    auto stream = stream_of(arr);
     open_streams.insert(stream.index);
 
     if (async) {
@@ -229,13 +577,15 @@ array eval_impl(std::vector<array> outputs, bool async) {
 
     if (arr.primitive().device() == Device::gpu) {
       gpu::eval(arr);
+    } else if (auto s = arr.primitive().stream(); s != stream) {
+      arr.primitive().set_stream(stream);
+      cpu::eval(arr);
+      arr.primitive().set_stream(s);
     } else {
       cpu::eval(arr);
     }
 
-    if (scheduler::n_active_tasks() > MAX_ACTIVE_TASKS ||
-        (get_active_memory() > get_memory_limit() &&
-         scheduler::n_active_tasks() > 0)) {
+    if (scheduler::n_active_tasks() > MAX_ACTIVE_TASKS || over_memory()) {
       // Commit any open streams
       for (auto i : open_streams) {
         auto s = get_stream(i);
@@ -244,8 +594,7 @@ array eval_impl(std::vector<array> outputs, bool async) {
         }
       }
       scheduler::wait_for_one();
-      while (get_active_memory() > get_memory_limit() &&
-             scheduler::n_active_tasks() > 0) {
+      while (over_memory()) {
         scheduler::wait_for_one();
       }
     }
@@ -315,7 +664,17 @@ void eval(std::vector<array> outputs) {
     return;
   }
 
+  if (!memory_planning()) {
+    eval_impl(std::move(outputs), false).wait();
+    return;
+  }
+
+  auto active = get_active_memory();
+  reset_peak_memory();
   eval_impl(std::move(outputs), false).wait();
+  auto peak = get_peak_memory();
+  std::lock_guard<std::mutex> lock(memory_plan_mtx);
+  memory_plan_report.actual_peak = peak > active ? peak - active : 0;
 }
 
 std::pair<std::vector<array>, std::vector<array>> vjp(
@@ -160,6 +160,26 @@ inline bool metal_fast_synch() {
   return metal_fast_synch;
 }
 
+inline int cpu_num_threads() {
+  static int cpu_num_threads_ = get_var("MLX_CPU_NUM_THREADS", 0);
+  return cpu_num_threads_;
+}
+
+inline int cpu_grain_size() {
+  static int cpu_grain_size_ = get_var("MLX_CPU_GRAIN_SIZE", 32768);
+  return cpu_grain_size_;
+}
+
+inline int cpu_simd_width() {
+  static int cpu_simd_width_ = get_var("MLX_CPU_SIMD_WIDTH", 0);
+  return cpu_simd_width_;
+}
+
+inline bool cpu_async_compile() {
+  static bool cpu_async_compile_ = get_var("MLX_CPU_ASYNC_COMPILE", 1);
+  return cpu_async_compile_;
+}
+
 inline bool enable_tf32() {
   static bool enable_tf32_ = get_var("MLX_ENABLE_TF32", 1);
   return enable_tf32_;
@@ -125,6 +125,7 @@
         "src/native/array.cc",
         "src/native/dtype.cc",
         "src/native/stream.cc",
+        "src/native/trace.cc",
         "src/native/runtime.mm"
       ],
       "include_dirs": [
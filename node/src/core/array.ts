@@ -194,6 +194,43 @@ function ensureTypedArray(
 
 export type ArrayElement = number | boolean | [number, number];
 
+/**
+ * Controls whether typed array conversions copy their data.
+ *
+ * With `copy: false`, `from` lends the typed array's memory to MLX when it is
+ * page aligned (otherwise it silently copies) and keeps the buffer alive until
+ * MLX releases it. A lent buffer can no longer be transferred or detached, and
+ * on Node versions before 20, which cannot prevent that, it is always copied.
+ * Do not touch the typed array while the MLX array is in use.
+ * `toTypedArray` returns a view over the MLX buffer, which shares memory with
+ * the array for as long as the view is reachable.
+ */
+export interface ArrayCopyOptions {
+  copy?: boolean;
+}
+
+interface EvalBatch {
+  handles: any[];
+  done: Promise<void>;
+}
+
+let pendingBatch: EvalBatch | null = null;
+
+// Arrays requested during the same tick share one async_eval call, so
+// concurrent readers build a single graph evaluation instead of many.
+function scheduleEval(handles: readonly any[]): Promise<void> {
+  if (pendingBatch === null) {
+    const batch: EvalBatch = { handles: [], done: Promise.resolve() };
+    batch.done = Promise.resolve().then(() => {
+      pendingBatch = null;
+      return addon.async_eval(batch.handles);
+    });
+    pendingBatch = batch;
+  }
+  pendingBatch.handles.push(...handles);
+  return pendingBatch.done;
+}
+
 export class MLXArray {
   private readonly handle: any;
 
@@ -209,11 +246,17 @@ export class MLXArray {
     data: SupportedTypedArray | NumericArray,
     shape: readonly number[],
     dtype: DType = 'float32',
+    options: ArrayCopyOptions = {},
   ): MLXArray {
     const normalizedShape = normalizeShape(shape);
     const elements = elementCount(normalizedShape);
     const typed = ensureTypedArray(data, dtype, elements);
-    const handle = addon.Array.fromTypedArray(typed, normalizedShape, dtype);
+    const handle = addon.Array.fromTypedArray(
+      typed,
+      normalizedShape,
+      dtype,
+      options,
+    );
     return MLXArray.fromHandle(handle);
   }
 
@@ -237,8 +280,24 @@ export class MLXArray {
     return this;
   }
 
-  toTypedArray(): SupportedTypedArray {
-    return this.handle.toTypedArray();
+  /**
+   * Evaluates the array off the main thread. The returned promise resolves
+   * once the array is available, without blocking the event loop meanwhile.
+   */
+  async evalAsync(): Promise<this> {
+    await scheduleEval([this.handle]);
+    return this;
+  }
+
+  toTypedArray(options: ArrayCopyOptions = {}): SupportedTypedArray {
+    return this.handle.toTypedArray(options);
+  }
+
+  async toTypedArrayAsync(
+    options: ArrayCopyOptions = {},
+  ): Promise<SupportedTypedArray> {
+    await scheduleEval([this.handle]);
+    return this.handle.toTypedArray(options);
   }
 
   toFloat32Array(): Float32Array {
@@ -275,8 +334,14 @@ export function array(
   data: SupportedTypedArray | NumericArray,
   shape: readonly number[],
   dtype: DType = 'float32',
+  options: ArrayCopyOptions = {},
 ): MLXArray {
-  return MLXArray.from(data, shape, dtype);
+  return MLXArray.from(data, shape, dtype, options);
+}
+
+/** Evaluates all the given arrays together without blocking the event loop. */
+export function asyncEval(...arrays: MLXArray[]): Promise<void> {
+  return scheduleEval(arrays.map((a) => a.toNative()));
 }
 
 export const normalizeShapeInput = (shape: readonly number[]): number[] =>
@@ -1,11 +1,13 @@
 import MLXArray, {
   array,
+  asyncEval,
   zeros,
   zeros_like,
   ones,
   ones_like,
   full,
   type ArrayElement,
+  type ArrayCopyOptions,
 } from './array';
 import dtypeModule, {
   Dtype,
@@ -74,9 +76,17 @@ import {
   type BinaryOpOptions,
   type WhereOptions,
 } from './ops';
+import {
+  startTrace,
+  stopTrace,
+  getTrace,
+  getChromeTrace,
+  saveTrace,
+} from './trace';
 
 export type {
   ArrayElement,
+  ArrayCopyOptions,
   DTypeKey,
   DTypeCategoryKey,
   DTypeCategory,
@@ -93,7 +103,8 @@ export type {
   BinaryOpOptions,
   WhereOptions,
 } from './ops';
-export { MLXArray, MLXArray as Array, array };
+export type { TraceEvent, TraceEventKind } from './trace';
+export { MLXArray, MLXArray as Array, array, asyncEval };
 export { zeros, zeros_like, ones, ones_like, full };
 export { deviceModule as device };
 export {
@@ -107,6 +118,7 @@ export {
   withStream,
 };
 export { reshape, transpose, moveaxis, swapaxes, add, multiply, where };
+export { startTrace, stopTrace, getTrace, getChromeTrace, saveTrace };
 export {
   dtypeModule as dtype,
   Dtype,
@@ -147,6 +159,7 @@ export {
 
 const core = {
   array,
+  asyncEval,
   zeros,
   zeros_like,
   ones,
@@ -168,6 +181,11 @@ const core = {
   add,
   multiply,
   where,
+  startTrace,
+  stopTrace,
+  getTrace,
+  getChromeTrace,
+  saveTrace,
   device: deviceModule,
   Dtype,
   dtype: dtypeModule,
@@ -0,0 +1,46 @@
+import addon from '../internal/addon';
+
+export type TraceEventKind = 'primitive' | 'malloc' | 'free';
+
+/**
+ * A primitive evaluated or an allocator call made while tracing. Times are
+ * in microseconds since the trace started. Primitives also carry their
+ * stream index, shapes and enqueue and end times, allocator events the
+ * active memory after them.
+ */
+export interface TraceEvent {
+  kind: TraceEventKind;
+  name: string;
+  bytes: number;
+  start: number;
+  stream?: number;
+  inputShapes?: number[][];
+  outputShapes?: number[][];
+  enqueue?: number;
+  end?: number;
+  activeMemory?: number;
+}
+
+/** Starts recording evaluated primitives and allocations into a new trace. */
+export function startTrace(): void {
+  addon.start_trace();
+}
+
+/** Stops recording, keeping the recorded events. */
+export function stopTrace(): void {
+  addon.stop_trace();
+}
+
+/** The events of the current or last trace sorted by start time. */
+export function getTrace(): TraceEvent[] {
+  return addon.get_trace() as TraceEvent[];
+}
+
+/** The current or last trace as Chrome trace JSON, for Perfetto. */
+export function getChromeTrace(): string {
+  return addon.get_chrome_trace() as string;
+}
+
+export function saveTrace(path: string): void {
+  addon.save_trace(path);
+}
@@ -22,6 +22,7 @@ export const defaultStream = core.defaultStream;
 export const newStream = core.newStream;
 export const setDefaultStream = core.setDefaultStream;
 export const synchronize = core.synchronize;
+export const asyncEval = core.asyncEval;
 export const streamContext = core.streamContext;
 export const stream = core.stream;
 export const withStream = core.withStream;
@@ -33,6 +34,11 @@ export const swapaxes = core.swapaxes;
 export const add = core.add;
 export const multiply = core.multiply;
 export const where = core.where;
+export const startTrace = core.startTrace;
+export const stopTrace = core.stopTrace;
+export const getTrace = core.getTrace;
+export const getChromeTrace = core.getChromeTrace;
+export const saveTrace = core.saveTrace;
 
 export default {
   native,
@@ -64,4 +70,9 @@ export default {
   add,
   multiply,
   where,
+  startTrace,
+  stopTrace,
+  getTrace,
+  getChromeTrace,
+  saveTrace,
 };
@@ -2,18 +2,52 @@
 
 namespace mlx::node {
 
+ReferenceReleaser::ReferenceReleaser(Napi::Env env)
+    : tsfn_(ThreadSafeFunction::New(env, "mlx.releaseReference", 0, 1)) {
+  // Pending releases must not keep the process alive
+  tsfn_.Unref(env);
+}
+
+void ReferenceReleaser::Release(Reference* ref) {
+  std::lock_guard<std::mutex> lk(mtx_);
+  if (closed_) {
+    return;
+  }
+  tsfn_.NonBlockingCall(ref);
+}
+
+void ReferenceReleaser::Close() {
+  std::lock_guard<std::mutex> lk(mtx_);
+  closed_ = true;
+}
+
+void ReferenceReleaser::CallJs(
+    Napi::Env env,
+    Napi::Function,
+    std::nullptr_t*,
+    Reference* ref) {
+  // A null env means the function is being torn down with the environment
+  if (env != nullptr) {
+    delete ref;
+  }
+}
+
 AddonData::~AddonData() {
   array_constructor.Reset();
   dtype_constructor.Reset();
   dtype_category_constructor.Reset();
   stream_constructor.Reset();
   stream_context_constructor.Reset();
+  if (releaser) {
+    releaser->Close();
+  }
 }
 
 AddonData& GetAddonData(Napi::Env env) {
   auto* data = env.GetInstanceData<AddonData>();
   if (data == nullptr) {
     data = new AddonData();
+    data->releaser = std::make_shared<ReferenceReleaser>(env);
     // Attach instance data with the default finalizer provided by node-addon-api,
     // which will delete the pointer exactly once at env teardown.
     env.SetInstanceData<AddonData>(data);
@@ -1,15 +1,47 @@
 #pragma once
 
+#include <memory>
+#include <mutex>
+
 #include <napi.h>
 
 namespace mlx::node {
 
+// Deletes references to JS objects on the JS thread. MLX can drop the last
+// owner of a buffer from one of its stream threads, so releasing memory
+// borrowed from JS is handed back to the event loop.
+class ReferenceReleaser {
+ public:
+  using Reference = Napi::Reference<Napi::ArrayBuffer>;
+
+  explicit ReferenceReleaser(Napi::Env env);
+
+  // Safe to call from any thread. References released after the environment
+  // is torn down are leaked, which is harmless at exit.
+  void Release(Reference* ref);
+  void Close();
+
+ private:
+  static void
+  CallJs(Napi::Env env, Napi::Function, std::nullptr_t*, Reference* ref);
+
+  using ThreadSafeFunction = Napi::TypedThreadSafeFunction<
+      std::nullptr_t,
+      Reference,
+      &ReferenceReleaser::CallJs>;
+
+  std::mutex mtx_;
+  bool closed_{false};
+  ThreadSafeFunction tsfn_;
+};
+
 struct AddonData {
   Napi::FunctionReference array_constructor;
   Napi::FunctionReference dtype_constructor;
   Napi::FunctionReference dtype_category_constructor;
   Napi::FunctionReference stream_constructor;
   Napi::FunctionReference stream_context_constructor;
+  std::shared_ptr<ReferenceReleaser> releaser;
 
   ~AddonData();
 };
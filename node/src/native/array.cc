@@ -1,19 +1,28 @@
 #include <algorithm>
+#include <atomic>
 #include <cstring>
 #include <memory>
+#include <mutex>
 #include <numeric>
 #include <optional>
 #include <string>
+#include <unistd.h>
 #include <unordered_map>
 #include <vector>
 
 #include <napi.h>
+#include <node_version.h>
+#if NODE_MAJOR_VERSION >= 20
+#include <v8.h>
+#endif
 
 #include "addon_data.h"
+#include "mlx/allocator.h"
 #include "mlx/array.h"
 #include "mlx/dtype_utils.h"
 #include "mlx/mlx.h"
 #include "mlx/ops.h"
+#include "mlx/scheduler.h"
 #include "mlx/backend/gpu/available.h"
 #include "mlx/backend/metal/metal.h"
 #include "mlx/backend/metal/device.h"
@@ -23,6 +32,7 @@
 #include "mlx/types/complex.h"
 #include "mlx/types/half_types.h"
 #include "stream.h"
+#include "trace.h"
 #include "runtime.h"
 
 namespace {
@@ -198,23 +208,110 @@ class ArrayWrapper : public Napi::ObjectWrap<ArrayWrapper> {
     return shapeValues;
   }
 
-  template <typename T>
-  static std::vector<T> CopyTypedArray(const Napi::TypedArray& typed) {
-    size_t length = typed.ElementLength();
-    std::vector<T> output(length);
-    std::memcpy(
-        output.data(),
-        static_cast<const uint8_t*>(typed.ArrayBuffer().Data()) +
-            typed.ByteOffset(),
-        length * sizeof(T));
-    return output;
+  // Parses the optional `{ copy }` argument of the typed array conversions.
+  // Copying stays the default so that JS and MLX never alias by accident.
+  static bool ParseCopyOption(Napi::Env env, const Napi::Value& value) {
+    if (value.IsUndefined() || value.IsNull()) {
+      return true;
+    }
+    if (!value.IsObject()) {
+      Napi::TypeError::New(env, "Options must be an object")
+          .ThrowAsJavaScriptException();
+      return true;
+    }
+    auto copy = value.As<Napi::Object>().Get("copy");
+    if (copy.IsUndefined()) {
+      return true;
+    }
+    if (!copy.IsBoolean()) {
+      Napi::TypeError::New(env, "options.copy must be a boolean")
+          .ThrowAsJavaScriptException();
+      return true;
+    }
+    return copy.As<Napi::Boolean>().Value();
+  }
+
+  // Makes the ArrayBuffer non detachable so JS cannot transfer its memory
+  // away (postMessage, structuredClone or ArrayBuffer.prototype.transfer now
+  // throw) while MLX reads it. The buffer stays pinned for the rest of its
+  // life. Returns false when the running Node cannot pin buffers.
+  static bool PinArrayBuffer(Napi::ArrayBuffer& arrayBuffer) {
+#if NODE_MAJOR_VERSION >= 20
+    // napi_value is a v8::Local<v8::Value> in Node
+    napi_value value = arrayBuffer;
+    v8::Local<v8::Value> local;
+    static_assert(sizeof(local) == sizeof(value));
+    std::memcpy(&local, &value, sizeof(value));
+    auto buffer = local.As<v8::ArrayBuffer>();
+    if (buffer->IsDetachable()) {
+      auto* isolate = v8::Isolate::GetCurrent();
+      buffer->SetDetachKey(v8::Object::New(isolate));
+    }
+    return true;
+#else
+    return false;
+#endif
+  }
+
+  // Wraps the typed array's backing store in a Metal buffer without copying.
+  // Metal can only map page aligned memory, so small or unaligned inputs
+  // return nullopt and are copied instead, as are buffers which cannot be
+  // pinned (see PinArrayBuffer). The ArrayBuffer is kept alive by a
+  // persistent reference which is dropped on the JS thread once MLX frees the
+  // buffer.
+  static std::optional<mlx::core::array> BorrowTypedArray(
+      Napi::Env env,
+      const TypedArray& typed,
+      const mlx::core::Shape& shape,
+      mlx::core::Dtype dtype) {
+    if (!mlx::core::metal::is_available()) {
+      return {};
+    }
+    auto arrayBuffer = typed.ArrayBuffer();
+    auto* data =
+        static_cast<uint8_t*>(arrayBuffer.Data()) + typed.ByteOffset();
+    const size_t nbytes = typed.ByteLength();
+    const size_t page = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    if (nbytes == 0 || reinterpret_cast<uintptr_t>(data) % page != 0) {
+      return {};
+    }
+    if (!PinArrayBuffer(arrayBuffer)) {
+      return {};
+    }
+
+    // The mapping is rounded up to whole pages. The tail of the last page is
+    // mapped whenever its head is, and kernels never read past nbytes.
+    auto* mtlDevice =
+        mlx::core::metal::device(mlx::core::Device::gpu).mtl_device();
+    auto* buffer = mtlDevice->newBuffer(
+        data,
+        (nbytes + page - 1) / page * page,
+        MTL::ResourceStorageModeShared |
+            MTL::ResourceHazardTrackingModeUntracked,
+        nullptr);
+    if (buffer == nullptr) {
+      return {};
+    }
+
+    auto* ref = new mlx::node::ReferenceReleaser::Reference(
+        Napi::Persistent(arrayBuffer));
+    auto releaser = mlx::node::GetAddonData(env).releaser;
+    return mlx::core::array(
+        mlx::core::allocator::Buffer(buffer),
+        shape,
+        dtype,
+        [ref, releaser](mlx::core::allocator::Buffer buf) {
+          static_cast<MTL::Buffer*>(buf.ptr())->release();
+          releaser->Release(ref);
+        });
   }
 
   static std::optional<mlx::core::array> MakeArrayFromTyped(
       Napi::Env env,
       const TypedArray& typed,
       const Napi::Array& shapeArray,
-      std::optional<mlx::core::Dtype> requestedDtype) {
+      std::optional<mlx::core::Dtype> requestedDtype,
+      bool copy = true) {
     size_t elementCount = 1;
     auto shapeValues = ExtractShape(env, shapeArray, elementCount);
     if (env.IsExceptionPending()) {
@@ -331,6 +428,13 @@ class ArrayWrapper : public Napi::ObjectWrap<ArrayWrapper> {
         break;
     }
 
+    if (typed.ArrayBuffer().IsDetached()) {
+      Napi::TypeError::New(
+          env, "Cannot create an array from a detached ArrayBuffer")
+          .ThrowAsJavaScriptException();
+      return {};
+    }
+
     if (dtype != mlx::core::complex64 && elementCount != typedLength) {
       Napi::RangeError::New(env, "Shape does not match data length")
           .ThrowAsJavaScriptException();
@@ -347,78 +451,26 @@ class ArrayWrapper : public Napi::ObjectWrap<ArrayWrapper> {
       shape.push_back(dim);
     }
 
-    switch (dtype) {
-      case mlx::core::float32: {
-        auto host = CopyTypedArray<float>(typed);
-        return mlx::core::array(host.begin(), shape, dtype);
-      }
-      case mlx::core::float64: {
-        auto host = CopyTypedArray<double>(typed);
-        return mlx::core::array(host.begin(), shape, dtype);
-      }
-      case mlx::core::int8: {
-        auto host = CopyTypedArray<int8_t>(typed);
-        return mlx::core::array(host.begin(), shape, dtype);
-      }
-      case mlx::core::uint8: {
-        auto host = CopyTypedArray<uint8_t>(typed);
-        return mlx::core::array(host.begin(), shape, dtype);
-      }
-      case mlx::core::bool_: {
-        std::vector<bool> host(typedLength);
-        const uint8_t* src = reinterpret_cast<const uint8_t*>(rawData);
-        for (size_t i = 0; i < typedLength; ++i) {
-          host[i] = src[i] != 0;
-        }
-        return mlx::core::array(host.begin(), shape, dtype);
+    // bool is the only dtype whose JS layout differs from MLX, as any non
+    // zero byte has to be normalized to 1.
+    if (!copy && dtype != mlx::core::bool_) {
+      if (auto borrowed = BorrowTypedArray(env, typed, shape, dtype)) {
+        return borrowed;
       }
-      case mlx::core::int16: {
-        auto host = CopyTypedArray<int16_t>(typed);
-        return mlx::core::array(host.begin(), shape, dtype);
-      }
-      case mlx::core::uint16: {
-        auto host = CopyTypedArray<uint16_t>(typed);
-        return mlx::core::array(host.begin(), shape, dtype);
-      }
-      case mlx::core::float16: {
-        std::vector<mlx::core::float16_t> host(typedLength);
-        std::memcpy(host.data(), rawData, typedLength * sizeof(uint16_t));
-        return mlx::core::array(host.begin(), shape, dtype);
-      }
-      case mlx::core::bfloat16: {
-        std::vector<mlx::core::bfloat16_t> host(typedLength);
-        std::memcpy(host.data(), rawData, typedLength * sizeof(uint16_t));
-        return mlx::core::array(host.begin(), shape, dtype);
-      }
-      case mlx::core::int32: {
-        auto host = CopyTypedArray<int32_t>(typed);
-        return mlx::core::array(host.begin(), shape, dtype);
-      }
-      case mlx::core::uint32: {
-        auto host = CopyTypedArray<uint32_t>(typed);
-        return mlx::core::array(host.begin(), shape, dtype);
-      }
-      case mlx::core::int64: {
-        auto host = CopyTypedArray<int64_t>(typed);
-        return mlx::core::array(host.begin(), shape, dtype);
-      }
-      case mlx::core::uint64: {
-        auto host = CopyTypedArray<uint64_t>(typed);
-        return mlx::core::array(host.begin(), shape, dtype);
-      }
-      case mlx::core::complex64: {
-        const float* src = reinterpret_cast<const float*>(rawData);
-        std::vector<mlx::core::complex64_t> host(elementCount);
-        for (size_t i = 0; i < elementCount; ++i) {
-          host[i] = mlx::core::complex64_t(src[2 * i], src[2 * i + 1]);
-        }
-        return mlx::core::array(host.begin(), shape, dtype);
+    }
+
+    // Copy once, straight into MLX owned memory
+    const size_t nbytes = elementCount * dtype.size();
+    auto buffer = mlx::core::allocator::malloc(nbytes);
+    auto* dst = static_cast<uint8_t*>(buffer.raw_ptr());
+    if (dtype == mlx::core::bool_) {
+      for (size_t i = 0; i < typedLength; ++i) {
+        dst[i] = rawData[i] != 0;
       }
-      default:
-        Napi::TypeError::New(env, "Unsupported dtype conversion")
-            .ThrowAsJavaScriptException();
-        return {};
+    } else if (nbytes > 0) {
+      std::memcpy(dst, rawData, nbytes);
     }
+    return mlx::core::array(buffer, std::move(shape), dtype);
   }
 
   static Napi::Value FromFloat32Array(const Napi::CallbackInfo& info) {
@@ -463,12 +515,17 @@ class ArrayWrapper : public Napi::ObjectWrap<ArrayWrapper> {
         return env.Null();
       }
     }
+    bool copy = info.Length() >= 4 ? ParseCopyOption(env, info[3]) : true;
+    if (env.IsExceptionPending()) {
+      return env.Null();
+    }
 
     auto tensor = MakeArrayFromTyped(
         env,
         info[0].As<Napi::TypedArray>(),
         info[1].As<Napi::Array>(),
-        dtype);
+        dtype,
+        copy);
     if (!tensor) {
       return env.Null();
     }
@@ -505,117 +562,97 @@ class ArrayWrapper : public Napi::ObjectWrap<ArrayWrapper> {
 
   Napi::Value ToFloat32Array(const Napi::CallbackInfo& info) {
     auto env = info.Env();
-    auto& arr = const_cast<mlx::core::array&>(tensor());
-    arr.eval();
+    if (tensor().dtype() != mlx::core::float32) {
+      Napi::TypeError::New(env, "Array dtype is not float32")
+          .ThrowAsJavaScriptException();
+      return env.Null();
+    }
+    return ToTypedArray(info);
+  }
 
-    const auto length = arr.size();
-    Napi::ArrayBuffer buffer =
-        Napi::ArrayBuffer::New(env, length * sizeof(float));
-    Napi::Float32Array jsArray =
-        Napi::Float32Array::New(env, length, buffer, 0);
-    std::memcpy(buffer.Data(), arr.data<float>(), length * sizeof(float));
-    return jsArray;
+  // Exposes the memory of an evaluated row contiguous array as an external
+  // ArrayBuffer. A copy of the array is the finalizer hint so the MLX buffer
+  // lives as long as JS can reach it. Returns nullopt when the runtime does
+  // not allow external buffers.
+  static std::optional<Napi::ArrayBuffer> ExternalArrayBuffer(
+      Napi::Env env,
+      const mlx::core::array& arr) {
+    auto* keepAlive = new mlx::core::array(arr);
+    try {
+      return Napi::ArrayBuffer::New(
+          env,
+          keepAlive->data<void>(),
+          keepAlive->nbytes(),
+          [](Napi::Env /*env*/, void* /*data*/, mlx::core::array* hint) {
+            delete hint;
+          },
+          keepAlive);
+    } catch (const Napi::Error&) {
+      delete keepAlive;
+      return {};
+    }
   }
 
   Napi::Value ToTypedArray(const Napi::CallbackInfo& info) {
     auto env = info.Env();
-    auto& arr = const_cast<mlx::core::array&>(tensor());
+    bool copy = info.Length() >= 1 ? ParseCopyOption(env, info[0]) : true;
+    if (env.IsExceptionPending()) {
+      return env.Null();
+    }
+
+    auto arr = tensor();
     arr.eval();
+    if (!arr.flags().row_contiguous) {
+      arr = mlx::core::contiguous(arr);
+      arr.eval();
+    }
 
     const auto dtype = arr.dtype();
     const size_t length = arr.size();
+    const size_t nbytes = arr.nbytes();
+
+    // bool and complex64 are stored as 0/1 bytes and interleaved float pairs,
+    // which are exactly the layouts of their JS views.
+    std::optional<Napi::ArrayBuffer> external;
+    if (!copy && nbytes > 0) {
+      external = ExternalArrayBuffer(env, arr);
+    }
+    Napi::ArrayBuffer buffer;
+    if (external) {
+      buffer = *external;
+    } else {
+      buffer = Napi::ArrayBuffer::New(env, nbytes);
+      if (nbytes > 0) {
+        std::memcpy(buffer.Data(), arr.data<void>(), nbytes);
+      }
+    }
 
     switch (dtype) {
       case mlx::core::float32:
-        return ToFloat32Array(info);
-      case mlx::core::float64: {
-        auto buffer = Napi::ArrayBuffer::New(env, length * sizeof(double));
-        auto jsArray = Napi::Float64Array::New(env, length, buffer, 0);
-        std::memcpy(buffer.Data(), arr.data<double>(), length * sizeof(double));
-        return jsArray;
-      }
-      case mlx::core::int8: {
-        auto buffer = Napi::ArrayBuffer::New(env, length * sizeof(int8_t));
-        auto jsArray = Napi::Int8Array::New(env, length, buffer, 0);
-        std::memcpy(buffer.Data(), arr.data<int8_t>(), length * sizeof(int8_t));
-        return jsArray;
-      }
+        return Napi::Float32Array::New(env, length, buffer, 0);
+      case mlx::core::float64:
+        return Napi::Float64Array::New(env, length, buffer, 0);
+      case mlx::core::int8:
+        return Napi::Int8Array::New(env, length, buffer, 0);
       case mlx::core::uint8:
-      case mlx::core::bool_: {
-        auto buffer = Napi::ArrayBuffer::New(env, length * sizeof(uint8_t));
-        auto jsArray = Napi::Uint8Array::New(env, length, buffer, 0);
-        if (dtype == mlx::core::bool_) {
-          auto src = arr.data<bool>();
-          auto dest = static_cast<uint8_t*>(buffer.Data());
-          for (size_t i = 0; i < length; ++i) {
-            dest[i] = src[i] ? 1 : 0;
-          }
-        } else {
-          std::memcpy(buffer.Data(), arr.data<uint8_t>(), length * sizeof(uint8_t));
-        }
-        return jsArray;
-      }
-      case mlx::core::int16: {
-        auto buffer = Napi::ArrayBuffer::New(env, length * sizeof(int16_t));
-        auto jsArray = Napi::Int16Array::New(env, length, buffer, 0);
-        std::memcpy(buffer.Data(), arr.data<int16_t>(), length * sizeof(int16_t));
-        return jsArray;
-      }
-      case mlx::core::uint16: {
-        auto buffer = Napi::ArrayBuffer::New(env, length * sizeof(uint16_t));
-        auto jsArray = Napi::Uint16Array::New(env, length, buffer, 0);
-        std::memcpy(buffer.Data(), arr.data<uint16_t>(), length * sizeof(uint16_t));
-        return jsArray;
-      }
-      case mlx::core::float16: {
-        auto buffer = Napi::ArrayBuffer::New(env, length * sizeof(uint16_t));
-        auto jsArray = Napi::Uint16Array::New(env, length, buffer, 0);
-        std::memcpy(buffer.Data(), arr.data<mlx::core::float16_t>(),
-                    length * sizeof(uint16_t));
-        return jsArray;
-      }
-      case mlx::core::bfloat16: {
-        auto buffer = Napi::ArrayBuffer::New(env, length * sizeof(uint16_t));
-        auto jsArray = Napi::Uint16Array::New(env, length, buffer, 0);
-        std::memcpy(buffer.Data(), arr.data<mlx::core::bfloat16_t>(),
-                    length * sizeof(uint16_t));
-        return jsArray;
-      }
-      case mlx::core::int32: {
-        auto buffer = Napi::ArrayBuffer::New(env, length * sizeof(int32_t));
-        auto jsArray = Napi::Int32Array::New(env, length, buffer, 0);
-        std::memcpy(buffer.Data(), arr.data<int32_t>(), length * sizeof(int32_t));
-        return jsArray;
-      }
-      case mlx::core::uint32: {
-        auto buffer = Napi::ArrayBuffer::New(env, length * sizeof(uint32_t));
-        auto jsArray = Napi::Uint32Array::New(env, length, buffer, 0);
-        std::memcpy(buffer.Data(), arr.data<uint32_t>(), length * sizeof(uint32_t));
-        return jsArray;
-      }
-      case mlx::core::int64: {
-        auto buffer = Napi::ArrayBuffer::New(env, length * sizeof(int64_t));
-        auto jsArray = Napi::BigInt64Array::New(env, length, buffer, 0);
-        std::memcpy(buffer.Data(), arr.data<int64_t>(), length * sizeof(int64_t));
-        return jsArray;
-      }
-      case mlx::core::uint64: {
-        auto buffer = Napi::ArrayBuffer::New(env, length * sizeof(uint64_t));
-        auto jsArray = Napi::BigUint64Array::New(env, length, buffer, 0);
-        std::memcpy(buffer.Data(), arr.data<uint64_t>(), length * sizeof(uint64_t));
-        return jsArray;
-      }
-      case mlx::core::complex64: {
-        auto buffer = Napi::ArrayBuffer::New(env, length * 2 * sizeof(float));
-        auto jsArray = Napi::Float32Array::New(env, length * 2, buffer, 0);
-        auto src = arr.data<mlx::core::complex64_t>();
-        auto dest = static_cast<float*>(buffer.Data());
-        for (size_t i = 0; i < length; ++i) {
-          dest[2 * i] = src[i].real();
-          dest[2 * i + 1] = src[i].imag();
-        }
-        return jsArray;
-      }
+      case mlx::core::bool_:
+        return Napi::Uint8Array::New(env, length, buffer, 0);
+      case mlx::core::int16:
+        return Napi::Int16Array::New(env, length, buffer, 0);
+      case mlx::core::uint16:
+      case mlx::core::float16:
+      case mlx::core::bfloat16:
+        return Napi::Uint16Array::New(env, length, buffer, 0);
+      case mlx::core::int32:
+        return Napi::Int32Array::New(env, length, buffer, 0);
+      case mlx::core::uint32:
+        return Napi::Uint32Array::New(env, length, buffer, 0);
+      case mlx::core::int64:
+        return Napi::BigInt64Array::New(env, length, buffer, 0);
+      case mlx::core::uint64:
+        return Napi::BigUint64Array::New(env, length, buffer, 0);
+      case mlx::core::complex64:
+        return Napi::Float32Array::New(env, length * 2, buffer, 0);
       default:
         Napi::TypeError::New(env, "Unsupported dtype for toTypedArray")
             .ThrowAsJavaScriptException();
@@ -1834,6 +1871,149 @@ Napi::Value Where(const Napi::CallbackInfo& info) {
   return WrapArray(env, tensor);
 }
 
+// An async_eval waiting for its stream events. Freed on the JS thread once
+// the promise is settled.
+struct PendingEval {
+  Napi::Promise::Deferred deferred;
+  std::vector<mlx::core::array> arrays;
+  std::atomic<size_t> remaining{0};
+  std::mutex mtx;
+  std::string error;
+};
+
+// Marks the arrays available again and settles the promise. Only the events
+// are touched off the JS thread.
+void FinishEval(
+    Napi::Env env,
+    Napi::Function,
+    std::nullptr_t*,
+    PendingEval* pending) {
+  std::unique_ptr<PendingEval> owned(pending);
+  // A null env means the function is being torn down with the environment
+  if (env == nullptr) {
+    return;
+  }
+  if (pending->error.empty()) {
+    try {
+      for (auto& a : pending->arrays) {
+        a.wait();
+      }
+    } catch (const std::exception& e) {
+      pending->error = e.what();
+    }
+  }
+  if (pending->error.empty()) {
+    pending->deferred.Resolve(env.Undefined());
+  } else {
+    pending->deferred.Reject(Napi::Error::New(env, pending->error).Value());
+  }
+}
+
+using EvalCompletion =
+    Napi::TypedThreadSafeFunction<std::nullptr_t, PendingEval, &FinishEval>;
+
+// GPU events have no completion callback, they are waited on by a single
+// stream thread shared by every async_eval
+const mlx::core::Stream& CompletionStream() {
+  static auto stream = mlx::core::new_stream(mlx::core::Device::cpu);
+  return stream;
+}
+
+// Hands the pending eval back to the JS thread once every event is signaled.
+// An event of a CPU stream is signaled by a task already queued on that
+// stream, so the check queued behind it runs without blocking anything.
+void NotifyOnCompletion(
+    Napi::Env env,
+    std::unique_ptr<PendingEval> pending,
+    std::vector<mlx::core::Event> events) {
+  if (events.empty()) {
+    FinishEval(env, {}, nullptr, pending.release());
+    return;
+  }
+  auto tsfn = EvalCompletion::New(env, "mlx.asyncEval", 0, 1);
+  pending->remaining = events.size();
+  auto* state = pending.release();
+  for (auto& event : events) {
+    auto stream = event.stream().device == mlx::core::Device::cpu
+        ? event.stream()
+        : CompletionStream();
+    auto done = [state, tsfn, event]() mutable {
+      try {
+        event.wait();
+      } catch (const std::exception& e) {
+        std::lock_guard<std::mutex> lk(state->mtx);
+        state->error = e.what();
+      }
+      if (--state->remaining == 0) {
+        tsfn.NonBlockingCall(state);
+        tsfn.Release();
+      }
+    };
+    try {
+      mlx::core::scheduler::enqueue(stream, std::move(done));
+    } catch (const std::exception& e) {
+      // The stream is shutting down, settle the promise with the error
+      {
+        std::lock_guard<std::mutex> lk(state->mtx);
+        state->error = e.what();
+      }
+      if (--state->remaining == 0) {
+        tsfn.NonBlockingCall(state);
+        tsfn.Release();
+      }
+    }
+  }
+}
+
+// async_eval(...arrays) schedules every array in a single graph evaluation
+// and returns a promise which resolves once all of them are available.
+// Arguments may be arrays or JS lists of arrays.
+Napi::Value AsyncEval(const Napi::CallbackInfo& info) {
+  auto env = info.Env();
+  std::vector<mlx::core::array> arrays;
+  auto append = [&](const Napi::Value& value) {
+    auto* wrapper = UnwrapArray(env, value);
+    if (wrapper != nullptr) {
+      arrays.push_back(wrapper->tensor());
+    }
+  };
+  for (size_t i = 0; i < info.Length(); ++i) {
+    if (info[i].IsArray()) {
+      auto list = info[i].As<Napi::Array>();
+      for (uint32_t j = 0; j < list.Length() && !env.IsExceptionPending();
+           ++j) {
+        append(list.Get(j));
+      }
+    } else {
+      append(info[i]);
+    }
+    if (env.IsExceptionPending()) {
+      return env.Null();
+    }
+  }
+
+  auto deferred = Napi::Promise::Deferred::New(env);
+  try {
+    mlx::core::async_eval(arrays);
+  } catch (const std::exception& e) {
+    deferred.Reject(Napi::Error::New(env, e.what()).Value());
+    return deferred.Promise();
+  }
+  std::vector<mlx::core::Event> events;
+  for (auto& a : arrays) {
+    if (!a.is_available() && a.event().valid()) {
+      events.push_back(a.event());
+    }
+  }
+  auto promise = deferred.Promise();
+  NotifyOnCompletion(
+      env,
+      std::unique_ptr<PendingEval>(
+          new PendingEval{deferred, std::move(arrays)}),
+      std::move(events));
+  return promise;
+}
+
 Napi::Value Hello(const Napi::CallbackInfo& info) {
   auto env = info.Env();
   const auto version = mlx::core::version();
@@ -1935,6 +2115,7 @@ Napi::Object Init(Napi::Env env, Napi::Object exports) {
   mlx::node::InitDtype(env, core, data);
   mlx::node::InitDtype(env, mlx, data);
   mlx::node::InitStreamBindings(env, core, data);
+  mlx::node::InitTraceBindings(env, core, data);
 
   // Classes and ops under core
   ArrayWrapper::Init(env, core);
@@ -1954,6 +2135,8 @@ Napi::Object Init(Napi::Env env, Napi::Object exports) {
   core.Set("multiply", Napi::Function::New(env, Multiply, "multiply", &data));
   core.Set("matmul", Napi::Function::New(env, Matmul, "matmul", &data));
   core.Set("where", Napi::Function::New(env, Where, "where", &data));
+  core.Set(
+      "async_eval", Napi::Function::New(env, AsyncEval, "async_eval", &data));
 
   // (already initialized dtype/streams above)
 
@@ -0,0 +1,114 @@
+#include "trace.h"
+
+#include <string>
+#include <vector>
+
+#include "mlx/trace.h"
+
+namespace mlx::node {
+namespace {
+
+using mlx::core::TraceEvent;
+
+Napi::Array ShapesToArray(
+    Napi::Env env,
+    const std::vector<mlx::core::Shape>& shapes) {
+  auto result = Napi::Array::New(env, shapes.size());
+  for (uint32_t i = 0; i < shapes.size(); ++i) {
+    auto dims = Napi::Array::New(env, shapes[i].size());
+    for (uint32_t j = 0; j < shapes[i].size(); ++j) {
+      dims.Set(j, Napi::Number::New(env, shapes[i][j]));
+    }
+    result.Set(i, dims);
+  }
+  return result;
+}
+
+const char* KindName(TraceEvent::Kind kind) {
+  switch (kind) {
+    case TraceEvent::primitive:
+      return "primitive";
+    case TraceEvent::malloc:
+      return "malloc";
+    default:
+      return "free";
+  }
+}
+
+Napi::Value StartTrace(const Napi::CallbackInfo& info) {
+  mlx::core::start_trace();
+  return info.Env().Undefined();
+}
+
+Napi::Value StopTrace(const Napi::CallbackInfo& info) {
+  mlx::core::stop_trace();
+  return info.Env().Undefined();
+}
+
+Napi::Value GetTrace(const Napi::CallbackInfo& info) {
+  auto env = info.Env();
+  auto events = mlx::core::get_trace();
+  auto result = Napi::Array::New(env, events.size());
+  for (uint32_t i = 0; i < events.size(); ++i) {
+    auto& e = events[i];
+    auto obj = Napi::Object::New(env);
+    obj.Set("kind", KindName(e.kind));
+    obj.Set("name", e.name);
+    obj.Set("bytes", Napi::Number::New(env, static_cast<double>(e.bytes)));
+    obj.Set("start", Napi::Number::New(env, e.start));
+    if (e.kind == TraceEvent::primitive) {
+      obj.Set("stream", Napi::Number::New(env, e.stream));
+      obj.Set("inputShapes", ShapesToArray(env, e.input_shapes));
+      obj.Set("outputShapes", ShapesToArray(env, e.output_shapes));
+      obj.Set("enqueue", Napi::Number::New(env, e.enqueue));
+      obj.Set("end", Napi::Number::New(env, e.end));
+    } else {
+      obj.Set(
+          "activeMemory",
+          Napi::Number::New(env, static_cast<double>(e.active_memory)));
+    }
+    result.Set(i, obj);
+  }
+  return result;
+}
+
+Napi::Value GetChromeTrace(const Napi::CallbackInfo& info) {
+  return Napi::String::New(info.Env(), mlx::core::get_chrome_trace());
+}
+
+Napi::Value SaveTrace(const Napi::CallbackInfo& info) {
+  auto env = info.Env();
+  if (info.Length() < 1 || !info[0].IsString()) {
+    Napi::TypeError::New(env, "save_trace expects a file path")
+        .ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+  try {
+    mlx::core::save_trace(info[0].As<Napi::String>().Utf8Value());
+  } catch (const std::exception& e) {
+    Napi::Error::New(env, e.what()).ThrowAsJavaScriptException();
+  }
+  return env.Undefined();
+}
+
+} // namespace
+
+void InitTraceBindings(Napi::Env env, Napi::Object exports, AddonData& data) {
+  exports.Set(
+      "start_trace",
+      Napi::Function::New(env, StartTrace, "start_trace", &data));
+  exports.Set(
+      "stop_trace",
+      Napi::Function::New(env, StopTrace, "stop_trace", &data));
+  exports.Set(
+      "get_trace",
+      Napi::Function::New(env, GetTrace, "get_trace", &data));
+  exports.Set(
+      "get_chrome_trace",
+      Napi::Function::New(env, GetChromeTrace, "get_chrome_trace", &data));
+  exports.Set(
+      "save_trace",
+      Napi::Function::New(env, SaveTrace, "save_trace", &data));
+}
+
+} // namespace mlx::node
@@ -0,0 +1,11 @@
+#pragma once
+
+#include <napi.h>
+
+#include "addon_data.h"
+
+namespace mlx::node {
+
+void InitTraceBindings(Napi::Env env, Napi::Object exports, AddonData& data);
+
+}
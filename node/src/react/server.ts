@@ -1,5 +1,10 @@
-import { eventStreamResponse } from '../streaming';
-import type { SSEOptions, StreamSource, StreamValue } from '../streaming';
+import { binaryStreamResponse, eventStreamResponse } from '../streaming';
+import type {
+  BinaryStreamOptions,
+  SSEOptions,
+  StreamSource,
+  StreamValue,
+} from '../streaming';
 
 export type StreamPayload = StreamValue;
 
@@ -23,3 +28,13 @@ export function createStreamHandler<TArgs extends unknown[]>(
     return eventStreamResponse(source, options);
   };
 }
+
+export function createBinaryStreamHandler<TArgs extends unknown[]>(
+  producer: StreamProducer<TArgs>,
+  options?: BinaryStreamOptions,
+): StreamHandler<TArgs> {
+  return async (...args: TArgs) => {
+    const source = await producer(...args);
+    return binaryStreamResponse(source, options);
+  };
+}
@@ -0,0 +1,614 @@
+import MLXArray from '../core/array';
+import { streamContext as createStreamContext } from '../core/stream';
+import { fromBase64 } from './encoding';
+import { resolveTensorFrameOptions, tensorToFrames } from './tensors';
+import type {
+  BinaryStreamOptions,
+  SSEMessage,
+  StreamSource,
+  StreamValue,
+  TensorDType,
+  TensorStreamFrame,
+} from './types';
+
+/*
+ * Binary tensor stream format. Every frame starts with an 8 byte header
+ *
+ *   u8 kind | u8 flags | u16 reserved | u32 payload length
+ *
+ * followed by its payload. All integers are little endian.
+ *
+ *   header:    u32 slot | u8 dtype | u8 ndim | u16 id length |
+ *              u32 dims[ndim] | utf8 id | JSON metadata (optional)
+ *   data:      u32 slot | u32 sequence | bytes (deflate-raw if flags & 1)
+ *   end:       u32 slot | JSON metadata (optional)
+ *   error:     JSON { message, tensorId, recoverable, metadata }
+ *   heartbeat: f64 timestamp
+ *   text:      utf8 text, for plain string and SSE message values
+ *
+ * Slots are small per stream handles for tensor ids, so data frames do not
+ * repeat the id. Tensor data is always row major.
+ */
+
+export const BINARY_STREAM_CONTENT_TYPE = 'application/vnd.mlx.tensor-stream';
+
+export type BinaryStreamFrame =
+  | TensorStreamFrame
+  | { type: 'text'; data: string };
+
+const FRAME_HEADER_BYTES = 8;
+const FLAG_DEFLATE = 1;
+const DEFAULT_HIGH_WATER_MARK = 1 << 20;
+const WEBSOCKET_OPEN = 1;
+
+const FrameKind = {
+  header: 1,
+  data: 2,
+  end: 3,
+  error: 4,
+  heartbeat: 5,
+  text: 6,
+} as const;
+
+const DTYPES: readonly TensorDType[] = [
+  'bool',
+  'uint8',
+  'uint16',
+  'uint32',
+  'uint64',
+  'int8',
+  'int16',
+  'int32',
+  'int64',
+  'float16',
+  'bfloat16',
+  'float32',
+  'float64',
+  'complex64',
+];
+
+const textEncoder = new TextEncoder();
+const textDecoder = new TextDecoder();
+
+function toBytes(input: ArrayBuffer | ArrayBufferView): Uint8Array {
+  if (input instanceof Uint8Array) {
+    return input;
+  }
+  if (input instanceof ArrayBuffer) {
+    return new Uint8Array(input);
+  }
+  return new Uint8Array(input.buffer, input.byteOffset, input.byteLength);
+}
+
+function encodeJson(value: unknown): Uint8Array {
+  return value === undefined
+    ? new Uint8Array(0)
+    : textEncoder.encode(JSON.stringify(value));
+}
+
+function decodeJson<T>(bytes: Uint8Array): T | undefined {
+  return bytes.byteLength === 0
+    ? undefined
+    : (JSON.parse(textDecoder.decode(bytes)) as T);
+}
+
+async function pipeBytes(
+  data: Uint8Array,
+  transform: CompressionStream | DecompressionStream,
+): Promise<Uint8Array> {
+  const piped = new Blob([data]).stream().pipeThrough(transform);
+  return new Uint8Array(await new Response(piped).arrayBuffer());
+}
+
+// Encodes the frame header and the fixed size part of the payload into one
+// buffer. The variable part is returned separately so tensor chunks can be
+// sent straight from the MLX buffer.
+function framePrefix(
+  kind: number,
+  flags: number,
+  fixedBytes: number,
+  bodyBytes: number,
+): { bytes: Uint8Array; view: DataView } {
+  const bytes = new Uint8Array(FRAME_HEADER_BYTES + fixedBytes);
+  const view = new DataView(bytes.buffer);
+  view.setUint8(0, kind);
+  view.setUint8(1, flags);
+  view.setUint32(4, fixedBytes + bodyBytes, true);
+  return { bytes, view };
+}
+
+// Header fields are fixed width, so values which do not fit are rejected
+// rather than silently wrapped
+function checkRange(name: string, value: number, max: number): void {
+  if (!Number.isInteger(value) || value < 0 || value > max) {
+    throw new RangeError(
+      `Binary stream ${name} must be an integer in [0, ${max}], got ${value}`,
+    );
+  }
+}
+
+/**
+ * Turns frames into binary parts. Parts of one frame must be sent in order
+ * and may be concatenated into a single message.
+ */
+export class BinaryFrameEncoder {
+  private readonly slots = new Map<string, number>();
+  private nextSlot = 0;
+
+  constructor(private readonly compression: 'none' | 'deflate' = 'none') {}
+
+  async encode(frame: BinaryStreamFrame): Promise<Uint8Array[]> {
+    switch (frame.type) {
+      case 'header': {
+        const slot = this.nextSlot++;
+        this.slots.set(frame.tensorId, slot);
+        const dtype = DTYPES.indexOf(frame.dtype);
+        if (dtype < 0) {
+          throw new Error(`Unsupported dtype ${frame.dtype}`);
+        }
+        const id = textEncoder.encode(frame.tensorId);
+        checkRange('ndim', frame.shape.length, 0xff);
+        checkRange('tensor id length', id.byteLength, 0xffff);
+        frame.shape.forEach((dim) => checkRange('dimension', dim, 0xffffffff));
+        const metadata = encodeJson(frame.metadata);
+        const fixed = 8 + 4 * frame.shape.length;
+        const { bytes, view } = framePrefix(
+          FrameKind.header,
+          0,
+          fixed,
+          id.byteLength + metadata.byteLength,
+        );
+        view.setUint32(8, slot, true);
+        view.setUint8(12, dtype);
+        view.setUint8(13, frame.shape.length);
+        view.setUint16(14, id.byteLength, true);
+        frame.shape.forEach((dim, i) => {
+          view.setUint32(16 + 4 * i, dim, true);
+        });
+        return [bytes, id, metadata];
+      }
+      case 'data': {
+        const slot = this.slotOf(frame.tensorId);
+        let body =
+          typeof frame.data === 'string'
+            ? frame.encoding === 'json'
+              ? textEncoder.encode(frame.data)
+              : fromBase64(frame.data)
+            : toBytes(frame.data);
+        let flags = 0;
+        if (this.compression === 'deflate' && body.byteLength > 0) {
+          const compressed = await pipeBytes(
+            body,
+            new CompressionStream('deflate-raw'),
+          );
+          if (compressed.byteLength < body.byteLength) {
+            body = compressed;
+            flags |= FLAG_DEFLATE;
+          }
+        }
+        const { bytes, view } = framePrefix(
+          FrameKind.data,
+          flags,
+          8,
+          body.byteLength,
+        );
+        view.setUint32(8, slot, true);
+        view.setUint32(12, frame.sequence ?? 0, true);
+        return [bytes, body];
+      }
+      case 'end': {
+        const slot = this.slotOf(frame.tensorId);
+        this.slots.delete(frame.tensorId);
+        const metadata = encodeJson(frame.metadata);
+        const { bytes, view } = framePrefix(
+          FrameKind.end,
+          0,
+          4,
+          metadata.byteLength,
+        );
+        view.setUint32(8, slot, true);
+        return [bytes, metadata];
+      }
+      case 'error': {
+        const body = encodeJson({
+          message: frame.message,
+          tensorId: frame.tensorId,
+          recoverable: frame.recoverable,
+          metadata: frame.metadata,
+        });
+        return [framePrefix(FrameKind.error, 0, 0, body.byteLength).bytes, body];
+      }
+      case 'heartbeat': {
+        const { bytes, view } = framePrefix(FrameKind.heartbeat, 0, 8, 0);
+        view.setFloat64(8, frame.timestamp, true);
+        return [bytes];
+      }
+      case 'text': {
+        const body = textEncoder.encode(frame.data);
+        return [framePrefix(FrameKind.text, 0, 0, body.byteLength).bytes, body];
+      }
+      default: {
+        const exhaustive: never = frame;
+        throw new Error(`Unknown tensor stream frame ${(exhaustive as any)?.type}`);
+      }
+    }
+  }
+
+  private slotOf(tensorId: string): number {
+    const slot = this.slots.get(tensorId);
+    if (slot === undefined) {
+      throw new Error(`Tensor ${tensorId} was sent before its header`);
+    }
+    return slot;
+  }
+}
+
+/**
+ * Parses binary frames from arbitrarily split chunks, such as the body of a
+ * chunked HTTP response or a sequence of WebSocket messages.
+ */
+export class BinaryFrameDecoder {
+  private readonly tensorIds = new Map<number, string>();
+  private pending = new Uint8Array(0);
+
+  async push(
+    chunk: ArrayBuffer | ArrayBufferView,
+  ): Promise<BinaryStreamFrame[]> {
+    const bytes = toBytes(chunk);
+    if (this.pending.byteLength === 0) {
+      this.pending = bytes;
+    } else {
+      const joined = new Uint8Array(this.pending.byteLength + bytes.byteLength);
+      joined.set(this.pending, 0);
+      joined.set(bytes, this.pending.byteLength);
+      this.pending = joined;
+    }
+
+    const frames: BinaryStreamFrame[] = [];
+    while (this.pending.byteLength >= FRAME_HEADER_BYTES) {
+      const header = new DataView(
+        this.pending.buffer,
+        this.pending.byteOffset,
+        FRAME_HEADER_BYTES,
+      );
+      const length = header.getUint32(4, true);
+      if (this.pending.byteLength < FRAME_HEADER_BYTES + length) {
+        break;
+      }
+      const payload = this.pending.subarray(
+        FRAME_HEADER_BYTES,
+        FRAME_HEADER_BYTES + length,
+      );
+      this.pending = this.pending.subarray(FRAME_HEADER_BYTES + length);
+      frames.push(
+        // eslint-disable-next-line no-await-in-loop
+        await this.decode(header.getUint8(0), header.getUint8(1), payload),
+      );
+    }
+    return frames;
+  }
+
+  /** Whether a partial frame is still waiting for more bytes. */
+  get hasPending(): boolean {
+    return this.pending.byteLength > 0;
+  }
+
+  private async decode(
+    kind: number,
+    flags: number,
+    payload: Uint8Array,
+  ): Promise<BinaryStreamFrame> {
+    const view = new DataView(
+      payload.buffer,
+      payload.byteOffset,
+      payload.byteLength,
+    );
+    switch (kind) {
+      case FrameKind.header: {
+        const slot = view.getUint32(0, true);
+        const ndim = view.getUint8(5);
+        const idLength = view.getUint16(6, true);
+        const shape: number[] = [];
+        for (let i = 0; i < ndim; i += 1) {
+          shape.push(view.getUint32(8 + 4 * i, true));
+        }
+        const idStart = 8 + 4 * ndim;
+        const tensorId = textDecoder.decode(
+          payload.subarray(idStart, idStart + idLength),
+        );
+        this.tensorIds.set(slot, tensorId);
+        return {
+          type: 'header',
+          tensorId,
+          shape,
+          dtype: DTYPES[view.getUint8(4)],
+          metadata: decodeJson(payload.subarray(idStart + idLength)),
+        };
+      }
+      case FrameKind.data: {
+        let data = payload.subarray(8);
+        if (flags & FLAG_DEFLATE) {
+          data = await pipeBytes(data, new DecompressionStream('deflate-raw'));
+        }
+        return {
+          type: 'data',
+          tensorId: this.tensorIdOf(view.getUint32(0, true)),
+          data,
+          encoding: 'binary',
+          sequence: view.getUint32(4, true),
+          byteLength: data.byteLength,
+        };
+      }
+      case FrameKind.end: {
+        const slot = view.getUint32(0, true);
+        const tensorId = this.tensorIdOf(slot);
+        this.tensorIds.delete(slot);
+        return {
+          type: 'end',
+          tensorId,
+          metadata: decodeJson(payload.subarray(4)),
+        };
+      }
+      case FrameKind.error:
+        return {
+          type: 'error',
+          ...(decodeJson<{ message: string }>(payload) ?? { message: '' }),
+        };
+      case FrameKind.heartbeat:
+        return { type: 'heartbeat', timestamp: view.getFloat64(0, true) };
+      case FrameKind.text:
+        return { type: 'text', data: textDecoder.decode(payload) };
+      default:
+        throw new Error(`Unknown binary frame kind ${kind}`);
+    }
+  }
+
+  private tensorIdOf(slot: number): string {
+    const tensorId = this.tensorIds.get(slot);
+    if (tensorId === undefined) {
+      throw new Error(`Binary frame refers to unknown tensor slot ${slot}`);
+    }
+    return tensorId;
+  }
+}
+
+function toAsyncIterable<T>(source: StreamSource<T>): AsyncIterable<T> {
+  const resolved = typeof source === 'function' ? source() : source;
+  if (resolved == null) {
+    throw new Error('Stream source returned null/undefined');
+  }
+  if (Symbol.asyncIterator in resolved) {
+    return resolved as AsyncIterable<T>;
+  }
+  return (async function* iterate() {
+    yield* (resolved as Iterable<T>);
+  })();
+}
+
+function isSSEMessage(value: object): value is SSEMessage {
+  return 'data' in value && typeof (value as SSEMessage).data === 'string';
+}
+
+// Flattens a stream source into frames. Tensors are read back asynchronously
+// and chunked into views over their MLX buffers.
+async function* sourceFrames(
+  source: StreamSource<StreamValue>,
+  options?: BinaryStreamOptions,
+): AsyncGenerator<BinaryStreamFrame> {
+  let tensorIndex = 0;
+
+  async function* flatten(
+    value: StreamValue | undefined | null,
+  ): AsyncGenerator<BinaryStreamFrame> {
+    if (value == null) {
+      return;
+    }
+    if (typeof value === 'string') {
+      yield { type: 'text', data: value };
+      return;
+    }
+    if (value instanceof MLXArray) {
+      const index = tensorIndex++;
+      const frameOptions = resolveTensorFrameOptions(
+        value,
+        index,
+        options?.tensor,
+      );
+      yield* tensorToFrames(
+        value,
+        { ...frameOptions, encoding: 'binary' },
+        index,
+      );
+      return;
+    }
+    if ('then' in value) {
+      yield* flatten(await value);
+      return;
+    }
+    if (Symbol.asyncIterator in value) {
+      for await (const inner of value as AsyncIterable<StreamValue>) {
+        yield* flatten(inner);
+      }
+      return;
+    }
+    if (Symbol.iterator in value) {
+      for (const inner of value as Iterable<StreamValue>) {
+        yield* flatten(inner);
+      }
+      return;
+    }
+    if ('type' in value && typeof value.type === 'string') {
+      yield value as TensorStreamFrame;
+      return;
+    }
+    if (isSSEMessage(value)) {
+      yield { type: 'text', data: value.data };
+      return;
+    }
+    throw new Error('Unsupported value provided to binary stream');
+  }
+
+  const ctx = options?.stream ? createStreamContext(options.stream) : null;
+  ctx?.enter();
+  try {
+    for await (const value of toAsyncIterable(source)) {
+      yield* flatten(value);
+    }
+  } finally {
+    ctx?.exit();
+  }
+}
+
+/**
+ * Creates a byte stream of binary tensor frames. Frames are produced on
+ * demand, so a slow consumer pauses evaluation and readback once
+ * `highWaterMark` bytes are queued.
+ */
+export function createBinaryStream(
+  source: StreamSource<StreamValue>,
+  options?: BinaryStreamOptions,
+): ReadableStream<Uint8Array> {
+  const frames = sourceFrames(source, options);
+  const encoder = new BinaryFrameEncoder(options?.compression);
+  const signal = options?.signal;
+
+  return new ReadableStream<Uint8Array>(
+    {
+      async pull(controller) {
+        if (signal?.aborted) {
+          await frames.return(undefined);
+          controller.close();
+          return;
+        }
+        const next = await frames.next();
+        if (next.done) {
+          controller.close();
+          return;
+        }
+        for (const part of await encoder.encode(next.value)) {
+          if (part.byteLength > 0) {
+            controller.enqueue(part);
+          }
+        }
+      },
+      async cancel() {
+        await frames.return(undefined);
+      },
+    },
+    new ByteLengthQueuingStrategy({
+      highWaterMark: options?.highWaterMark ?? DEFAULT_HIGH_WATER_MARK,
+    }),
+  );
+}
+
+/** Streams binary tensor frames as a chunked HTTP response. */
+export function binaryStreamResponse(
+  source: StreamSource<StreamValue>,
+  options?: BinaryStreamOptions,
+): Response {
+  const stream = createBinaryStream(source, options);
+  const headers = new Headers({
+    'Content-Type': BINARY_STREAM_CONTENT_TYPE,
+    'Cache-Control': 'no-cache, no-transform',
+  });
+  if (options?.headers) {
+    Object.entries(options.headers).forEach(([key, value]) => {
+      headers.set(key, value);
+    });
+  }
+  return new Response(stream, { headers });
+}
+
+export interface BinaryWebSocketLike {
+  readonly readyState: number;
+  /**
+   * Queues a message and calls `callback` once it is written out or failed,
+   * like `send` of a Node `ws` WebSocket.
+   */
+  send(data: ArrayBufferView, callback: (error?: Error | null) => void): void;
+}
+
+/**
+ * Sends binary tensor frames over a WebSocket, one frame per message. The
+ * producer waits while more than `highWaterMark` sent bytes are still queued
+ * by the socket, resuming from the send callbacks as the queue drains, and
+ * stops once the socket is no longer open.
+ */
+export async function sendBinaryFrames(
+  socket: BinaryWebSocketLike,
+  source: StreamSource<StreamValue>,
+  options?: BinaryStreamOptions,
+): Promise<void> {
+  const encoder = new BinaryFrameEncoder(options?.compression);
+  const highWaterMark = options?.highWaterMark ?? DEFAULT_HIGH_WATER_MARK;
+  let queued = 0;
+  let failure: Error | undefined;
+  let drained: (() => void) | undefined;
+
+  const onSent = (bytes: number) => (error?: Error | null) => {
+    queued -= bytes;
+    if (error && !failure) {
+      failure = error;
+    }
+    if (drained && (queued <= highWaterMark || failure)) {
+      drained();
+      drained = undefined;
+    }
+  };
+
+  for await (const frame of sourceFrames(source, options)) {
+    if (queued > highWaterMark && !failure) {
+      // eslint-disable-next-line no-await-in-loop
+      await new Promise<void>((resolve) => {
+        drained = resolve;
+      });
+    }
+    if (socket.readyState !== WEBSOCKET_OPEN || options?.signal?.aborted) {
+      return;
+    }
+    if (failure) {
+      throw failure;
+    }
+    const parts = await encoder.encode(frame);
+    const length = parts.reduce((total, part) => total + part.byteLength, 0);
+    const message = new Uint8Array(length);
+    let offset = 0;
+    for (const part of parts) {
+      message.set(part, offset);
+      offset += part.byteLength;
+    }
+    queued += length;
+    socket.send(message, onSent(length));
+  }
+}
+
+/** Decodes a binary tensor stream, e.g. the body of a fetch response. */
+export async function* decodeBinaryStream(
+  stream: ReadableStream<Uint8Array> | AsyncIterable<Uint8Array>,
+): AsyncIterable<BinaryStreamFrame> {
+  const decoder = new BinaryFrameDecoder();
+  const chunks: AsyncIterable<Uint8Array> =
+    Symbol.asyncIterator in stream
+      ? (stream as AsyncIterable<Uint8Array>)
+      : (async function* read() {
+          const reader = (stream as ReadableStream<Uint8Array>).getReader();
+          try {
+            while (true) {
+              // eslint-disable-next-line no-await-in-loop
+              const { done, value } = await reader.read();
+              if (done) {
+                return;
+              }
+              yield value;
+            }
+          } finally {
+            reader.releaseLock();
+          }
+        })();
+  for await (const chunk of chunks) {
+    yield* await decoder.push(chunk);
+  }
+  if (decoder.hasPending) {
+    throw new Error('Binary tensor stream ended in the middle of a frame');
+  }
+}
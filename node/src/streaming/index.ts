@@ -2,3 +2,4 @@ export * from './types';
 export * from './encoding';
 export * from './sse';
 export * from './tensors';
+export * from './binary';
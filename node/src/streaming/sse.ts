@@ -1,7 +1,7 @@
 import MLXArray from '../core/array';
 import { streamContext as createStreamContext } from '../core/stream';
 import { frameToMessage } from './encoding';
-import { tensorToFrames } from './tensors';
+import { resolveTensorFrameOptions, tensorToFrames } from './tensors';
 import type {
   SSEMessage,
   SSEOptions,
@@ -72,20 +72,6 @@ function isSSEMessage(value: unknown): value is SSEMessage {
   );
 }
 
-function resolveFactoryValue<T>(
-  value:
-      | T
-      | ((tensor: MLXArray, index: number) => T)
-      | undefined,
-  tensor: MLXArray,
-  index: number,
-): T | undefined {
-  if (typeof value === 'function') {
-    return (value as (tensor: MLXArray, index: number) => T)(tensor, index);
-  }
-  return value;
-}
-
 function getHeartbeatInterval(options?: SSEOptions): number | undefined {
   const { heartbeatIntervalMs } = options ?? {};
   if (heartbeatIntervalMs === undefined) {
@@ -147,25 +133,9 @@ export function createEventStream(
 
       const emitTensor = async (tensor: MLXArray) => {
         const currentIndex = tensorIndex++;
-        const chunkBytes = tensorOptions?.chunkBytes;
-        const metadata = tensorOptions?.metadata
-          ? resolveFactoryValue(tensorOptions.metadata, tensor, currentIndex)
-          : undefined;
-        const endMetadata = tensorOptions?.endMetadata
-          ? resolveFactoryValue(tensorOptions.endMetadata, tensor, currentIndex)
-          : undefined;
-        const tensorId = tensorOptions?.idFactory
-          ? tensorOptions.idFactory(tensor, currentIndex)
-          : undefined;
-
         for await (const frame of tensorToFrames(
             tensor,
-            {
-              tensorId,
-              chunkBytes,
-              metadata,
-              endMetadata,
-            },
+            resolveTensorFrameOptions(tensor, currentIndex, tensorOptions),
             currentIndex,
         )) {
           pushFrame(frame);
@@ -1,12 +1,45 @@
 import MLXArray from '../core/array';
 import { toBase64 } from './encoding';
-import type { TensorFrameOptions, TensorStreamFrame } from './types';
+import type {
+  TensorFrameOptions,
+  TensorStreamConfig,
+  TensorStreamFrame,
+} from './types';
 
-function getTensorView(tensor: MLXArray): Uint8Array {
-  const typed = tensor.toTypedArray();
+// Chunks are views over the evaluated MLX buffer. Each view keeps the array
+// alive, so the frames stay valid after the tensor goes out of scope.
+async function getTensorView(tensor: MLXArray): Promise<Uint8Array> {
+  const typed = await tensor.toTypedArrayAsync({ copy: false });
   return new Uint8Array(typed.buffer, typed.byteOffset, typed.byteLength);
 }
 
+function resolveFactoryValue<T>(
+  value:
+      | T
+      | ((tensor: MLXArray, index: number) => T)
+      | undefined,
+  tensor: MLXArray,
+  index: number,
+): T | undefined {
+  if (typeof value === 'function') {
+    return (value as (tensor: MLXArray, index: number) => T)(tensor, index);
+  }
+  return value;
+}
+
+export function resolveTensorFrameOptions(
+  tensor: MLXArray,
+  index: number,
+  config?: TensorStreamConfig,
+): TensorFrameOptions {
+  return {
+    tensorId: config?.idFactory ? config.idFactory(tensor, index) : undefined,
+    chunkBytes: config?.chunkBytes,
+    metadata: resolveFactoryValue(config?.metadata, tensor, index),
+    endMetadata: resolveFactoryValue(config?.endMetadata, tensor, index),
+  };
+}
+
 function defaultTensorId(index: number): string {
   if (typeof crypto !== 'undefined' && typeof crypto.randomUUID === 'function') {
     return crypto.randomUUID();
@@ -27,10 +60,10 @@ export async function* tensorToFrames(
   }
 
   const tensorId = options?.tensorId ?? defaultTensorId(index);
-  tensor.eval();
+  const binary = options?.encoding === 'binary';
+  const view = await getTensorView(tensor);
   const shape = tensor.shape;
   const dtype = tensor.dtype;
-  const view = getTensorView(tensor);
 
   yield {
     type: 'header',
@@ -48,8 +81,8 @@ export async function* tensorToFrames(
       yield {
         type: 'data',
         tensorId,
-        data: toBase64(chunk),
-        encoding: 'base64',
+        data: binary ? chunk : toBase64(chunk),
+        encoding: binary ? 'binary' : 'base64',
         sequence: sequence++,
         byteLength: chunk.byteLength,
       };
@@ -81,6 +81,11 @@ export interface SSEOptions {
 export interface TensorFrameOptions {
   tensorId?: string;
   chunkBytes?: number;
+  /**
+   * `binary` yields raw chunk views instead of base64 strings, for transports
+   * which can carry bytes.
+   */
+  encoding?: 'base64' | 'binary';
   metadata?: Record<string, unknown>;
   endMetadata?: Record<string, unknown>;
 }
@@ -96,6 +101,17 @@ export interface TensorStreamConfig {
       | ((tensor: MLXArray, index: number) => Record<string, unknown> | undefined);
 }
 
+export interface BinaryStreamOptions {
+  signal?: AbortSignal;
+  headers?: Record<string, string>;
+  tensor?: TensorStreamConfig;
+  stream?: StreamLike;
+  /** Deflate each data chunk, keeping it raw when that does not shrink it. */
+  compression?: 'none' | 'deflate';
+  /** Bytes buffered by the consumer before the producer pauses. */
+  highWaterMark?: number;
+}
+
 export type StreamValue =
   | SSEMessage
   | TensorStreamFrame
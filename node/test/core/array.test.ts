@@ -61,6 +61,67 @@ describe('mlx.core.array', () => {
     assert.deepEqual(viaClass.toArray(), [0, 1]);
   });
 
+  it('round-trips typed arrays without copying', () => {
+    // Large buffers are page aligned and borrowed, small ones are copied
+    for (const [length, borrowed] of [[1 << 16, true], [5, false]] as const) {
+      const data = new Float32Array(length).map((_, i) => i);
+      const arr = mlx.core.array(data, [length], 'float32', { copy: false });
+
+      // Writes to the source show through only when MLX borrowed it
+      data[0] = -1;
+      const view = arr.toTypedArray({ copy: false });
+      assert.ok(view instanceof Float32Array);
+      assert.equal(view.length, length);
+      assert.equal(view[0], borrowed ? -1 : 0);
+      assert.equal(view[length - 1], length - 1);
+    }
+  });
+
+  it('pins borrowed buffers and rejects detached ones', () => {
+    const data = new Float32Array(1 << 16);
+    const arr = mlx.core.array(data, [1 << 16], 'float32', { copy: false });
+    assert.throws(() =>
+      structuredClone(data.buffer, { transfer: [data.buffer] }),
+    );
+    assert.equal(arr.toTypedArray()[0], 0);
+
+    const detached = new Float32Array(4);
+    structuredClone(detached.buffer, { transfer: [detached.buffer] });
+    assert.throws(
+      () => mlx.core.array(detached, [0], 'float32', { copy: false }),
+      TypeError,
+    );
+  });
+
+  it('exports non-contiguous arrays in logical order', () => {
+    const data = new Int32Array([1, 2, 3, 4, 5, 6]);
+    const arr = mlx.core.array(data, [2, 3], 'int32');
+    const transposed = mlx.core.transpose(arr);
+    assert.deepEqual(transposed.toArray(), [1, 4, 2, 5, 3, 6]);
+    assert.deepEqual(
+      Array.from(transposed.toTypedArray({ copy: false }) as Int32Array),
+      [1, 4, 2, 5, 3, 6],
+    );
+  });
+
+  it('evaluates and reads back asynchronously', async () => {
+    const a = mlx.core.array(new Float32Array([1, 2, 3]), [3], 'float32');
+    const b = mlx.core.add(a, a);
+    const c = mlx.core.multiply(b, a);
+
+    const [bData, cData] = await Promise.all([
+      b.toTypedArrayAsync(),
+      c.toTypedArrayAsync(),
+    ]);
+    assert.deepEqual(Array.from(bData as Float32Array), [2, 4, 6]);
+    assert.deepEqual(Array.from(cData as Float32Array), [2, 8, 18]);
+
+    const d = mlx.core.add(c, a);
+    await mlx.core.asyncEval(d);
+    assert.equal(await d.evalAsync(), d);
+    assert.deepEqual(d.toArray(), [3, 10, 21]);
+  });
+
   it('creates scalar-filled arrays', () => {
     const zeros = mlx.core.zeros([2, 3], 'float32');
     assert.deepEqual(zeros.shape, [2, 3]);
@@ -0,0 +1,47 @@
+import { strict as assert } from 'node:assert';
+import mlx, {
+  array,
+  add,
+  multiply,
+  newStream,
+  withStream,
+  startTrace,
+  stopTrace,
+  getTrace,
+  getChromeTrace,
+} from '../../src';
+
+describe('core trace', () => {
+  it('records primitives evaluated on cpu streams', async () => {
+    const stream = newStream('cpu');
+    await withStream(stream, () => {
+      const a = array([1, 2, 3, 4], [2, 2]);
+      a.eval();
+
+      startTrace();
+      const b = multiply(add(a, a), a);
+      b.eval();
+      mlx.core.synchronize(stream);
+      stopTrace();
+    });
+
+    const primitives = getTrace().filter(
+      (e) => e.kind === 'primitive' && e.name !== 'Synchronize',
+    );
+    assert.deepEqual(
+      primitives.map((e) => e.name),
+      ['Add', 'Multiply'],
+    );
+    for (const e of primitives) {
+      assert.equal(e.stream, stream.index);
+      assert.deepEqual(e.inputShapes, [[2, 2], [2, 2]]);
+      assert.deepEqual(e.outputShapes, [[2, 2]]);
+      assert.equal(e.bytes, 48);
+      assert.ok(e.enqueue! <= e.start && e.start <= e.end!);
+    }
+
+    const trace = JSON.parse(getChromeTrace());
+    const names = trace.traceEvents.map((e: { name: string }) => e.name);
+    assert.ok(names.includes('Add'));
+  });
+});
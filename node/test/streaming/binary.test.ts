@@ -0,0 +1,142 @@
+import { strict as assert } from 'assert';
+import mlx from '../../src';
+import {
+  BinaryFrameDecoder,
+  BinaryFrameEncoder,
+  createBinaryStream,
+  decodeBinaryStream,
+  sendBinaryFrames,
+} from '../../src/streaming';
+import type { BinaryStreamFrame } from '../../src/streaming';
+
+async function collect<T>(iterable: AsyncIterable<T>): Promise<T[]> {
+  const items: T[] = [];
+  for await (const item of iterable) {
+    items.push(item);
+  }
+  return items;
+}
+
+describe('binary tensor streaming', () => {
+  it('round-trips frames split across arbitrary chunks', async () => {
+    const encoder = new BinaryFrameEncoder('deflate');
+    const frames: BinaryStreamFrame[] = [
+      { type: 'header', tensorId: 't0', shape: [2, 3], dtype: 'float32' },
+      {
+        type: 'data',
+        tensorId: 't0',
+        data: new Uint8Array(4096),
+        encoding: 'binary',
+        sequence: 0,
+      },
+      { type: 'end', tensorId: 't0', metadata: { done: true } },
+      { type: 'text', data: 'hello' },
+    ];
+    const parts: Uint8Array[] = [];
+    for (const frame of frames) {
+      parts.push(...(await encoder.encode(frame)));
+    }
+    const bytes = Buffer.concat(parts);
+    // Zeros compress, so the data frame is much smaller than its payload
+    assert.ok(bytes.byteLength < 4096);
+
+    const decoder = new BinaryFrameDecoder();
+    const decoded: BinaryStreamFrame[] = [];
+    for (let offset = 0; offset < bytes.byteLength; offset += 7) {
+      decoded.push(...(await decoder.push(bytes.subarray(offset, offset + 7))));
+    }
+    assert.equal(decoder.hasPending, false);
+    assert.deepEqual(
+      decoded.map((frame) => frame.type),
+      ['header', 'data', 'end', 'text'],
+    );
+    const data = decoded[1] as { data: Uint8Array; tensorId: string };
+    assert.equal(data.tensorId, 't0');
+    assert.equal(data.data.byteLength, 4096);
+    assert.deepEqual(decoded[2], {
+      type: 'end',
+      tensorId: 't0',
+      metadata: { done: true },
+    });
+  });
+
+  it('streams tensors from their MLX buffers', async () => {
+    const values = new Float32Array([1, 2, 3, 4, 5, 6]);
+    const tensor = mlx.core.array(values, [2, 3], 'float32');
+    const stream = createBinaryStream([tensor], {
+      tensor: { chunkBytes: 8, idFactory: () => 'weights' },
+    });
+
+    const frames = await collect(decodeBinaryStream(stream));
+    assert.deepEqual(frames[0], {
+      type: 'header',
+      tensorId: 'weights',
+      shape: [2, 3],
+      dtype: 'float32',
+      metadata: undefined,
+    });
+    const chunks = frames.filter((frame) => frame.type === 'data') as {
+      data: Uint8Array;
+    }[];
+    assert.equal(chunks.length, 3);
+    const joined = Uint8Array.from(Buffer.concat(chunks.map((c) => c.data)));
+    const received = new Float32Array(joined.buffer);
+    assert.deepEqual(Array.from(received), Array.from(values));
+    assert.equal(frames[frames.length - 1].type, 'end');
+  });
+
+  it('rejects header fields which do not fit their width', async () => {
+    const encoder = new BinaryFrameEncoder();
+    const header = (shape: number[], tensorId = 't'): BinaryStreamFrame => ({
+      type: 'header',
+      tensorId,
+      shape,
+      dtype: 'float32',
+    });
+    await assert.rejects(
+      encoder.encode(header(new Array(256).fill(1))),
+      RangeError,
+    );
+    await assert.rejects(encoder.encode(header([2 ** 32])), RangeError);
+    await assert.rejects(encoder.encode(header([-1])), RangeError);
+    await assert.rejects(
+      encoder.encode(header([1], 'x'.repeat(1 << 16))),
+      RangeError,
+    );
+    await encoder.encode(header(new Array(255).fill(1)));
+  });
+
+  it('waits for sent frames to drain before sending more', async () => {
+    const sent: Uint8Array[] = [];
+    const callbacks: ((error?: Error | null) => void)[] = [];
+    const socket = {
+      readyState: 1,
+      send(data: ArrayBufferView, callback: (error?: Error | null) => void) {
+        sent.push(data as Uint8Array);
+        callbacks.push(callback);
+      },
+    };
+    // Every string is sent as a 108 byte text frame
+    const frames = Array.from({ length: 4 }, () => 'x'.repeat(100));
+    const done = sendBinaryFrames(socket, frames, { highWaterMark: 150 });
+
+    // Two frames exceed the high water mark, so the producer pauses
+    await new Promise((resolve) => setImmediate(resolve));
+    assert.equal(sent.length, 2);
+    callbacks[0]();
+    await new Promise((resolve) => setImmediate(resolve));
+    assert.equal(sent.length, 3);
+    callbacks.slice(1).forEach((callback) => callback());
+    await new Promise((resolve) => setImmediate(resolve));
+    callbacks.slice(3).forEach((callback) => callback());
+    await done;
+    assert.equal(sent.length, 4);
+
+    // A failed send stops the producer with its error
+    callbacks.length = 0;
+    const failed = sendBinaryFrames(socket, frames, { highWaterMark: 0 });
+    await new Promise((resolve) => setImmediate(resolve));
+    callbacks[0](new Error('reset'));
+    await assert.rejects(failed, /reset/);
+  });
+});
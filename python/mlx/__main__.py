@@ -16,11 +16,22 @@ def main() -> None:
         action="store_true",
         help="Print the path to the MLX CMake module directory.",
     )
+    parser.add_argument(
+        "--prewarm-cpu-kernels",
+        metavar="RECORDING",
+        help="Build the CPU kernels recorded with mx.record_cpu_kernels into "
+        "the kernel cache.",
+    )
     args = parser.parse_args()
     if args.cmake_dir:
         from pathlib import Path
 
         print(Path(__file__).parent)
+    if args.prewarm_cpu_kernels:
+        import mlx.core as mx
+
+        n = mx.prewarm_cpu_kernels(args.prewarm_cpu_kernels)
+        print(f"Prewarmed {n} CPU kernels")
 
 
 if __name__ == "__main__":
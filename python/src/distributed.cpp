@@ -206,6 +206,39 @@ void init_distributed(nb::module_& parent_module) {
           array: The concatenation of all ``x`` arrays.
       )pbdoc");
 
+  m.def(
+      "sum_scatter",
+      [](const ScalarOrArray& x,
+         std::optional<mx::distributed::Group> group,
+         mx::StreamOrDevice s) {
+        return mx::distributed::sum_scatter(to_array(x), group, s);
+      },
+      "x"_a,
+      nb::kw_only(),
+      "group"_a = nb::none(),
+      "stream"_a = nb::none(),
+      nb::sig(
+          "def sum_scatter(x: array, *, group: Optional[Group] = None, stream: Union[None, Stream, Device] = None) -> array"),
+      R"pbdoc(
+        Sum arrays across processes and scatter the result.
+
+        Sum the ``x`` arrays of all processes in the group and split the sum
+        in equal blocks along the first axis. Process ``i`` gets the ``i``-th
+        block. The first axis of ``x`` must be divisible by the size of the
+        group.
+
+        Args:
+          x (array): Input array.
+          group (Group): The group of processes that will participate in the
+            reduction. If set to ``None`` the global group is used. Default:
+            ``None``.
+          stream (Stream, optional): Stream or device. Defaults to ``None``
+            in which case the default stream of the default device is used.
+
+        Returns:
+          array: The block of the sum that belongs to this process.
+      )pbdoc");
+
   m.def(
       "send",
       [](const ScalarOrArray& x,
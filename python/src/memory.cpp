@@ -122,4 +122,48 @@ void init_memory(nb::module_& m) {
 
       After calling this, :func:`get_cache_memory` should return ``0``.
       )pbdoc");
+  m.def(
+      "set_memory_planning",
+      &mx::set_memory_planning,
+      "enable"_a,
+      R"pbdoc(
+      Enable or disable memory planning in :func:`eval`.
+
+      When enabled, evaluation orders the graph to keep the bytes of live
+      intermediate arrays low and plans offsets for them in a single arena
+      where arrays with disjoint lifetimes share memory. A planned evaluation
+      resets the peak memory to measure its own peak.
+
+      Planning is disabled by default and can also be enabled with the
+      ``MLX_EVAL_MEMORY_PLAN`` environment variable.
+
+      Args:
+        enable (bool): Whether to plan evaluations.
+
+      Returns:
+        bool: The previous setting.
+      )pbdoc");
+  m.def(
+      "get_memory_plan_report",
+      []() {
+        auto r = mx::get_memory_plan_report();
+        nb::dict d;
+        d["num_arrays"] = r.num_arrays;
+        d["predicted_peak"] = r.predicted_peak;
+        d["arena_size"] = r.arena_size;
+        d["actual_peak"] = r.actual_peak;
+        return d;
+      },
+      R"pbdoc(
+      Get the memory plan of the most recent planned evaluation.
+
+      Sizes are in bytes and do not include memory in use before the
+      evaluation.
+
+      Returns:
+        dict: With the number of planned arrays ``"num_arrays"``, the peak
+        bytes of live arrays in the planned order ``"predicted_peak"``, the
+        size of the planned arena ``"arena_size"`` and the measured peak
+        ``"actual_peak"``, which is only set by :func:`eval`.
+      )pbdoc");
 }
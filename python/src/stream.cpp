@@ -144,4 +144,29 @@ void init_stream(nb::module_& m) {
            then the default stream of the default device is used.
            Default: ``None``.
       )pbdoc");
+  m.def(
+      "set_eval_cpu_streams",
+      &mx::set_eval_cpu_streams,
+      "n"_a,
+      R"pbdoc(
+      Set the number of CPU streams evaluation spreads independent branches
+      of a graph over.
+
+      Ops on the default CPU stream are moved to the other streams and fences
+      are added where branches join. The default of ``1`` disables it. It can
+      also be set with the ``MLX_EVAL_CPU_STREAMS`` environment variable.
+
+      Args:
+        n (int): The number of CPU streams.
+
+      Returns:
+        int: The previous number of streams.
+      )pbdoc");
+  m.def(
+      "get_eval_cpu_streams",
+      &mx::get_eval_cpu_streams,
+      R"pbdoc(
+      Get the number of CPU streams evaluation spreads independent branches
+      over.
+      )pbdoc");
 }
@@ -0,0 +1,104 @@
+// Copyright © 2025 Apple Inc.
+
+#include <nanobind/nanobind.h>
+#include <nanobind/stl/string.h>
+
+#include "mlx/trace.h"
+
+namespace mx = mlx::core;
+namespace nb = nanobind;
+using namespace nb::literals;
+
+namespace {
+
+nb::list to_list(const std::vector<mx::Shape>& shapes) {
+  nb::list l;
+  for (auto& shape : shapes) {
+    nb::list dims;
+    for (auto d : shape) {
+      dims.append(d);
+    }
+    l.append(nb::tuple(dims));
+  }
+  return l;
+}
+
+} // namespace
+
+void init_trace(nb::module_& m) {
+  m.def(
+      "start_trace",
+      &mx::start_trace,
+      R"pbdoc(
+      Start recording evaluated primitives and allocations into a new trace.
+
+      Primitives on CPU streams record their name, stream, input and output
+      shapes and the bytes they touch, along with when they were enqueued by
+      :func:`eval` and when they started and ended on their stream. Tracing is
+      off by default and has next to no cost while off.
+      )pbdoc");
+  m.def(
+      "stop_trace",
+      &mx::stop_trace,
+      R"pbdoc(
+      Stop recording, keeping the recorded events.
+      )pbdoc");
+  m.def(
+      "get_trace",
+      []() {
+        nb::list events;
+        for (auto& e : mx::get_trace()) {
+          nb::dict d;
+          d["kind"] = e.kind == mx::TraceEvent::primitive
+              ? "primitive"
+              : (e.kind == mx::TraceEvent::malloc ? "malloc" : "free");
+          d["name"] = e.name;
+          d["bytes"] = e.bytes;
+          d["start"] = e.start;
+          if (e.kind == mx::TraceEvent::primitive) {
+            d["stream"] = e.stream;
+            d["input_shapes"] = to_list(e.input_shapes);
+            d["output_shapes"] = to_list(e.output_shapes);
+            d["enqueue"] = e.enqueue;
+            d["end"] = e.end;
+          } else {
+            d["active_memory"] = e.active_memory;
+          }
+          events.append(d);
+        }
+        return events;
+      },
+      R"pbdoc(
+      Get the events of the current or last trace sorted by start time.
+
+      Returns:
+        list(dict): One dict per event with its ``"kind"`` which is one of
+        ``"primitive"``, ``"malloc"`` and ``"free"``, its ``"name"``, the
+        ``"bytes"`` it touched or allocated and its ``"start"`` time in
+        microseconds since the trace started. Primitives also have their
+        ``"stream"`` index, ``"input_shapes"``, ``"output_shapes"`` and
+        ``"enqueue"`` and ``"end"`` times. Allocator events have the
+        ``"active_memory"`` after them.
+      )pbdoc");
+  m.def(
+      "get_chrome_trace",
+      &mx::get_chrome_trace,
+      R"pbdoc(
+      Get the current or last trace in the Chrome trace JSON format.
+
+      The trace can be opened with Perfetto or ``chrome://tracing``.
+
+      Returns:
+        str: The JSON trace.
+      )pbdoc");
+  m.def(
+      "save_trace",
+      &mx::save_trace,
+      "path"_a,
+      R"pbdoc(
+      Save the current or last trace in the Chrome trace JSON format.
+
+      Args:
+        path (str): The file to write the trace to.
+      )pbdoc");
+}
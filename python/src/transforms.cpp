@@ -1469,6 +1469,39 @@ void init_transforms(nb::module_& m) {
         Globally enable compilation. This will override the environment
         variable ``MLX_DISABLE_COMPILE`` if set.
       )pbdoc");
+  m.def(
+      "record_cpu_kernels",
+      &mx::record_cpu_kernels,
+      "path"_a,
+      R"pbdoc(
+        Append the source of every CPU kernel built by :func:`compile` from
+        now on to a file. Pass an empty string to stop recording. Setting the
+        environment variable ``MLX_CPU_KERNEL_RECORD`` also enables
+        recording.
+
+        Args:
+            path (str): The file to record the kernels to.
+      )pbdoc");
+  m.def(
+      "prewarm_cpu_kernels",
+      [](const std::string& path) {
+        nb::gil_scoped_release nogil;
+        return mx::prewarm_cpu_kernels(path);
+      },
+      "path"_a,
+      R"pbdoc(
+        Build the CPU kernels recorded with :func:`record_cpu_kernels` into
+        the on-disk kernel cache and load them.
+
+        The cache directory is set with ``MLX_CPU_KERNEL_CACHE_DIR`` and its
+        size limit in megabytes with ``MLX_CPU_KERNEL_CACHE_SIZE_MB``.
+
+        Args:
+            path (str): A file written by :func:`record_cpu_kernels`.
+
+        Returns:
+            int: The number of kernels which are ready to use.
+      )pbdoc");
   m.def(
       "checkpoint",
       [](nb::callable fun) { return mlx_func(PyCheckpointedFun{fun}, fun); },
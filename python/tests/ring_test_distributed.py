@@ -90,6 +90,47 @@ class TestRingDistributed(mlx_distributed_tests.MLXDistributedCommonTestCase):
             self.assertEqual(y.shape, (world.size() * 2, 2, 4))
             self.assertTrue(mx.all(y == 1))
 
+    def test_sum_scatter(self):
+        world = mx.distributed.init()
+        dtypes = [
+            (mx.int32, 0),
+            (mx.float32, 1e-6),
+            (mx.float16, 5e-3),
+            (mx.bfloat16, 1e-1),
+        ]
+        sizes = [
+            (1,),
+            (7,),
+            (1024,),
+            (1024, 1024),
+        ]
+        key = mx.random.key(0)
+        n = world.size()
+        r = world.rank()
+
+        for dt, rtol in dtypes:
+            for sh in sizes:
+                x = (
+                    mx.random.uniform(shape=(n, n * sh[0]) + sh[1:], key=key) * 10
+                ).astype(dt)
+                y = mx.distributed.sum_scatter(x[r])
+                z = x.sum(0)[r * sh[0] : (r + 1) * sh[0]]
+                self.assertEqual(y.shape, sh)
+                maxrelerror = (y - z).abs()
+                if rtol > 0:
+                    maxrelerror /= z.abs()
+                maxrelerror = maxrelerror.max()
+                self.assertLessEqual(maxrelerror, rtol)
+
+        with self.assertRaises(ValueError):
+            mx.distributed.sum_scatter(mx.ones((n + 1,)))
+
+        # The gradient of every block comes from the rank that owns it
+        x = mx.ones((n * 4,))
+        g = mx.grad(lambda x: (mx.distributed.sum_scatter(x) * (r + 1)).sum())(x)
+        expected = mx.repeat(mx.arange(1, n + 1, dtype=mx.float32), 4)
+        self.assertTrue(mx.array_equal(g, expected))
+
     def test_send_recv(self):
         world = mx.distributed.init()
         dtypes = [
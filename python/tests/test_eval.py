@@ -1,5 +1,6 @@
 # Copyright © 2023 Apple Inc.
 
+import json
 import unittest
 from functools import partial
 
@@ -196,5 +197,38 @@ class TestEval(mlx_tests.MLXTestCase):
         mx.set_memory_limit(old_limit)
 
 
+    def test_trace(self):
+        s = mx.new_stream(mx.cpu)
+        x = mx.ones((16, 32), stream=s)
+        w = mx.ones((32, 8), stream=s)
+        mx.eval(x, w)
+
+        mx.start_trace()
+        y = mx.exp(mx.matmul(x, w, stream=s), stream=s)
+        mx.eval(y)
+        mx.synchronize(s)
+        mx.stop_trace()
+
+        events = mx.get_trace()
+        prims = [
+            e
+            for e in events
+            if e["kind"] == "primitive" and e["name"] != "Synchronize"
+        ]
+        self.assertEqual([e["name"] for e in prims], ["Matmul", "Exp"])
+        self.assertEqual(prims[0]["input_shapes"], [(16, 32), (32, 8)])
+        self.assertEqual(prims[0]["output_shapes"], [(16, 8)])
+        self.assertEqual(prims[0]["stream"], s.index)
+        for e in prims:
+            self.assertLessEqual(e["enqueue"], e["start"])
+            self.assertLessEqual(e["start"], e["end"])
+        self.assertTrue(any(e["kind"] == "malloc" for e in events))
+
+        trace = json.loads(mx.get_chrome_trace())
+        names = [e["name"] for e in trace["traceEvents"]]
+        self.assertIn("Matmul", names)
+        self.assertIn("active memory", names)
+
+
 if __name__ == "__main__":
     mlx_tests.MLXTestRunner()
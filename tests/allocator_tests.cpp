@@ -1,10 +1,14 @@
 // Copyright © 2023 Apple Inc.
 
+#include <cstring>
 #include <stdexcept>
+#include <thread>
+#include <vector>
 
 #include "doctest/doctest.h"
 
 #include "mlx/allocator.h"
+#include "mlx/memory.h"
 
 using namespace mlx::core;
 
@@ -39,3 +43,113 @@ TEST_CASE("test large allocations") {
     allocator::free(buffer);
   }
 }
+
+TEST_CASE("test allocator cache") {
+  clear_cache();
+  CHECK_EQ(get_cache_memory(), 0);
+
+  auto active = get_active_memory();
+  size_t size = 1 << 20;
+  auto buffer = allocator::malloc(size);
+  CHECK(get_active_memory() >= active + size);
+  allocator::free(buffer);
+  CHECK_EQ(get_active_memory(), active);
+  CHECK(get_cache_memory() >= size);
+
+  // The cached buffer is reused
+  buffer = allocator::malloc(size);
+  CHECK_EQ(get_cache_memory(), 0);
+  allocator::free(buffer);
+
+  clear_cache();
+  CHECK_EQ(get_cache_memory(), 0);
+
+  // Small buffers are cached too
+  buffer = allocator::malloc(100);
+  allocator::free(buffer);
+  CHECK(get_cache_memory() > 0);
+  clear_cache();
+  CHECK_EQ(get_cache_memory(), 0);
+
+  // Nothing is cached when the limit is 0
+  auto old_limit = set_cache_limit(0);
+  buffer = allocator::malloc(size);
+  allocator::free(buffer);
+  buffer = allocator::malloc(100);
+  allocator::free(buffer);
+  CHECK_EQ(get_cache_memory(), 0);
+  set_cache_limit(old_limit);
+}
+
+TEST_CASE("test huge page allocations are reused") {
+  clear_cache();
+  for (size_t size :
+       {size_t(2) << 20, (size_t(2) << 20) + 1, size_t(3) << 20}) {
+    auto buffer = allocator::malloc(size);
+    auto ptr = buffer.raw_ptr();
+    allocator::free(buffer);
+    CHECK(get_cache_memory() >= size);
+
+    buffer = allocator::malloc(size);
+    CHECK_EQ(buffer.raw_ptr(), ptr);
+    CHECK_EQ(get_cache_memory(), 0);
+    allocator::free(buffer);
+    clear_cache();
+  }
+}
+
+TEST_CASE("test cache limit releases thread caches") {
+  clear_cache();
+  std::vector<allocator::Buffer> buffers;
+  for (int i = 0; i < 16; ++i) {
+    buffers.push_back(allocator::malloc(4096));
+  }
+  for (auto& buffer : buffers) {
+    allocator::free(buffer);
+  }
+  CHECK(get_cache_memory() > 0);
+
+  // The blocks kept by this thread are released too
+  auto old_limit = set_cache_limit(0);
+  CHECK_EQ(get_cache_memory(), 0);
+  set_cache_limit(old_limit);
+}
+
+TEST_CASE("test allocator peak memory") {
+  auto active = get_active_memory();
+  reset_peak_memory();
+  size_t size = 4 << 20;
+  auto buffer = allocator::malloc(size);
+  allocator::free(buffer);
+  CHECK(get_peak_memory() >= active + size);
+  CHECK_EQ(get_active_memory(), active);
+}
+
+TEST_CASE("test allocations from many threads") {
+  auto active = get_active_memory();
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 4; ++t) {
+    threads.emplace_back([t]() {
+      std::vector<allocator::Buffer> buffers;
+      for (int i = 0; i < 1000; ++i) {
+        size_t size = 1 + (i * 37 + t) % 20000;
+        auto buffer = allocator::malloc(size);
+        std::memset(buffer.raw_ptr(), t, size);
+        buffers.push_back(buffer);
+        if (i % 3 == 0) {
+          allocator::free(buffers.front());
+          buffers.erase(buffers.begin());
+        }
+      }
+      for (auto& buffer : buffers) {
+        allocator::free(buffer);
+      }
+    });
+  }
+  for (auto& t : threads) {
+    t.join();
+  }
+  CHECK_EQ(get_active_memory(), active);
+  clear_cache();
+  CHECK_EQ(get_cache_memory(), 0);
+}
@@ -108,3 +108,91 @@ TEST_CASE("test matmul") {
   out = matmul(transpose(a, {0, 2, 1}), transpose(b, {0, 2, 1}));
   CHECK(array_equal(out, full({2, 4, 4}, 2.0f)).item<bool>());
 }
+
+TEST_CASE("test batched matmul") {
+  // Compare against one BLAS call per matrix
+  auto reference = [](const array& a, const array& b) {
+    auto shape = broadcast_shapes(
+        Shape(a.shape().begin(), a.shape().end() - 2),
+        Shape(b.shape().begin(), b.shape().end() - 2));
+    auto batch = std::accumulate(
+        shape.begin(), shape.end(), 1, std::multiplies<int>());
+    auto a_shape = shape;
+    a_shape.insert(a_shape.end(), a.shape().end() - 2, a.shape().end());
+    auto b_shape = shape;
+    b_shape.insert(b_shape.end(), b.shape().end() - 2, b.shape().end());
+    auto as = reshape(broadcast_to(a, a_shape), {batch, a.shape(-2), -1});
+    auto bs = reshape(broadcast_to(b, b_shape), {batch, b.shape(-2), -1});
+    std::vector<array> outs;
+    for (int i = 0; i < batch; i++) {
+      outs.push_back(matmul(take(as, i, 0), take(bs, i, 0)));
+    }
+    shape.push_back(a.shape(-2));
+    shape.push_back(b.shape(-1));
+    return reshape(stack(outs), shape);
+  };
+
+  // Sizes which leave partial tiles in every direction
+  auto a = random::normal({2, 3, 33, 17});
+  auto b = random::normal({2, 3, 17, 29});
+  CHECK(allclose(matmul(a, b), reference(a, b), 1e-5, 1e-5).item<bool>());
+
+  auto at = swapaxes(random::normal({2, 3, 17, 33}), -1, -2);
+  auto bt = swapaxes(random::normal({2, 3, 29, 17}), -1, -2);
+  CHECK(allclose(matmul(at, bt), reference(at, bt), 1e-5, 1e-5).item<bool>());
+
+  // B is broadcast across the batch
+  auto b_shared = random::normal({1, 3, 17, 29});
+  CHECK(allclose(matmul(a, b_shared), reference(a, b_shared), 1e-5, 1e-5)
+            .item<bool>());
+  b_shared = swapaxes(random::normal({1, 1, 29, 17}), -1, -2);
+  CHECK(allclose(matmul(a, b_shared), reference(a, b_shared), 1e-5, 1e-5)
+            .item<bool>());
+
+  auto a64 = astype(a, float64, Device::cpu);
+  auto b64 = astype(b, float64, Device::cpu);
+  CHECK(allclose(matmul(a64, b64, Device::cpu), reference(a, b), 1e-5, 1e-5)
+            .item<bool>());
+
+  // Scaled and accumulated into C
+  auto c = random::normal({2, 3, 33, 29});
+  auto out = addmm(c, a, b, 0.5f, 2.0f);
+  auto expected = 0.5f * reference(a, b) + 2.0f * c;
+  CHECK(allclose(out, expected, 1e-5, 1e-5).item<bool>());
+}
+
+TEST_CASE("test half precision matmul") {
+  // Shapes with a few rows, partial tiles and several blocks of each size
+  std::vector<std::tuple<int, int, int, int>> shapes = {
+      {1, 1, 300, 257},
+      {1, 5, 64, 33},
+      {3, 7, 129, 40},
+      {2, 33, 17, 29},
+      {1, 200, 600, 513},
+  };
+  for (auto dtype : {float16, bfloat16}) {
+    double tol = dtype == bfloat16 ? 1e-2 : 2e-3;
+    for (auto [batch, M, K, N] : shapes) {
+      auto a = astype(random::normal({batch, M, K}), dtype);
+      auto b = astype(random::normal({batch, K, N}), dtype);
+      auto at = swapaxes(astype(random::normal({batch, K, M}), dtype), 1, 2);
+      auto bt = swapaxes(astype(random::normal({batch, N, K}), dtype), 1, 2);
+      for (auto& [x, y] : std::vector<std::pair<array, array>>{
+               {a, b}, {a, bt}, {at, b}, {at, bt}}) {
+        auto out = matmul(x, y);
+        CHECK_EQ(out.dtype(), dtype);
+        auto expected = matmul(astype(x, float32), astype(y, float32));
+        auto scale = std::sqrt(K);
+        CHECK(allclose(astype(out, float32), expected, tol, tol * scale)
+                  .item<bool>());
+      }
+    }
+
+    // B broadcast across the batch
+    auto a = astype(random::normal({4, 50, 70}), dtype);
+    auto b = astype(random::normal({1, 70, 90}), dtype);
+    auto expected = matmul(astype(a, float32), astype(b, float32));
+    CHECK(allclose(astype(matmul(a, b), float32), expected, tol, tol * 9)
+              .item<bool>());
+  }
+}
@@ -3,6 +3,10 @@
 // Required for using M_SQRT2 in MSVC.
 #define _USE_MATH_DEFINES
 
+#include <chrono>
+#include <filesystem>
+#include <thread>
+
 #include "doctest/doctest.h"
 
 #include "mlx/mlx.h"
@@ -720,6 +724,77 @@ TEST_CASE("test shapeless compile") {
   }
 }
 
+auto compile_async_fun(const std::vector<array>& inputs) {
+  auto x = exp(inputs[0]) * inputs[1] + 3.5f;
+  return std::vector<array>{x, abs(x - 1.25f)};
+}
+
+TEST_CASE("test async cpu compile") {
+  auto fun = [](const std::vector<array>& inputs) {
+    return compile_async_fun(inputs);
+  };
+  auto cfun = compile(compile_async_fun);
+  auto x = reshape(arange(24, float32), {2, 3, 4}) / 8.0f;
+  auto y = array({-1.0f, 0.5f, 2.0f, 4.0f});
+  auto expected = fun({x, y});
+
+  // Before the kernel is built the tape runs uncompiled
+  auto out = cfun({x, y});
+  CHECK(allclose(out[0], expected[0]).item<bool>());
+  CHECK(allclose(out[1], expected[1]).item<bool>());
+
+  // Once it is built the kernel is used
+  for (int i = 0; i < 600 && cpu_compile_stats().pending > 0; ++i) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  }
+  auto stats = cpu_compile_stats();
+  CHECK_EQ(stats.pending, 0);
+  CHECK_EQ(stats.failed, 0);
+  out = cfun({x, y});
+  eval(out);
+  CHECK(cpu_compile_stats().hits > stats.hits);
+  CHECK(allclose(out[0], expected[0]).item<bool>());
+  CHECK(allclose(out[1], expected[1]).item<bool>());
+
+  // Strided inputs and synchronous builds
+  set_cpu_async_compile(false);
+  auto xt = transpose(x, {2, 1, 0});
+  auto yt = reshape(y, {4, 1, 1});
+  out = cfun({xt, yt});
+  expected = fun({xt, yt});
+  CHECK(allclose(out[0], expected[0]).item<bool>());
+  CHECK(allclose(out[1], expected[1]).item<bool>());
+  CHECK_EQ(cpu_compile_stats().pending, 0);
+  set_cpu_async_compile(true);
+}
+
+auto compile_recorded_fun(const std::vector<array>& inputs) {
+  return std::vector<array>{sin(inputs[0]) * cos(inputs[1]) - 0.75f};
+}
+
+TEST_CASE("test record and prewarm cpu kernels") {
+  auto path = std::filesystem::temp_directory_path() / "mlx_kernels.txt";
+  std::filesystem::remove(path);
+
+  record_cpu_kernels(path.string());
+  auto cfun = compile(compile_recorded_fun);
+  auto x = array({0.5f, 1.0f, 1.5f});
+  auto out = cfun({x, x})[0];
+  eval(out);
+  record_cpu_kernels("");
+  CHECK(allclose(out, compile_recorded_fun({x, x})[0]).item<bool>());
+  CHECK(std::filesystem::file_size(path) > 0);
+
+  // The recorded kernels are already loaded or being built
+  CHECK_EQ(prewarm_cpu_kernels(path.string()), 1);
+  auto stats = cpu_compile_stats();
+  CHECK_EQ(stats.pending, 0);
+  out = cfun({x, x})[0];
+  eval(out);
+  CHECK(cpu_compile_stats().hits > stats.hits);
+  std::filesystem::remove(path);
+}
+
 auto compile_broadcast_add(const std::vector<array>& inputs) {
   auto b = zeros({8, 8});
   return std::vector<array>{inputs[0] + b};
@@ -804,3 +879,60 @@ TEST_CASE("test compile with no-ops") {
   auto out = compile(fun)({in})[0];
   CHECK_EQ(out.inputs()[0].id(), in.id());
 }
+
+TEST_CASE("test capture") {
+  auto fun = [](const std::vector<array>& inputs) {
+    auto& x = inputs[0];
+    auto& y = inputs[1];
+    auto z = exp(x) * y + 2.0f;
+    return std::vector<array>{z - 1, sum(z, 0), x};
+  };
+  auto cfun = capture(fun);
+
+  for (int i = 0; i < 3; i++) {
+    auto x = random::normal({4, 3});
+    auto y = random::normal({4, 3});
+    auto out = cfun({x, y});
+    auto expected = fun({x, y});
+    CHECK_EQ(out.size(), 3);
+    CHECK(allclose(out[0], expected[0]).item<bool>());
+    CHECK(allclose(out[1], expected[1]).item<bool>());
+    CHECK_EQ(out[2].id(), x.id());
+  }
+
+  // Lazy inputs and a new shape
+  auto x = exp(random::normal({2, 5}));
+  auto y = ones({2, 5});
+  auto out = cfun({x, y});
+  CHECK_EQ(out[0].shape(), Shape{2, 5});
+  CHECK(allclose(out[0], fun({x, y})[0]).item<bool>());
+
+  // Multi-output primitives and reuse of outputs across replays
+  auto split_fun = [](const std::vector<array>& inputs) {
+    auto parts = split(inputs[0], 2, 1);
+    return std::vector<array>{parts[1] * parts[0], cumsum(parts[0], 1)};
+  };
+  auto csplit = capture(split_fun);
+  auto a = reshape(arange(12.0f), {3, 4});
+  auto first = csplit({a});
+  auto second = csplit({first[1]});
+  auto expected = split_fun({split_fun({a})[1]});
+  CHECK(array_equal(second[0], expected[0]).item<bool>());
+  CHECK(array_equal(second[1], expected[1]).item<bool>());
+
+  // Branches on another stream join with fences
+  auto s2 = new_stream(Device::cpu);
+  auto stream_fun = [s2](const std::vector<array>& inputs) {
+    auto a = exp(inputs[0], s2);
+    auto b = log1p(abs(inputs[0]));
+    return std::vector<array>{a * b, a};
+  };
+  auto cstream = capture(stream_fun);
+  for (int i = 0; i < 2; i++) {
+    auto x = random::normal({64});
+    auto out = cstream({x});
+    auto expected = stream_fun({x});
+    CHECK(allclose(out[0], expected[0]).item<bool>());
+    CHECK(allclose(out[1], expected[1]).item<bool>());
+  }
+}
@@ -91,3 +91,118 @@ TEST_CASE("test eval graph retention when not tracing") {
   CHECK(!a.has_primitive());
   CHECK(a.is_available());
 }
+
+TEST_CASE("test eval memory planning") {
+  auto x = random::uniform({1 << 16});
+  eval(x);
+
+  auto fn = [&x]() {
+    auto out = array(0.0f);
+    for (int i = 0; i < 32; i++) {
+      out = out + sum(cos(sin(x + i)));
+    }
+    return out;
+  };
+
+  auto expected = fn();
+  eval(expected);
+
+  bool enabled = set_memory_planning(true);
+  auto out = fn();
+  eval(out);
+  auto report = get_memory_plan_report();
+  set_memory_planning(enabled);
+  CHECK(allclose(out, expected).item<bool>());
+
+  CHECK(report.num_arrays >= 32 * 5);
+  // One branch at a time keeps at most two temporaries of x alive
+  CHECK(report.predicted_peak < 3 * x.nbytes());
+  CHECK(report.arena_size >= report.predicted_peak);
+  CHECK(report.actual_peak > 0);
+}
+
+TEST_CASE("test eval cpu streams") {
+  auto x = random::normal({64, 256});
+  std::vector<array> ws;
+  for (int i = 0; i < 6; i++) {
+    ws.push_back(random::normal({256, 256}));
+  }
+  eval(ws);
+
+  // Independent heads that join at the end
+  auto fn = [&]() {
+    std::vector<array> heads;
+    for (auto& w : ws) {
+      heads.push_back(softmax(matmul(x, w), -1));
+    }
+    return sum(stack(heads), 0);
+  };
+
+  auto expected = fn();
+  eval(expected);
+
+  int n_streams = set_eval_cpu_streams(4);
+  CHECK_EQ(get_eval_cpu_streams(), 4);
+  for (bool plan : {false, true}) {
+    bool enabled = set_memory_planning(plan);
+    auto out = fn();
+    auto partial = matmul(x, ws[0]);
+    eval(out, partial);
+    set_memory_planning(enabled);
+    CHECK(allclose(out, expected).item<bool>());
+    CHECK(allclose(partial, matmul(x, ws[0])).item<bool>());
+  }
+
+  // Async evals on the pool are waited on across evals
+  auto out = fn();
+  async_eval(out);
+  CHECK(allclose(out * 2, expected + expected).item<bool>());
+  set_eval_cpu_streams(n_streams);
+}
+
+TEST_CASE("test eval trace") {
+  auto s = new_stream(Device::cpu);
+  auto x = ones({16, 32}, float32, s);
+  auto w = ones({32, 8}, float32, s);
+  eval(x, w);
+
+  start_trace();
+  auto y = exp(matmul(x, w, s), s);
+  eval(y);
+  synchronize(s);
+  stop_trace();
+
+  // Nothing is recorded once stopped
+  eval(exp(y, s));
+  synchronize(s);
+
+  auto events = get_trace();
+  std::vector<TraceEvent> primitives;
+  size_t allocated = 0;
+  for (auto& e : events) {
+    // Skip the primitive eval uses to synchronize with its outputs
+    if (e.kind == TraceEvent::primitive && e.name != "Synchronize") {
+      primitives.push_back(e);
+    } else if (e.kind == TraceEvent::malloc) {
+      allocated += e.bytes;
+    }
+  }
+  CHECK_EQ(primitives.size(), 2);
+  CHECK_EQ(primitives[0].name, "Matmul");
+  CHECK_EQ(primitives[1].name, "Exp");
+  CHECK_EQ(primitives[0].stream, s.index);
+  CHECK_EQ(primitives[0].input_shapes, std::vector<Shape>{{16, 32}, {32, 8}});
+  CHECK_EQ(primitives[0].output_shapes, std::vector<Shape>{{16, 8}});
+  CHECK_EQ(primitives[0].bytes, (16 * 32 + 32 * 8 + 16 * 8) * 4);
+  for (auto& p : primitives) {
+    CHECK(p.enqueue <= p.start);
+    CHECK(p.start <= p.end);
+  }
+  CHECK(primitives[0].end <= primitives[1].start);
+  CHECK(allocated >= 16 * 8 * 4);
+
+  auto json = get_chrome_trace();
+  CHECK_EQ(json.rfind("{\"traceEvents\":[", 0), 0);
+  CHECK(json.find("\"name\":\"Matmul\"") != std::string::npos);
+  CHECK(json.find("\"name\":\"active memory\"") != std::string::npos);
+}
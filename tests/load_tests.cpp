@@ -40,6 +40,36 @@ TEST_CASE("test save_safetensors") {
   CHECK(array_equal(test2, ones({2, 2})).item<bool>());
 }
 
+TEST_CASE("test load_safetensors mmap") {
+  std::string file_path = get_temp_file("test_arr_mmap.safetensors");
+  auto x = reshape(arange(12, float32), {3, 4});
+  auto y = array({1, 2, 3}, int16);
+  save_safetensors(file_path, {{"x", x}, {"y", y}});
+
+  io::MmapOptions options;
+  options.advice = io::MmapOptions::Advice::willneed;
+  {
+    auto [dict, metadata] = load_safetensors(file_path, {}, options);
+    CHECK_EQ(dict.size(), 2);
+    array loaded_x = dict.at("x");
+    array loaded_y = dict.at("y");
+    CHECK(array_equal(loaded_x, x).item<bool>());
+    CHECK(array_equal(loaded_y, y).item<bool>());
+
+    // The arrays alias the mapping of the whole file
+    CHECK(loaded_x.buffer_size() > loaded_x.nbytes());
+
+    // Donating a mapped array must not write through to the file
+    dict.clear();
+    loaded_x = loaded_x + 1;
+    CHECK(array_equal(loaded_x, x + 1).item<bool>());
+  }
+
+  auto [dict, metadata] = load_safetensors(file_path);
+  CHECK(array_equal(dict.at("x"), x).item<bool>());
+  CHECK(array_equal(dict.at("y"), y).item<bool>());
+}
+
 TEST_CASE("test gguf") {
   std::string file_path = get_temp_file("test_arr.gguf");
   using dict = std::unordered_map<std::string, array>;
@@ -60,6 +90,16 @@ TEST_CASE("test gguf") {
     }
   }
 
+  {
+    // Check loading through a memory mapping
+    auto [loaded_weights, loaded_metadata] =
+        load_gguf(file_path, {}, io::MmapOptions{});
+    CHECK_EQ(loaded_weights.size(), 2);
+    for (auto [k, v] : loaded_weights) {
+      CHECK(array_equal(v, original_weights.at(k)).item<bool>());
+    }
+  }
+
   // Test saving and loading string metadata
   std::unordered_map<std::string, GGUFMetaData> original_metadata;
   original_metadata.insert({"test_str", "my string"});
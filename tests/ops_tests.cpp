@@ -3010,6 +3010,43 @@ TEST_CASE("test quantize dequantize") {
   }
 }
 
+TEST_CASE("test quantized matmul small groups") {
+  // GGUF K-quants load with groups of 16 and 32 and any of these bits
+  int N = 37;
+  int K = 256;
+  for (int bits : {2, 3, 4, 5, 6, 8}) {
+    for (int group_size : {16, 32}) {
+      auto w = random::bits({N, K * bits / 32}, 4);
+      auto scales = random::normal({N, K / group_size}) * 0.1;
+      auto biases = random::normal({N, K / group_size}) * 0.1;
+      auto w_hat = dequantize(w, scales, biases, group_size, bits);
+      for (int M : {1, 5}) {
+        auto x = random::normal({M, K});
+        auto expected = matmul(x, transpose(w_hat));
+        auto out =
+            quantized_matmul(x, w, scales, biases, true, group_size, bits);
+        CHECK(allclose(out, expected, 1e-4, 1e-4).item<bool>());
+
+        // Compare half precision against the same rounded inputs
+        auto x16 = astype(x, float16);
+        auto scales16 = astype(scales, float16);
+        auto biases16 = astype(biases, float16);
+        auto w_hat16 = dequantize(
+            w,
+            astype(scales16, float32),
+            astype(biases16, float32),
+            group_size,
+            bits);
+        expected = matmul(astype(x16, float32), transpose(w_hat16));
+        out = quantized_matmul(
+            x16, w, scales16, biases16, true, group_size, bits);
+        auto err = max(abs(astype(out, float32) - expected)).item<float>();
+        CHECK(err <= 2e-3 * max(abs(expected)).item<float>());
+      }
+    }
+  }
+}
+
 TEST_CASE("test repeat") {
   auto data = array({13, 3, 16, 6, 14, 4, 15, 5, 11, 1, 12, 2}, {3, 2, 2});
   auto repeat_axis_0 = repeat(data, 2, 0);
@@ -4032,3 +4069,226 @@ TEST_CASE("test conv_transpose3d with output_padding") {
       {1, 2, 4, 4, 1});
   CHECK(array_equal(out, expected).item<bool>());
 }
+
+TEST_CASE("test fast rms_norm and layer_norm") {
+  auto x = random::normal({2, 7, 33});
+  auto w = random::uniform({33});
+  auto b = random::uniform({33});
+  float eps = 1e-5;
+
+  auto rms_ref = [eps](const array& x, const array& w) {
+    auto n = rsqrt(add(mean(square(x), -1, true), array(eps)));
+    return multiply(multiply(x, n), w);
+  };
+  auto ln_ref = [eps](const array& x, const array& w, const array& b) {
+    auto xc = subtract(x, mean(x, -1, true));
+    auto n = rsqrt(add(mean(square(xc), -1, true), array(eps)));
+    return add(multiply(multiply(xc, n), w), b);
+  };
+
+  CHECK(allclose(fast::rms_norm(x, w, eps), rms_ref(x, w), 1e-5, 1e-5)
+            .item<bool>());
+  CHECK(allclose(fast::layer_norm(x, w, b, eps), ln_ref(x, w, b), 1e-5, 1e-5)
+            .item<bool>());
+
+  // Non-contiguous input
+  auto xt = transpose(random::normal({33, 7}));
+  CHECK(allclose(
+            fast::rms_norm(xt, std::nullopt, eps),
+            rms_ref(xt, array(1.0f)),
+            1e-5,
+            1e-5)
+            .item<bool>());
+
+  // Gradients with respect to the input and the parameters
+  auto cotan = random::normal(x.shape());
+  auto [out, vjps] = vjp(
+      [eps](const std::vector<array>& in) {
+        return std::vector<array>{fast::rms_norm(in[0], in[1], eps)};
+      },
+      {x, w},
+      {cotan});
+  auto [ref_out, ref_vjps] = vjp(
+      [&rms_ref](const std::vector<array>& in) {
+        return std::vector<array>{rms_ref(in[0], in[1])};
+      },
+      {x, w},
+      {cotan});
+  CHECK(allclose(vjps[0], ref_vjps[0], 1e-4, 1e-4).item<bool>());
+  CHECK(allclose(vjps[1], ref_vjps[1], 1e-4, 1e-4).item<bool>());
+
+  std::tie(out, vjps) = vjp(
+      [eps](const std::vector<array>& in) {
+        return std::vector<array>{fast::layer_norm(in[0], in[1], in[2], eps)};
+      },
+      {x, w, b},
+      {cotan});
+  std::tie(ref_out, ref_vjps) = vjp(
+      [&ln_ref](const std::vector<array>& in) {
+        return std::vector<array>{ln_ref(in[0], in[1], in[2])};
+      },
+      {x, w, b},
+      {cotan});
+  CHECK(allclose(vjps[0], ref_vjps[0], 1e-4, 1e-4).item<bool>());
+  CHECK(allclose(vjps[1], ref_vjps[1], 1e-4, 1e-4).item<bool>());
+  CHECK(allclose(vjps[2], ref_vjps[2], 1e-4, 1e-4).item<bool>());
+}
+
+TEST_CASE("test fast rope") {
+  auto rope_ref = [](const array& x, int dims, bool traditional, int offset) {
+    int L = x.shape(-2);
+    int half = dims / 2;
+    auto positions = astype(arange(offset, offset + L), float32);
+    auto inv_freqs = exp(multiply(
+        astype(arange(0, -half, -1), float32),
+        array(std::log(10000.0f) / half)));
+    auto theta = multiply(expand_dims(positions, 1), expand_dims(inv_freqs, 0));
+    auto c = cos(theta);
+    auto s = sin(theta);
+    auto end = x.shape();
+    array x1(0.0f), x2(0.0f);
+    if (traditional) {
+      end.back() = dims;
+      x1 = slice(x, {0, 0, 0}, end, {1, 1, 2});
+      x2 = slice(x, {0, 0, 1}, end, {1, 1, 2});
+    } else {
+      end.back() = half;
+      x1 = slice(x, {0, 0, 0}, end);
+      end.back() = dims;
+      x2 = slice(x, {0, 0, half}, end);
+    }
+    auto y1 = subtract(multiply(x1, c), multiply(x2, s));
+    auto y2 = add(multiply(x1, s), multiply(x2, c));
+    array y(0.0f);
+    if (traditional) {
+      y = concatenate({expand_dims(y1, 3), expand_dims(y2, 3)}, 3);
+      y = reshape(y, {x.shape(0), L, dims});
+    } else {
+      y = concatenate({y1, y2}, 2);
+    }
+    if (dims < x.shape(-1)) {
+      y = concatenate({y, slice(x, {0, 0, dims}, x.shape())}, 2);
+    }
+    return y;
+  };
+
+  auto x = random::normal({3, 9, 20});
+  for (bool traditional : {false, true}) {
+    for (int dims : {20, 12}) {
+      auto out = fast::rope(x, dims, traditional, 10000.0f, 1.0f, 5);
+      auto expected = rope_ref(x, dims, traditional, 5);
+      CHECK(allclose(out, expected, 1e-5, 1e-5).item<bool>());
+
+      // The inverse rotation undoes the forward one
+      auto cotan = random::normal(x.shape());
+      auto vjps = vjp(
+                      [dims, traditional](const array& in) {
+                        return fast::rope(
+                            in, dims, traditional, 10000.0f, 1.0f, 5);
+                      },
+                      x,
+                      cotan)
+                      .second;
+      auto ref_vjps = vjp(
+                          [&rope_ref, dims, traditional](const array& in) {
+                            return rope_ref(in, dims, traditional, 5);
+                          },
+                          x,
+                          cotan)
+                          .second;
+      CHECK(allclose(vjps, ref_vjps, 1e-5, 1e-5).item<bool>());
+    }
+  }
+
+  // Non-contiguous input
+  auto xt = swapaxes(random::normal({3, 20, 9}), 1, 2);
+  CHECK(allclose(
+            fast::rope(xt, 20, false, 10000.0f, 1.0f, 0),
+            rope_ref(xt, 20, false, 0),
+            1e-5,
+            1e-5)
+            .item<bool>());
+}
+
+TEST_CASE("test fast scaled_dot_product_attention") {
+  auto sdpa_ref = [](array q,
+                     array k,
+                     array v,
+                     float scale,
+                     bool causal,
+                     std::optional<array> mask) {
+    int factor = q.shape(1) / k.shape(1);
+    if (factor > 1) {
+      k = repeat(k, factor, 1);
+      v = repeat(v, factor, 1);
+    }
+    auto scores = matmul(multiply(q, array(scale)), swapaxes(k, -1, -2));
+    int qL = q.shape(2);
+    int kL = k.shape(2);
+    if (causal) {
+      int offset = std::max(0, kL - qL);
+      mask = greater_equal(
+          expand_dims(arange(offset, offset + qL), 1),
+          expand_dims(arange(kL), 0));
+    }
+    if (mask) {
+      if (mask->dtype() == bool_) {
+        scores = where(*mask, scores, array(-INFINITY));
+      } else {
+        scores = add(scores, *mask);
+      }
+    }
+    return matmul(softmax(scores, -1, true), v);
+  };
+
+  auto check = [&sdpa_ref](
+                   int B,
+                   int n_q_heads,
+                   int n_kv_heads,
+                   int qL,
+                   int kL,
+                   int D,
+                   const std::string& mask_mode,
+                   std::optional<array> mask) {
+    auto q = random::normal({B, n_q_heads, qL, D});
+    auto k = random::normal({B, n_kv_heads, kL, D});
+    auto v = random::normal({B, n_kv_heads, kL, D});
+    float scale = 1.0 / std::sqrt(D);
+    std::vector<array> masks;
+    if (mask) {
+      masks.push_back(*mask);
+    }
+    auto out =
+        fast::scaled_dot_product_attention(q, k, v, scale, mask_mode, masks);
+    auto expected = sdpa_ref(q, k, v, scale, mask_mode == "causal", mask);
+    CHECK(allclose(out, expected, 1e-4, 1e-4).item<bool>());
+  };
+
+  // Prefill with and without masks
+  check(2, 4, 4, 37, 37, 32, "", std::nullopt);
+  check(1, 4, 4, 40, 70, 32, "causal", std::nullopt);
+  check(1, 2, 2, 20, 33, 16, "array", random::normal({20, 33}));
+  auto bool_mask = random::bernoulli(array(0.5), {1, 2, 20, 33});
+  check(1, 2, 2, 20, 33, 16, "array", bool_mask);
+
+  // Grouped query attention
+  check(2, 8, 2, 24, 24, 32, "causal", std::nullopt);
+
+  // Decode with the keys split across parts
+  check(1, 8, 2, 1, 1000, 64, "", std::nullopt);
+  check(1, 4, 4, 4, 700, 32, "causal", std::nullopt);
+  check(2, 4, 2, 1, 600, 32, "array", random::normal({2, 1, 1, 600}));
+
+  // The leading tiles of keys are fully masked
+  auto leading = greater_equal(arange(150), array(100));
+  check(1, 2, 2, 20, 150, 16, "array", broadcast_to(leading, {20, 150}));
+  check(1, 2, 2, 1, 150, 16, "array", reshape(leading, {1, 150}));
+
+  // Keys and values with the heads and sequence swapped
+  auto q = random::normal({1, 4, 10, 16});
+  auto k = swapaxes(random::normal({1, 30, 4, 16}), 1, 2);
+  auto v = swapaxes(random::normal({1, 30, 4, 16}), 1, 2);
+  auto out = fast::scaled_dot_product_attention(q, k, v, 0.25);
+  CHECK(allclose(out, sdpa_ref(q, k, v, 0.25, false, std::nullopt), 1e-4, 1e-4)
+            .item<bool>());
+}
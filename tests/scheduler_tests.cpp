@@ -2,6 +2,7 @@
 
 #include "doctest/doctest.h"
 
+#include "mlx/backend/cpu/parallel.h"
 #include "mlx/mlx.h"
 #include "mlx/scheduler.h"
 
@@ -119,3 +120,79 @@ TEST_CASE("test scheduler races") {
   }
   eval(a, y);
 }
+
+TEST_CASE("test cpu parallel for") {
+  int prev_threads = cpu::set_num_threads(4);
+
+  // Every index is visited exactly once
+  std::vector<std::atomic<int>> visits(10000);
+  cpu::parallel_for(visits.size(), 7, [&](int64_t begin, int64_t end) {
+    CHECK(end - begin <= 7);
+    for (int64_t i = begin; i < end; i++) {
+      visits[i]++;
+    }
+  });
+  bool all_once = true;
+  for (auto& v : visits) {
+    all_once &= (v == 1);
+  }
+  CHECK(all_once);
+
+  // Nested calls complete
+  std::atomic<int64_t> total{0};
+  cpu::parallel_for(16, 1, [&](int64_t begin, int64_t end) {
+    for (int64_t i = begin; i < end; i++) {
+      cpu::parallel_for(100, 10, [&](int64_t b, int64_t e) { total += e - b; });
+    }
+  });
+  CHECK_EQ(total, 1600);
+
+  // Exceptions are propagated to the caller
+  CHECK_THROWS_AS(
+      cpu::parallel_for(
+          100,
+          1,
+          [](int64_t begin, int64_t end) {
+            if (begin == 50) {
+              throw std::runtime_error("error");
+            }
+          }),
+      std::runtime_error);
+
+  CHECK_THROWS(cpu::set_num_threads(0));
+  cpu::set_num_threads(prev_threads);
+}
+
+TEST_CASE("test cpu ops match across thread counts") {
+  auto s = default_stream(Device::cpu);
+  int prev_threads = cpu::set_num_threads(1);
+  int64_t prev_grain = cpu::set_grain_size(64);
+
+  auto x = random::normal({37, 29, 41});
+  auto y = random::normal({29, 41});
+  auto fn = [&]() {
+    return std::vector<array>{
+        exp(x, s),
+        add(x, y, s),
+        multiply(transpose(x, {2, 0, 1}, s), array(2.0f), s),
+        contiguous(transpose(x, {1, 2, 0}, s), false, s),
+        sum(x, s),
+        sum(x, 1, false, s),
+        max(x, {0, 2}, false, s),
+        softmax(x, -1, false, s),
+        sort(x, 1, s),
+        argsort(x, 0, s)};
+  };
+  auto expected = fn();
+  eval(expected);
+
+  cpu::set_num_threads(4);
+  auto out = fn();
+  eval(out);
+  for (int i = 0; i < out.size(); i++) {
+    CHECK(array_equal(out[i], expected[i], s).item<bool>());
+  }
+
+  cpu::set_grain_size(prev_grain);
+  cpu::set_num_threads(prev_threads);
+}
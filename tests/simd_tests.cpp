@@ -0,0 +1,105 @@
+// Copyright © 2025 Apple Inc.
+
+#include <cmath>
+
+#include "doctest/doctest.h"
+
+#include "mlx/backend/cpu/simd/dispatch.h"
+#include "mlx/mlx.h"
+
+using namespace mlx::core;
+
+namespace {
+
+// Restores the dispatched vector width when a test case exits
+struct SimdWidthGuard {
+  int width = simd::max_width();
+  ~SimdWidthGuard() {
+    simd::set_max_width(width);
+  }
+};
+
+} // namespace
+
+TEST_CASE("test cpu kernels across simd widths") {
+  SimdWidthGuard guard;
+
+  // Odd sizes leave scalar tails after every vector width
+  auto x = random::uniform(-4.0, 4.0, {1031});
+  auto y = random::uniform(0.5, 4.0, {1031});
+  // Small integers so sums are exact in every precision and order
+  auto z = floor(slice(y, {0}, {37}));
+  auto special = array(
+      {0.5f, -0.5f, 1.5f, -1.5f, 2.5f, -2.5f, -0.0f, 1e30f, -1e30f, NAN});
+  auto m = random::normal({5, 128});
+  auto w = random::normal({33, 128});
+
+  auto run = [&](Dtype dtype) {
+    auto a = astype(x, dtype);
+    auto b = astype(y, dtype);
+    auto c = astype(z, dtype);
+    auto s = astype(special, dtype);
+    std::vector<array> outs = {
+        exp(a),
+        sin(a),
+        erf(a),
+        log(b),
+        sqrt(b),
+        a + b,
+        a * 3.0f,
+        maximum(a, astype(array(NAN), dtype)),
+        floor(s),
+        ceil(s),
+        round(s),
+        sum(c),
+        max(a),
+        sum(reshape(c, {1, 37}), 0),
+        astype(a, float32),
+        softmax(reshape(a, {1, 1031}), -1)};
+    if (dtype != float64) {
+      outs.push_back(matmul(astype(m, dtype), transpose(astype(w, dtype))));
+    }
+    // The scalar half precision kernels accumulate in half precision
+    if (dtype == float32) {
+      for (int bits : {4, 8}) {
+        auto q = quantize(w, 64, bits);
+        outs.push_back(quantized_matmul(m, q[0], q[1], q[2], true, 64, bits));
+      }
+    }
+    eval(outs);
+    return outs;
+  };
+
+  for (auto dtype : {float32, float16, bfloat16, float64}) {
+    simd::set_max_width(16);
+    auto expected = run(dtype);
+
+    // The vector kernels agree with the scalar definitions
+    auto floors = array(
+        {0.0f, -1.0f, 1.0f, -2.0f, 2.0f, -3.0f, -0.0f, 1e30f, -1e30f, NAN});
+    auto rounds = array(
+        {0.0f, -0.0f, 2.0f, -2.0f, 2.0f, -2.0f, -0.0f, 1e30f, -1e30f, NAN});
+    CHECK(array_equal(expected[8], astype(floors, dtype), true).item<bool>());
+    CHECK(array_equal(expected[10], astype(rounds, dtype), true).item<bool>());
+    CHECK(all(isnan(expected[7])).item<bool>());
+    auto ceil_neg_half = astype(take(expected[9], 1), float32).item<float>();
+    CHECK(std::signbit(ceil_neg_half));
+
+    for (int width : {32, 64}) {
+      if (width > simd::supported_width()) {
+        continue;
+      }
+      simd::set_max_width(width);
+      auto out = run(dtype);
+      // Wider kernels may contract into fused multiply adds and sum in a
+      // different order, which moves results by about an ulp
+      double rtol = dtype == bfloat16 ? 1e-2 : dtype == float16 ? 2e-3 : 1e-5;
+      double atol = dtype == float32 || dtype == float64 ? 1e-4 : 1e-3;
+      for (int i = 0; i < out.size(); i++) {
+        CHECK(allclose(out[i], expected[i], rtol, atol, true).item<bool>());
+      }
+      CHECK(array_equal(out[11], expected[11]).item<bool>());
+      CHECK(array_equal(out[13], expected[13]).item<bool>());
+    }
+  }
+}